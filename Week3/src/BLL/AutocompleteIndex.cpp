@@ -0,0 +1,186 @@
+#include "AutocompleteIndex.h"
+#include "../LIB/HashUtils.h"
+#include "../LIB/StringUtils.h"
+#include <algorithm>
+#include <stdexcept>
+
+// ITaskObserver
+void AutocompleteIndex::OnTaskAdded(const TaskPtr& task) {
+    std::vector<std::pair<uint64_t, const std::string*>> tags;
+    for (const auto& tag : task->GetTags()) {
+        if (!tag.empty()) {
+            tags.emplace_back(Hash(tag), &tag);
+        }
+    }
+    std::sort(tags.begin(), tags.end());
+    tags.erase(std::unique(tags.begin(), tags.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first == rhs.first;
+    }), tags.end());
+    
+    Entry entry;
+    entry.title = task->GetTitle().empty() ? 0 : Hash(task->GetTitle());
+    for (const auto& [hash, tag] : tags) {
+        entry.tags.push_back(hash);
+    }
+    entry.categoryId = task->GetCategoryId();
+    
+    auto it = entries_.find(task->GetId());
+    if (it != entries_.end()) {
+        if (it->second == entry) {
+            return;
+        }
+        Remove(it->second);
+        entries_.erase(it);
+    }
+    
+    if (entry.title != 0) {
+        AddValue(CompletionSource::TITLE, task->GetTitle());
+    }
+    for (const auto& [hash, tag] : tags) {
+        AddValue(CompletionSource::TAG, *tag);
+    }
+    if (entry.categoryId != 0) {
+        CountCategoryTask(entry.categoryId, 1);
+    }
+    entries_.emplace(task->GetId(), std::move(entry));
+}
+
+void AutocompleteIndex::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void AutocompleteIndex::OnTaskRemoved(const TaskPtr& task) {
+    auto it = entries_.find(task->GetId());
+    if (it == entries_.end()) {
+        return;
+    }
+    Remove(it->second);
+    entries_.erase(it);
+}
+
+// Categories
+void AutocompleteIndex::AddCategory(const Category& category) {
+    if (category.GetId() == 0) {
+        throw std::invalid_argument("Category needs an ID");
+    }
+    CategoryEntry& entry = categories_[category.GetId()];
+    if (entry.name == category.GetName()) {
+        return;
+    }
+    if (!entry.name.empty()) {
+        IndexCategoryName(entry, -1);
+    }
+    entry.name = category.GetName();
+    IndexCategoryName(entry, 1);
+}
+
+void AutocompleteIndex::RemoveCategory(int categoryId) {
+    auto it = categories_.find(categoryId);
+    if (it == categories_.end() || it->second.name.empty()) {
+        return;
+    }
+    IndexCategoryName(it->second, -1);
+    it->second.name.clear();
+    if (it->second.tasks == 0) {
+        categories_.erase(it);
+    }
+}
+
+// Completion
+std::vector<Suggestion> AutocompleteIndex::Complete(CompletionSource source, const std::string& prefix, size_t count) const {
+    const auto& values = values_.at(static_cast<size_t>(source));
+    std::vector<Suggestion> suggestions;
+    for (auto& completion : GetTrie(source).Complete(prefix, count)) {
+        auto it = values.find(Hash(completion.text));
+        std::string text = it != values.end() ? it->second.text : std::move(completion.text);
+        uint32_t weight = completion.weight;
+        if (source == CompletionSource::CATEGORY && it != values.end()) {
+            weight -= it->second.uses; // Each added category holds one unit so it stays listed
+        }
+        suggestions.push_back(Suggestion{std::move(text), source, weight});
+    }
+    return suggestions;
+}
+
+std::vector<Suggestion> AutocompleteIndex::Complete(const std::string& prefix, size_t count) const {
+    std::vector<Suggestion> suggestions;
+    for (size_t source = 0; source < SOURCE_COUNT; ++source) {
+        auto partial = Complete(static_cast<CompletionSource>(source), prefix, count);
+        suggestions.insert(suggestions.end(), partial.begin(), partial.end());
+    }
+    std::stable_sort(suggestions.begin(), suggestions.end(), [](const Suggestion& lhs, const Suggestion& rhs) {
+        return lhs.weight > rhs.weight;
+    });
+    if (suggestions.size() > count) {
+        suggestions.resize(count);
+    }
+    return suggestions;
+}
+
+const CompletionTrie& AutocompleteIndex::GetTrie(CompletionSource source) const {
+    return tries_.at(static_cast<size_t>(source));
+}
+
+// Maintenance
+void AutocompleteIndex::AddValue(CompletionSource source, const std::string& text) {
+    size_t index = static_cast<size_t>(source);
+    Value& value = values_[index][Hash(text)];
+    value.text = text; // Latest spelling wins for display
+    ++value.uses;
+    tries_[index].Add(text);
+}
+
+void AutocompleteIndex::RemoveValue(CompletionSource source, uint64_t hash) {
+    size_t index = static_cast<size_t>(source);
+    auto it = values_[index].find(hash);
+    if (it == values_[index].end()) {
+        return;
+    }
+    tries_[index].Remove(it->second.text);
+    if (--it->second.uses == 0) {
+        values_[index].erase(it);
+    }
+}
+
+void AutocompleteIndex::Remove(const Entry& entry) {
+    if (entry.title != 0) {
+        RemoveValue(CompletionSource::TITLE, entry.title);
+    }
+    for (uint64_t tag : entry.tags) {
+        RemoveValue(CompletionSource::TAG, tag);
+    }
+    if (entry.categoryId != 0) {
+        CountCategoryTask(entry.categoryId, -1);
+    }
+}
+
+void AutocompleteIndex::CountCategoryTask(int categoryId, int delta) {
+    auto it = categories_.try_emplace(categoryId).first;
+    it->second.tasks += delta;
+    if (!it->second.name.empty()) {
+        tries_[static_cast<size_t>(CompletionSource::CATEGORY)].Add(it->second.name, delta);
+    } else if (it->second.tasks == 0) {
+        categories_.erase(it);
+    }
+}
+
+void AutocompleteIndex::IndexCategoryName(const CategoryEntry& category, int sign) {
+    size_t index = static_cast<size_t>(CompletionSource::CATEGORY);
+    tries_[index].Add(category.name, sign * (static_cast<int64_t>(category.tasks) + 1));
+    auto& values = values_[index];
+    if (sign > 0) {
+        Value& value = values[Hash(category.name)];
+        value.text = category.name;
+        ++value.uses;
+        return;
+    }
+    auto it = values.find(Hash(category.name));
+    if (it != values.end() && --it->second.uses == 0) {
+        values.erase(it);
+    }
+}
+
+uint64_t AutocompleteIndex::Hash(const std::string& text) {
+    // Case-folded, like the trie keys
+    return HashUtils::Fnv1a(StringUtils::ToLower(text));
+}
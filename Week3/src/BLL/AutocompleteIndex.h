@@ -0,0 +1,83 @@
+#ifndef _AUTOCOMPLETEINDEX_H_
+#define _AUTOCOMPLETEINDEX_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../LIB/CompletionTrie.h"
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class CompletionSource {
+    TITLE,
+    TAG,
+    CATEGORY
+};
+
+struct Suggestion {
+    std::string text;
+    CompletionSource source = CompletionSource::TITLE;
+    uint32_t weight = 0; // Number of tasks using it
+};
+
+// Type-ahead over task titles, tag names and category names, weighted by
+// how many tasks use each value. Follows TaskService incrementally; each
+// task keeps only hashes of its previous values so edits move its weight,
+// and each distinct value's display text is stored once. Category names
+// come from AddCategory, so renamed and empty categories are current; tasks
+// only count toward their category's weight, by ID.
+class AutocompleteIndex : public ITaskObserver {
+public:
+    AutocompleteIndex() = default;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    // Adds the category or takes its new name; throws std::invalid_argument without an ID
+    void AddCategory(const Category& category);
+    void RemoveCategory(int categoryId); // Its tasks still count if it comes back
+
+    std::vector<Suggestion> Complete(CompletionSource source, const std::string& prefix, size_t count = 10) const;
+    // Across all sources, heaviest first
+    std::vector<Suggestion> Complete(const std::string& prefix, size_t count = 10) const;
+
+    const CompletionTrie& GetTrie(CompletionSource source) const;
+
+    static constexpr size_t SOURCE_COUNT = 3;
+
+private:
+    // Hashes of the case-folded values (0 = none)
+    struct Entry {
+        uint64_t title = 0;
+        std::vector<uint64_t> tags; // Sorted, distinct
+        int categoryId = 0;
+
+        bool operator==(const Entry& other) const = default;
+    };
+
+    struct CategoryEntry {
+        std::string name; // Empty until added
+        uint32_t tasks = 0;
+    };
+
+    struct Value {
+        std::string text; // As most recently added
+        uint32_t uses = 0;
+    };
+
+    std::array<CompletionTrie, SOURCE_COUNT> tries_;
+    std::array<std::unordered_map<uint64_t, Value>, SOURCE_COUNT> values_; // key: hash
+    std::unordered_map<int, Entry> entries_; // key: task ID
+    std::unordered_map<int, CategoryEntry> categories_; // key: category ID
+
+    void AddValue(CompletionSource source, const std::string& text);
+    void RemoveValue(CompletionSource source, uint64_t hash);
+    void CountCategoryTask(int categoryId, int delta);
+    void IndexCategoryName(const CategoryEntry& category, int sign);
+    void Remove(const Entry& entry);
+    static uint64_t Hash(const std::string& text);
+};
+
+#endif // _AUTOCOMPLETEINDEX_H_
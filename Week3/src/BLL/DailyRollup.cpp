@@ -0,0 +1,325 @@
+#include "DailyRollup.h"
+#include "../BLL/StatsAccumulator.h"
+#include "../LIB/IdGenerator.h"
+#include "../LIB/Logger.h"
+#include "../LIB/StringUtils.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+using namespace std::chrono;
+namespace fs = std::filesystem;
+
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+// DaySeries
+void DaySeries::Add(int64_t day, int64_t delta) {
+    if (delta == 0) {
+        return;
+    }
+    
+    int64_t index = PageOf(day);
+    Page& page = pages_[index];
+    size_t offset = static_cast<size_t>(day - index * PAGE_DAYS);
+    int64_t before = page.counts[offset];
+    page.counts[offset] += delta;
+    page.total += delta;
+    page.nonZero += (before == 0) - (page.counts[offset] == 0);
+    if (page.nonZero == 0) {
+        pages_.erase(index);
+        return;
+    }
+    for (size_t i = offset + 1; i <= page.tree.size(); i += i & (~i + 1)) {
+        page.tree[i - 1] += delta;
+    }
+}
+
+int64_t DaySeries::Sum(int64_t fromDay, int64_t toDay) const {
+    if (toDay <= fromDay) {
+        return 0;
+    }
+    
+    // Whole pages contribute their total, the two end pages a partial prefix
+    int64_t lastPage = PageOf(toDay - 1);
+    int64_t sum = 0;
+    for (auto it = pages_.lower_bound(PageOf(fromDay)); it != pages_.end() && it->first <= lastPage; ++it) {
+        int64_t start = it->first * PAGE_DAYS;
+        int64_t from = std::max<int64_t>(fromDay - start, 0);
+        int64_t to = std::min<int64_t>(toDay - start, PAGE_DAYS);
+        sum += (from == 0 && to == PAGE_DAYS) ? it->second.total
+                                               : it->second.Prefix(to) - it->second.Prefix(from);
+    }
+    return sum;
+}
+
+int64_t DaySeries::GetDay(int64_t day) const {
+    int64_t index = PageOf(day);
+    auto it = pages_.find(index);
+    if (it == pages_.end()) {
+        return 0;
+    }
+    return it->second.counts[static_cast<size_t>(day - index * PAGE_DAYS)];
+}
+
+bool DaySeries::IsEmpty() const {
+    return pages_.empty();
+}
+
+int64_t DaySeries::Page::Prefix(int64_t length) const {
+    int64_t sum = 0;
+    for (size_t i = static_cast<size_t>(length); i > 0; i -= i & (~i + 1)) {
+        sum += tree[i - 1];
+    }
+    return sum;
+}
+
+int64_t DaySeries::PageOf(int64_t day) {
+    return day >= 0 ? day / PAGE_DAYS : -((-day + PAGE_DAYS - 1) / PAGE_DAYS);
+}
+
+// DailyRollup
+bool DailyRollup::SeriesKey::operator<(const SeriesKey& other) const {
+    return std::tie(metric, dimension, value) < std::tie(other.metric, other.dimension, other.value);
+}
+
+void DailyRollup::OnTaskAdded(const TaskPtr& task) {
+    auto it = contributions_.find(task->GetId());
+    if (it != contributions_.end() && task->GetVersion() <= coveredVersion_) {
+        return; // Replay of a task Load() already counted
+    }
+    
+    Contribution contribution = MakeContribution(*task);
+    if (it != contributions_.end()) {
+        if (it->second == contribution) {
+            return;
+        }
+        Apply(it->second, -1);
+        it->second = contribution;
+    } else {
+        contributions_.emplace(task->GetId(), contribution);
+    }
+    Apply(contribution, 1);
+}
+
+void DailyRollup::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void DailyRollup::OnTaskRemoved(const TaskPtr& task) {
+    auto it = contributions_.find(task->GetId());
+    if (it == contributions_.end()) {
+        return;
+    }
+    Apply(it->second, -1);
+    contributions_.erase(it);
+}
+
+int64_t DailyRollup::Count(RollupMetric metric, RollupDimension dimension, int value,
+                           const system_clock::time_point& from,
+                           const system_clock::time_point& to) const {
+    auto it = series_.find(SeriesKey{metric, dimension, dimension == RollupDimension::ALL ? 0 : value});
+    if (it == series_.end()) {
+        return 0;
+    }
+    return it->second.Sum(DayIndex(from), DayIndex(to));
+}
+
+ProductivityStats DailyRollup::GetRangeStats(const system_clock::time_point& from,
+                                             const system_clock::time_point& to,
+                                             int categoryId) const {
+    ProductivityStats stats;
+    
+    if (categoryId != 0) {
+        // Category series only carry totals
+        stats.totalTasks = static_cast<int>(Count(RollupMetric::CREATED, RollupDimension::CATEGORY, categoryId, from, to));
+        stats.completedTasks = static_cast<int>(Count(RollupMetric::COMPLETED, RollupDimension::CATEGORY, categoryId, from, to));
+        stats.completionRate = stats.totalTasks > 0
+            ? static_cast<double>(stats.completedTasks) / stats.totalTasks : 0.0;
+        return stats;
+    }
+    
+    stats.totalTasks = static_cast<int>(Count(RollupMetric::CREATED, RollupDimension::ALL, 0, from, to));
+    for (int i = 0; i < static_cast<int>(PRIORITY_COUNT); ++i) {
+        int count = static_cast<int>(Count(RollupMetric::CREATED, RollupDimension::PRIORITY, i, from, to));
+        if (count != 0) {
+            stats.tasksByPriority[static_cast<Enums::Priority>(i)] = count;
+        }
+    }
+    for (int i = 0; i < static_cast<int>(TASK_STATUS_COUNT); ++i) {
+        int count = static_cast<int>(Count(RollupMetric::CREATED, RollupDimension::STATUS, i, from, to));
+        if (count != 0) {
+            stats.tasksByStatus[static_cast<Enums::TaskStatus>(i)] = count;
+        }
+    }
+    
+    auto status = [&stats](Enums::TaskStatus s) {
+        auto it = stats.tasksByStatus.find(s);
+        return it == stats.tasksByStatus.end() ? 0 : it->second;
+    };
+    stats.completedTasks = status(Enums::TaskStatus::COMPLETED);
+    stats.pendingTasks = status(Enums::TaskStatus::PENDING);
+    stats.completionRate = stats.totalTasks > 0
+        ? static_cast<double>(stats.completedTasks) / stats.totalTasks : 0.0;
+    
+    int64_t timed = Count(RollupMetric::TIMED_COMPLETIONS, RollupDimension::ALL, 0, from, to);
+    if (timed > 0) {
+        double seconds = static_cast<double>(Count(RollupMetric::COMPLETION_SECONDS, RollupDimension::ALL, 0, from, to));
+        stats.averageCompletionTimeHours = seconds / 3600.0 / static_cast<double>(timed);
+    }
+    return stats;
+}
+
+// Persistence
+bool DailyRollup::Save(const std::string& filename) const {
+    try {
+        std::string tempFile = filename + ".tmp";
+        {
+            std::ofstream file(tempFile);
+            if (!file.is_open()) {
+                LOG_ERROR("Failed to open file for writing: " + tempFile);
+                return false;
+            }
+            
+            // S,metric,dimension,value,day:count;day:count...
+            for (const auto& [key, series] : series_) {
+                file << "S," << static_cast<int>(key.metric) << "," << static_cast<int>(key.dimension)
+                     << "," << key.value << ",";
+                bool first = true;
+                series.ForEachDay([&file, &first](int64_t day, int64_t count) {
+                    file << (first ? "" : ";") << day << ":" << count;
+                    first = false;
+                });
+                file << "\n";
+            }
+            
+            // T,taskId,createdDay,completedDay,completionSeconds,completed,timed,status,priority,categoryId
+            for (const auto& [taskId, c] : contributions_) {
+                file << "T," << taskId << "," << c.createdDay << "," << c.completedDay << ","
+                     << c.completionSeconds << "," << c.completed << "," << c.timed << ","
+                     << c.status << "," << c.priority << "," << c.categoryId << "\n";
+            }
+        }
+        
+        fs::rename(tempFile, filename);
+        return true;
+        
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error saving rollups: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool DailyRollup::Load(const std::string& filename) {
+    Clear();
+    
+    try {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            LOG_INFO("No rollup file found: " + filename);
+            return false;
+        }
+        
+        std::string line;
+        while (std::getline(file, line)) {
+            std::vector<std::string> fields = StringUtils::Split(line, ',');
+            if (fields.empty()) {
+                continue;
+            }
+            
+            if (fields[0] == "S" && fields.size() >= 4) {
+                SeriesKey key{static_cast<RollupMetric>(std::stoi(fields[1])),
+                              static_cast<RollupDimension>(std::stoi(fields[2])),
+                              std::stoi(fields[3])};
+                DaySeries& series = series_[key];
+                if (fields.size() > 4) {
+                    for (const auto& entry : StringUtils::Split(fields[4], ';')) {
+                        size_t colon = entry.find(':');
+                        if (colon != std::string::npos) {
+                            series.Add(std::stoll(entry.substr(0, colon)), std::stoll(entry.substr(colon + 1)));
+                        }
+                    }
+                }
+            } else if (fields[0] == "T" && fields.size() >= 10) {
+                Contribution c;
+                c.createdDay = std::stoll(fields[2]);
+                c.completedDay = std::stoll(fields[3]);
+                c.completionSeconds = std::stoll(fields[4]);
+                c.completed = fields[5] == "1";
+                c.timed = fields[6] == "1";
+                c.status = std::stoi(fields[7]);
+                c.priority = std::stoi(fields[8]);
+                c.categoryId = std::stoi(fields[9]);
+                contributions_[std::stoi(fields[1])] = c;
+            }
+        }
+        
+        coveredVersion_ = IdGenerator::GetInstance().GetCurrentVersion();
+        LOG_INFO("Loaded rollups for " + std::to_string(contributions_.size()) + " tasks from " + filename);
+        return true;
+        
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error loading rollups: " + std::string(e.what()));
+        Clear();
+        return false;
+    }
+}
+
+void DailyRollup::Clear() {
+    series_.clear();
+    contributions_.clear();
+    coveredVersion_ = 0;
+}
+
+int64_t DailyRollup::DayIndex(const system_clock::time_point& time) {
+    if (time == system_clock::time_point::min()) {
+        return INT64_MIN / 2;
+    }
+    if (time == system_clock::time_point::max()) {
+        return INT64_MAX / 2;
+    }
+    int64_t seconds = floor<std::chrono::seconds>(time.time_since_epoch()).count();
+    return seconds >= 0 ? seconds / SECONDS_PER_DAY : -((-seconds + SECONDS_PER_DAY - 1) / SECONDS_PER_DAY);
+}
+
+void DailyRollup::Apply(const Contribution& c, int sign) {
+    AddToSeries(RollupMetric::CREATED, c.createdDay, sign, c.priority, c.status, c.categoryId);
+    if (c.completed) {
+        AddToSeries(RollupMetric::COMPLETED, c.completedDay, sign, c.priority, -1, c.categoryId);
+    }
+    if (c.timed) {
+        series_[SeriesKey{RollupMetric::TIMED_COMPLETIONS, RollupDimension::ALL, 0}].Add(c.createdDay, sign);
+        series_[SeriesKey{RollupMetric::COMPLETION_SECONDS, RollupDimension::ALL, 0}].Add(c.createdDay, sign * c.completionSeconds);
+    }
+}
+
+void DailyRollup::AddToSeries(RollupMetric metric, int64_t day, int64_t delta,
+                              int priority, int status, int categoryId) {
+    series_[SeriesKey{metric, RollupDimension::ALL, 0}].Add(day, delta);
+    series_[SeriesKey{metric, RollupDimension::PRIORITY, priority}].Add(day, delta);
+    if (status >= 0) {
+        series_[SeriesKey{metric, RollupDimension::STATUS, status}].Add(day, delta);
+    }
+    if (categoryId != 0) {
+        series_[SeriesKey{metric, RollupDimension::CATEGORY, categoryId}].Add(day, delta);
+    }
+}
+
+DailyRollup::Contribution DailyRollup::MakeContribution(const Task& task) {
+    Contribution c;
+    c.createdDay = DayIndex(task.GetCreatedAt());
+    c.status = static_cast<int>(task.GetStatus());
+    c.priority = static_cast<int>(task.GetPriority());
+    c.categoryId = task.GetCategoryId();
+    c.completed = task.GetStatus() == Enums::TaskStatus::COMPLETED &&
+                  task.GetCompletedAt() != system_clock::time_point::min();
+    if (c.completed) {
+        c.completedDay = DayIndex(task.GetCompletedAt());
+    }
+    c.timed = StatsAccumulator::HasCompletionTime(task.GetStatus(), task.GetCreatedAt(), task.GetCompletedAt());
+    if (c.timed) {
+        c.completionSeconds = duration_cast<seconds>(task.GetCompletedAt() - task.GetCreatedAt()).count();
+    }
+    return c;
+}
@@ -0,0 +1,131 @@
+#ifndef _DAILYROLLUP_H_
+#define _DAILYROLLUP_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../DTO/ProductivityStats.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Per-day counters kept in 256-day pages, each a Fenwick tree (prefix sums
+// with O(log days) updates). Only pages holding non-zero days exist, so an
+// outlier date costs one page rather than every day in between.
+class DaySeries {
+public:
+    void Add(int64_t day, int64_t delta);
+    int64_t Sum(int64_t fromDay, int64_t toDay) const; // [fromDay, toDay)
+    int64_t GetDay(int64_t day) const;
+
+    // Calls fn(day, count) for each non-zero day in ascending order
+    template <typename Fn>
+    void ForEachDay(Fn&& fn) const {
+        for (const auto& [index, page] : pages_) {
+            for (int64_t i = 0; i < PAGE_DAYS; ++i) {
+                if (page.counts[static_cast<size_t>(i)] != 0) {
+                    fn(index * PAGE_DAYS + i, page.counts[static_cast<size_t>(i)]);
+                }
+            }
+        }
+    }
+    bool IsEmpty() const;
+
+private:
+    static constexpr int64_t PAGE_DAYS = 256;
+
+    struct Page {
+        std::array<int64_t, PAGE_DAYS> counts{};
+        std::array<int64_t, PAGE_DAYS> tree{}; // 1-based Fenwick tree over counts
+        int64_t total = 0;
+        int nonZero = 0; // Page is dropped when this reaches 0
+
+        int64_t Prefix(int64_t length) const; // Sum of the first length days
+    };
+
+    std::map<int64_t, Page> pages_; // key: page index (floor(day / PAGE_DAYS))
+
+    static int64_t PageOf(int64_t day);
+};
+
+enum class RollupMetric {
+    CREATED,            // Tasks by creation day
+    COMPLETED,          // Tasks by completion day
+    COMPLETION_SECONDS, // Sum of completion time, by creation day
+    TIMED_COMPLETIONS   // Tasks with a valid completion time, by creation day
+};
+
+enum class RollupDimension {
+    ALL,
+    PRIORITY,
+    STATUS,   // Current status (CREATED metric only)
+    CATEGORY
+};
+
+// Day-bucketed rollups of task creation and completion per category,
+// priority and status. Days are UTC calendar days. Kept current through
+// ITaskObserver and persisted with Save/Load so startup needs no rescan:
+// save the rollup together with the tasks, and after loading both, replayed
+// tasks that Load already covers (unchanged since it ran) are skipped.
+class DailyRollup : public ITaskObserver {
+public:
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    // Day-aligned range queries over [from, to), independent of task count
+    int64_t Count(RollupMetric metric, RollupDimension dimension, int value,
+                  const std::chrono::system_clock::time_point& from,
+                  const std::chrono::system_clock::time_point& to) const;
+    // Stats for tasks created in the range (categoryId 0 = all categories).
+    // Overdue is time dependent and not part of the rollup.
+    ProductivityStats GetRangeStats(const std::chrono::system_clock::time_point& from,
+                                    const std::chrono::system_clock::time_point& to,
+                                    int categoryId = 0) const;
+
+    // Persistence
+    bool Save(const std::string& filename) const;
+    // Tasks at or below the current version count as covered; load the
+    // tasks first
+    bool Load(const std::string& filename);
+    void Clear();
+
+    static int64_t DayIndex(const std::chrono::system_clock::time_point& time);
+
+private:
+    // What a task contributed, so updates subtract exactly the old values
+    struct Contribution {
+        int64_t createdDay = 0;
+        int64_t completedDay = 0;
+        int64_t completionSeconds = 0;
+        bool completed = false;
+        bool timed = false;
+        int status = 0;
+        int priority = 0;
+        int categoryId = 0;
+
+        bool operator==(const Contribution& other) const = default;
+    };
+
+    struct SeriesKey {
+        RollupMetric metric;
+        RollupDimension dimension;
+        int value;
+
+        bool operator<(const SeriesKey& other) const;
+    };
+
+    std::map<SeriesKey, DaySeries> series_;
+    std::unordered_map<int, Contribution> contributions_; // key: task ID
+    uint64_t coveredVersion_ = 0; // Task versions up to this were counted by Load
+
+    void Apply(const Contribution& contribution, int sign);
+    void AddToSeries(RollupMetric metric, int64_t day, int64_t delta,
+                     int priority, int status, int categoryId);
+    static Contribution MakeContribution(const Task& task);
+};
+
+#endif // _DAILYROLLUP_H_
@@ -0,0 +1,184 @@
+#include "DueDateIndex.h"
+#include <algorithm>
+#include <climits>
+
+DueDateIndex::DueDateIndex(bool openTasksOnly)
+    : openTasksOnly_(openTasksOnly) {
+}
+
+// ITaskObserver
+void DueDateIndex::OnTaskAdded(const TaskPtr& task) {
+    bool closed = task->GetStatus() == Enums::TaskStatus::COMPLETED ||
+                  task->GetStatus() == Enums::TaskStatus::CANCELLED;
+    if (openTasksOnly_ && closed) {
+        Erase(task->GetId());
+    } else {
+        Insert(task->GetId(), task->GetDueDate());
+    }
+}
+
+void DueDateIndex::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void DueDateIndex::OnTaskRemoved(const TaskPtr& task) {
+    Erase(task->GetId());
+}
+
+// Modification
+void DueDateIndex::Insert(int taskId, const TimePoint& dueDate) {
+    Entry entry{dueDate.time_since_epoch().count(), taskId};
+    
+    auto it = dueByTask_.find(taskId);
+    if (it != dueByTask_.end()) {
+        if (it->second == entry.dueTicks) {
+            return;
+        }
+        EraseEntry(Entry{it->second, taskId});
+        it->second = entry.dueTicks;
+    } else {
+        dueByTask_.emplace(taskId, entry.dueTicks);
+    }
+    
+    if (blocks_.empty()) {
+        blocks_.push_back({entry});
+        RebuildSummary();
+        return;
+    }
+    
+    size_t block = FindBlock(entry);
+    auto& entries = blocks_[block];
+    entries.insert(std::lower_bound(entries.begin(), entries.end(), entry), entry);
+    
+    if (entries.size() >= 2 * BLOCK_SIZE) {
+        std::vector<Entry> upper(entries.begin() + BLOCK_SIZE, entries.end());
+        entries.resize(BLOCK_SIZE);
+        blocks_.insert(blocks_.begin() + block + 1, std::move(upper));
+        RebuildSummary();
+    } else {
+        blockMax_[block] = entries.back();
+        AddBlockSize(block, 1);
+    }
+}
+
+bool DueDateIndex::Erase(int taskId) {
+    auto it = dueByTask_.find(taskId);
+    if (it == dueByTask_.end()) {
+        return false;
+    }
+    EraseEntry(Entry{it->second, taskId});
+    dueByTask_.erase(it);
+    return true;
+}
+
+void DueDateIndex::Clear() {
+    blocks_.clear();
+    dueByTask_.clear();
+    RebuildSummary();
+}
+
+// Queries
+bool DueDateIndex::Contains(int taskId) const {
+    return dueByTask_.count(taskId) > 0;
+}
+
+size_t DueDateIndex::Size() const {
+    return dueByTask_.size();
+}
+
+size_t DueDateIndex::Count(const TimePoint& from, const TimePoint& to) const {
+    if (to <= from) {
+        return 0;
+    }
+    return Rank(Lower(to)) - Rank(Lower(from));
+}
+
+std::vector<int> DueDateIndex::GetRange(const TimePoint& from, const TimePoint& to) const {
+    std::vector<int> ids;
+    ids.reserve(Count(from, to));
+    ForEachInRange(from, to, [&ids](const Entry& entry) { ids.push_back(entry.taskId); });
+    return ids;
+}
+
+std::vector<DueDateIndex::Entry> DueDateIndex::FirstAfter(const TimePoint& time, size_t count) const {
+    std::vector<Entry> result;
+    auto [block, pos] = Locate(Lower(time));
+    for (; block < blocks_.size() && result.size() < count; ++block, pos = 0) {
+        const auto& entries = blocks_[block];
+        size_t take = std::min(entries.size() - pos, count - result.size());
+        result.insert(result.end(), entries.begin() + pos, entries.begin() + pos + take);
+    }
+    return result;
+}
+
+size_t DueDateIndex::CountOverdue(const TimePoint& asOf) const {
+    return Rank(Lower(asOf));
+}
+
+std::vector<int> DueDateIndex::GetOverdue(const TimePoint& asOf) const {
+    return GetRange(TimePoint::min(), asOf);
+}
+
+// Block structure
+DueDateIndex::Entry DueDateIndex::Lower(const TimePoint& time) {
+    return Entry{time.time_since_epoch().count(), INT_MIN};
+}
+
+size_t DueDateIndex::FindBlock(const Entry& entry) const {
+    // First block whose maximum is >= entry; entries past the end go to the last block
+    auto it = std::lower_bound(blockMax_.begin(), blockMax_.end(), entry);
+    return it == blockMax_.end() ? blockMax_.size() - 1 : static_cast<size_t>(it - blockMax_.begin());
+}
+
+std::pair<size_t, size_t> DueDateIndex::Locate(const Entry& entry) const {
+    auto it = std::lower_bound(blockMax_.begin(), blockMax_.end(), entry);
+    size_t block = static_cast<size_t>(it - blockMax_.begin());
+    if (block == blocks_.size()) {
+        return {block, 0};
+    }
+    const auto& entries = blocks_[block];
+    return {block, static_cast<size_t>(std::lower_bound(entries.begin(), entries.end(), entry) - entries.begin())};
+}
+
+size_t DueDateIndex::Rank(const Entry& entry) const {
+    auto [block, pos] = Locate(entry);
+    size_t before = 0;
+    for (size_t i = block; i > 0; i -= i & (~i + 1)) {
+        before += sizeTree_[i];
+    }
+    return before + pos;
+}
+
+void DueDateIndex::EraseEntry(const Entry& entry) {
+    auto [block, pos] = Locate(entry);
+    auto& entries = blocks_[block];
+    entries.erase(entries.begin() + pos);
+    
+    if (entries.empty()) {
+        blocks_.erase(blocks_.begin() + block);
+        RebuildSummary();
+    } else {
+        blockMax_[block] = entries.back();
+        AddBlockSize(block, -1);
+    }
+}
+
+void DueDateIndex::AddBlockSize(size_t block, long delta) {
+    for (size_t i = block + 1; i < sizeTree_.size(); i += i & (~i + 1)) {
+        sizeTree_[i] += delta;
+    }
+}
+
+void DueDateIndex::RebuildSummary() {
+    blockMax_.clear();
+    sizeTree_.assign(blocks_.size() + 1, 0);
+    for (size_t block = 0; block < blocks_.size(); ++block) {
+        blockMax_.push_back(blocks_[block].back());
+        size_t i = block + 1;
+        sizeTree_[i] += blocks_[block].size();
+        size_t parent = i + (i & (~i + 1));
+        if (parent < sizeTree_.size()) {
+            sizeTree_[parent] += sizeTree_[i];
+        }
+    }
+}
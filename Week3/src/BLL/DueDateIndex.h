@@ -0,0 +1,97 @@
+#ifndef _DUEDATEINDEX_H_
+#define _DUEDATEINDEX_H_
+
+#include "../BLL/ITaskObserver.h"
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Ordered index on (due date, task ID) kept as a list of sorted blocks with
+// a Fenwick tree over block sizes, so lookups, counts and the start of a
+// range scan cost O(log n) and iteration costs the output size. By default
+// only open tasks (not completed or cancelled) are indexed, which makes
+// "overdue" a plain range query.
+class DueDateIndex : public ITaskObserver {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    struct Entry {
+        int64_t dueTicks = 0;
+        int taskId = 0;
+
+        bool operator<(const Entry& other) const {
+            return dueTicks != other.dueTicks ? dueTicks < other.dueTicks : taskId < other.taskId;
+        }
+        TimePoint GetDueDate() const { return TimePoint(TimePoint::duration(dueTicks)); }
+    };
+
+    explicit DueDateIndex(bool openTasksOnly = true);
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    void Insert(int taskId, const TimePoint& dueDate); // Replaces an existing entry
+    bool Erase(int taskId);
+    void Clear();
+
+    bool Contains(int taskId) const;
+    size_t Size() const;
+
+    // Ranges are [from, to)
+    size_t Count(const TimePoint& from, const TimePoint& to) const;
+    std::vector<int> GetRange(const TimePoint& from, const TimePoint& to) const;
+    std::vector<Entry> FirstAfter(const TimePoint& time, size_t count) const; // due >= time
+    size_t CountOverdue(const TimePoint& asOf) const;
+    std::vector<int> GetOverdue(const TimePoint& asOf) const;
+
+    template <typename Fn>
+    void ForEachInRange(const TimePoint& from, const TimePoint& to, Fn&& fn) const {
+        int64_t end = to.time_since_epoch().count();
+        auto [block, pos] = Locate(Lower(from));
+        for (; block < blocks_.size(); ++block, pos = 0) {
+            const auto& entries = blocks_[block];
+            for (; pos < entries.size(); ++pos) {
+                if (entries[pos].dueTicks >= end) {
+                    return;
+                }
+                fn(entries[pos]);
+            }
+        }
+    }
+
+    // Visits entries sorting after `after` in order while fn returns true
+    template <typename Fn>
+    void ForEachAfter(const Entry& after, Fn&& fn) const {
+        auto [block, pos] = Locate(after);
+        for (; block < blocks_.size(); ++block, pos = 0) {
+            const auto& entries = blocks_[block];
+            for (; pos < entries.size(); ++pos) {
+                if (after < entries[pos] && !fn(entries[pos])) {
+                    return;
+                }
+            }
+        }
+    }
+
+    static constexpr size_t BLOCK_SIZE = 256;
+
+private:
+    bool openTasksOnly_;
+    std::vector<std::vector<Entry>> blocks_;   // Each sorted, in global order
+    std::vector<Entry> blockMax_;              // Last entry of each block
+    std::vector<size_t> sizeTree_;             // Fenwick tree over block sizes
+    std::unordered_map<int, int64_t> dueByTask_;
+
+    static Entry Lower(const TimePoint& time);
+    size_t FindBlock(const Entry& entry) const;
+    std::pair<size_t, size_t> Locate(const Entry& entry) const; // (block, position) of first entry >= entry
+    size_t Rank(const Entry& entry) const;                      // Entries < entry
+    void EraseEntry(const Entry& entry);
+    void AddBlockSize(size_t block, long delta);
+    void RebuildSummary();
+};
+
+#endif // _DUEDATEINDEX_H_
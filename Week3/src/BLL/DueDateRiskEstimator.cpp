@@ -0,0 +1,270 @@
+#include "DueDateRiskEstimator.h"
+#include "../BLL/StatsAccumulator.h"
+#include "../LIB/Clock.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+    constexpr double TICKS_PER_HOUR = static_cast<double>(duration_cast<system_clock::duration>(hours(1)).count());
+
+    // Survival function of N(mean, stdDev)
+    double Survival(double x, double mean, double stdDev) {
+        return 0.5 * std::erfc((x - mean) / (stdDev * M_SQRT2));
+    }
+}
+
+DueDateRiskEstimator::DueDateRiskEstimator(double alpha, hours throughputWindow)
+    : alpha_(alpha)
+    , windowDays_(static_cast<double>(throughputWindow.count()) / 24.0) {
+    
+    if (alpha <= 0.0 || alpha > 1.0) {
+        throw std::invalid_argument("EWMA alpha must be in (0, 1]");
+    }
+    if (throughputWindow.count() <= 0) {
+        throw std::invalid_argument("Throughput window must be positive");
+    }
+}
+
+// ITaskObserver
+void DueDateRiskEstimator::OnTaskAdded(const TaskPtr& task) {
+    TaskState state{task->GetStatus(), task->GetCategoryId()};
+    auto [it, inserted] = lastState_.try_emplace(task->GetId(), state);
+    TaskState previous = it->second;
+    it->second = state;
+    if (!inserted) {
+        CountOpen(previous, -1);
+    }
+    CountOpen(state, 1);
+    
+    // Count each completion once, when the task enters COMPLETED
+    bool completedNow = task->GetStatus() == Enums::TaskStatus::COMPLETED &&
+                        (inserted || previous.status != Enums::TaskStatus::COMPLETED);
+    if (completedNow && StatsAccumulator::HasCompletionTime(task->GetStatus(), task->GetCreatedAt(),
+                                                            task->GetCompletedAt())) {
+        ObserveCompletion(task->GetCategoryId(), task->GetCreatedAt(), task->GetCompletedAt());
+    }
+}
+
+void DueDateRiskEstimator::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void DueDateRiskEstimator::OnTaskRemoved(const TaskPtr& task) {
+    // Estimates describe history; a deleted task's completion still counts
+    auto it = lastState_.find(task->GetId());
+    if (it != lastState_.end()) {
+        CountOpen(it->second, -1);
+        lastState_.erase(it);
+    }
+}
+
+void DueDateRiskEstimator::ObserveCompletion(int categoryId,
+                                             const system_clock::time_point& createdAt,
+                                             const system_clock::time_point& completedAt) {
+    double leadHours = StatsAccumulator::CompletionHours(createdAt, completedAt);
+    int64_t eventSeconds = floor<seconds>(completedAt.time_since_epoch()).count();
+    
+    overall_.Observe(leadHours, eventSeconds, alpha_, windowDays_);
+    if (categoryId != 0) {
+        byCategory_[categoryId].Observe(leadHours, eventSeconds, alpha_, windowDays_);
+    }
+}
+
+void DueDateRiskEstimator::Seed(const ProductivityReport& report) {
+    auto seed = [](Ewma& ewma, const ProductivityStats& stats) {
+        if (ewma.HasData() || stats.averageCompletionTimeHours <= 0.0) {
+            return; // Observed data wins
+        }
+        ewma.mean = stats.averageCompletionTimeHours;
+        ewma.variance = stats.averageCompletionTimeHours * stats.averageCompletionTimeHours;
+        ewma.seeded = true;
+    };
+    
+    seed(overall_, report.GetOverallStats());
+    for (const auto& [categoryId, stats] : report.GetCategoryStats()) {
+        seed(byCategory_[categoryId], stats);
+    }
+}
+
+DueDateRiskEstimator::Estimate DueDateRiskEstimator::GetEstimate(int categoryId,
+                                                                  const system_clock::time_point& asOf) const {
+    const Ewma& ewma = Select(categoryId);
+    Estimate estimate;
+    estimate.leadTimeHours = ewma.mean;
+    estimate.leadTimeStdDevHours = ewma.HasData() ? StdDev(ewma) : 0.0;
+    estimate.throughputPerDay = RateAt(ewma, asOf);
+    estimate.openTasks = OpenTasks(categoryId, ewma);
+    estimate.samples = ewma.samples;
+    estimate.seeded = ewma.seeded;
+    return estimate;
+}
+
+DueDateRiskEstimator::Estimate DueDateRiskEstimator::GetEstimate(int categoryId) const {
+    return GetEstimate(categoryId, Clock::GetInstance().Now());
+}
+
+// Scoring
+double DueDateRiskEstimator::ScoreTask(const Task& task, const system_clock::time_point& asOf) const {
+    if (task.GetStatus() == Enums::TaskStatus::COMPLETED || task.GetStatus() == Enums::TaskStatus::CANCELLED) {
+        return 0.0;
+    }
+    if (task.GetDueDate() <= asOf) {
+        return 1.0;
+    }
+    
+    const Ewma& ewma = Select(task.GetCategoryId());
+    if (!ewma.HasData()) {
+        return 0.0;
+    }
+    double allowed = StatsAccumulator::CompletionHours(task.GetCreatedAt(), task.GetDueDate());
+    double elapsed = StatsAccumulator::CompletionHours(task.GetCreatedAt(), asOf);
+    double mean = std::max(ewma.mean, elapsed + QueueHours(task.GetCategoryId(), ewma, asOf));
+    return Risk(allowed, elapsed, mean, StdDev(ewma));
+}
+
+std::vector<double> DueDateRiskEstimator::ScoreAll(const TaskTable& table, const system_clock::time_point& asOf) const {
+    size_t rows = table.GetRowCount();
+    const auto& status = table.GetStatusColumn();
+    const auto& category = table.GetCategoryColumn();
+    const auto& due = table.GetDueColumn();
+    const auto& created = table.GetCreatedColumn();
+    
+    // Gather per-row parameters (category lookups, cached across runs of rows)
+    std::vector<double> mean(rows), stdDev(rows), queue(rows);
+    int lastCategory = -1;
+    const Ewma* ewma = nullptr;
+    double queueHours = 0.0;
+    for (size_t i = 0; i < rows; ++i) {
+        if (!ewma || category[i] != lastCategory) {
+            lastCategory = category[i];
+            ewma = &Select(lastCategory);
+            queueHours = QueueHours(lastCategory, *ewma, asOf);
+        }
+        mean[i] = ewma->HasData() ? ewma->mean : NAN;
+        stdDev[i] = StdDev(*ewma);
+        queue[i] = queueHours;
+    }
+    
+    // Column arithmetic over all rows
+    int64_t now = static_cast<int64_t>(asOf.time_since_epoch().count());
+    constexpr int8_t COMPLETED = static_cast<int8_t>(Enums::TaskStatus::COMPLETED);
+    constexpr int8_t CANCELLED = static_cast<int8_t>(Enums::TaskStatus::CANCELLED);
+    std::vector<double> scores(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        double allowed = static_cast<double>(due[i] - created[i]) / TICKS_PER_HOUR;
+        double elapsed = static_cast<double>(now - created[i]) / TICKS_PER_HOUR;
+        bool open = status[i] != COMPLETED && status[i] != CANCELLED;
+        bool overdue = due[i] <= now;
+        double risk = std::isnan(mean[i]) ? 0.0 : Risk(allowed, elapsed, std::max(mean[i], elapsed + queue[i]), stdDev[i]);
+        scores[i] = open ? (overdue ? 1.0 : risk) : 0.0;
+    }
+    return scores;
+}
+
+std::vector<RiskScore> DueDateRiskEstimator::GetAtRisk(const TaskTable& table, const system_clock::time_point& asOf,
+                                                       double threshold) const {
+    std::vector<double> scores = ScoreAll(table, asOf);
+    std::vector<RiskScore> result;
+    for (size_t row = 0; row < scores.size(); ++row) {
+        if (scores[row] >= threshold) {
+            result.push_back(RiskScore{table.GetTaskId(row), scores[row]});
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const RiskScore& lhs, const RiskScore& rhs) {
+        return lhs.risk != rhs.risk ? lhs.risk > rhs.risk : lhs.taskId < rhs.taskId;
+    });
+    return result;
+}
+
+// Estimation
+bool DueDateRiskEstimator::Ewma::HasData() const {
+    return samples > 0 || seeded;
+}
+
+void DueDateRiskEstimator::Ewma::Observe(double leadHours, int64_t eventSeconds, double alpha, double windowDays) {
+    // A seed counts as history for the mean, but the rate starts at the
+    // first observed completion
+    double elapsedDays = samples == 0 ? 0.0 : std::max<double>(0.0, static_cast<double>(eventSeconds - lastEventSeconds) / 86400.0);
+    if (!HasData()) {
+        mean = leadHours;
+        variance = 0.0;
+    } else {
+        // West's incremental EW variance
+        double diff = leadHours - mean;
+        double increment = alpha * diff;
+        mean += increment;
+        variance = (1.0 - alpha) * (variance + diff * increment);
+    }
+    
+    // Decayed rate: each completion adds 1/window, older ones fade with exp(-dt/window)
+    rate = rate * std::exp(-elapsedDays / windowDays) + 1.0 / windowDays;
+    lastEventSeconds = samples == 0 ? eventSeconds : std::max(lastEventSeconds, eventSeconds);
+    ++samples;
+}
+
+const DueDateRiskEstimator::Ewma& DueDateRiskEstimator::Select(int categoryId) const {
+    auto it = byCategory_.find(categoryId);
+    if (categoryId != 0 && it != byCategory_.end() &&
+        (it->second.seeded || it->second.samples >= MIN_SAMPLES)) {
+        return it->second;
+    }
+    return overall_;
+}
+
+int DueDateRiskEstimator::OpenTasks(int categoryId, const Ewma& ewma) const {
+    if (&ewma == &overall_) {
+        return openTotal_;
+    }
+    auto it = openByCategory_.find(categoryId);
+    return it == openByCategory_.end() ? 0 : it->second;
+}
+
+double DueDateRiskEstimator::RateAt(const Ewma& ewma, const system_clock::time_point& asOf) const {
+    if (ewma.samples == 0) {
+        return 0.0;
+    }
+    // Decay through the quiet time since the last completion
+    int64_t asOfSeconds = floor<seconds>(asOf.time_since_epoch()).count();
+    double quietDays = std::max<double>(0.0, static_cast<double>(asOfSeconds - ewma.lastEventSeconds) / 86400.0);
+    return ewma.rate * std::exp(-quietDays / windowDays_);
+}
+
+double DueDateRiskEstimator::QueueHours(int categoryId, const Ewma& ewma, const system_clock::time_point& asOf) const {
+    // Unknown throughput (no completions yet) puts no bound on the lead time
+    double rate = RateAt(ewma, asOf);
+    if (rate <= 0.0) {
+        return 0.0;
+    }
+    return 0.5 * static_cast<double>(OpenTasks(categoryId, ewma)) / rate * 24.0;
+}
+
+void DueDateRiskEstimator::CountOpen(const TaskState& state, int delta) {
+    if (!IsOpen(state.status)) {
+        return;
+    }
+    openTotal_ += delta;
+    if (state.categoryId != 0) {
+        openByCategory_[state.categoryId] += delta;
+    }
+}
+
+bool DueDateRiskEstimator::IsOpen(Enums::TaskStatus status) {
+    return status != Enums::TaskStatus::COMPLETED && status != Enums::TaskStatus::CANCELLED;
+}
+
+double DueDateRiskEstimator::StdDev(const Ewma& ewma) {
+    // Floor keeps the model from becoming a step function after few samples
+    return std::max({std::sqrt(ewma.variance), 0.25 * ewma.mean, 1.0});
+}
+
+double DueDateRiskEstimator::Risk(double allowedHours, double elapsedHours, double mean, double stdDev) {
+    double remaining = Survival(allowedHours, mean, stdDev);
+    double survived = Survival(std::max(elapsedHours, 0.0), mean, stdDev);
+    if (survived <= 1e-12) {
+        return 1.0; // Already far beyond the usual lead time
+    }
+    return std::clamp(remaining / survived, 0.0, 1.0);
+}
@@ -0,0 +1,103 @@
+#ifndef _DUEDATERISKESTIMATOR_H_
+#define _DUEDATERISKESTIMATOR_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../BLL/TaskTable.h"
+#include "../DTO/ProductivityReport.h"
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct RiskScore {
+    int taskId = 0;
+    double risk = 0.0;
+};
+
+// Streaming per-category estimates of completion lead time (EWMA mean and
+// variance) and throughput (exponentially decayed completions per day),
+// updated in O(1) per completion. The overdue risk of an open task is the
+// chance its lead time exceeds the time allowed by its due date, given the
+// time already spent: S(allowed) / S(elapsed) with a normal lead-time model.
+// Throughput bounds the expected lead time from below: at the current rate
+// an open task waits for half its category's open backlog (as followed
+// through the observer) to be worked off. Tasks already past due score 1,
+// as in ProductivityStats::overdueTasks.
+class DueDateRiskEstimator : public ITaskObserver {
+public:
+    struct Estimate {
+        double leadTimeHours = 0.0;
+        double leadTimeStdDevHours = 0.0;
+        double throughputPerDay = 0.0; // Decayed to the query time
+        int openTasks = 0;             // Backlog the throughput has to clear
+        int samples = 0;      // Observed completions
+        bool seeded = false;  // Started from a report
+    };
+
+    explicit DueDateRiskEstimator(double alpha = 0.1,
+                                  std::chrono::hours throughputWindow = std::chrono::hours(24 * 7));
+
+    // ITaskObserver: completions feed the estimates
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    void ObserveCompletion(int categoryId,
+                           const std::chrono::system_clock::time_point& createdAt,
+                           const std::chrono::system_clock::time_point& completedAt);
+    // Starting point from a report's average completion times, with a
+    // standard deviation equal to the mean. Completions observed later
+    // update it like earlier history would.
+    void Seed(const ProductivityReport& report);
+
+    // Category estimate, or the overall one while the category is neither
+    // seeded nor has MIN_SAMPLES completions
+    Estimate GetEstimate(int categoryId, const std::chrono::system_clock::time_point& asOf) const;
+    Estimate GetEstimate(int categoryId) const; // Clock time
+
+    double ScoreTask(const Task& task, const std::chrono::system_clock::time_point& asOf) const;
+    // One score per table row (0 for completed/cancelled rows)
+    std::vector<double> ScoreAll(const TaskTable& table, const std::chrono::system_clock::time_point& asOf) const;
+    // Rows with risk >= threshold, highest first
+    std::vector<RiskScore> GetAtRisk(const TaskTable& table, const std::chrono::system_clock::time_point& asOf,
+                                     double threshold) const;
+
+    static constexpr int MIN_SAMPLES = 3;
+
+private:
+    struct Ewma {
+        double mean = 0.0;
+        double variance = 0.0;
+        int samples = 0;
+        bool seeded = false;
+        double rate = 0.0;          // Completions per day
+        int64_t lastEventSeconds = 0;
+
+        bool HasData() const;
+        void Observe(double leadHours, int64_t eventSeconds, double alpha, double windowDays);
+    };
+
+    struct TaskState {
+        Enums::TaskStatus status;
+        int categoryId;
+    };
+
+    double alpha_;
+    double windowDays_;
+    Ewma overall_;
+    std::unordered_map<int, Ewma> byCategory_;
+    std::unordered_map<int, TaskState> lastState_; // key: task ID
+    std::unordered_map<int, int> openByCategory_;
+    int openTotal_ = 0;
+
+    const Ewma& Select(int categoryId) const;
+    int OpenTasks(int categoryId, const Ewma& ewma) const; // In the scope of the selected estimate
+    double RateAt(const Ewma& ewma, const std::chrono::system_clock::time_point& asOf) const;
+    double QueueHours(int categoryId, const Ewma& ewma, const std::chrono::system_clock::time_point& asOf) const;
+    void CountOpen(const TaskState& state, int delta);
+    static bool IsOpen(Enums::TaskStatus status);
+    static double StdDev(const Ewma& ewma);
+    static double Risk(double allowedHours, double elapsedHours, double mean, double stdDev);
+};
+
+#endif // _DUEDATERISKESTIMATOR_H_
@@ -0,0 +1,289 @@
+#include "DuplicateDetector.h"
+#include "../LIB/HashUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+    // One seed per MinHash function
+    const std::array<uint64_t, DuplicateDetector::SIGNATURE_SIZE>& Seeds() {
+        static const auto seeds = [] {
+            std::array<uint64_t, DuplicateDetector::SIGNATURE_SIZE> values{};
+            for (size_t i = 0; i < values.size(); ++i) {
+                values[i] = HashUtils::Mix(0x9E3779B97F4A7C15ULL * (i + 1));
+            }
+            return values;
+        }();
+        return seeds;
+    }
+
+    // Lowercase words separated by single spaces
+    void AppendNormalized(const std::string& text, std::string& out) {
+        for (char ch : text) {
+            unsigned char byte = static_cast<unsigned char>(ch);
+            if (std::isalnum(byte) || byte >= 0x80) {
+                out += static_cast<char>(std::tolower(byte));
+            } else if (!out.empty() && out.back() != ' ') {
+                out += ' ';
+            }
+        }
+        if (!out.empty() && out.back() != ' ') {
+            out += ' ';
+        }
+    }
+
+    // Union-find over dense indices
+    size_t Find(std::vector<size_t>& parent, size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+}
+
+// ITaskObserver
+void DuplicateDetector::OnTaskAdded(const TaskPtr& task) {
+    // Status and other non-text changes cost one hash, not a MinHash
+    uint64_t textHash = TextHash(*task);
+    auto [it, inserted] = textHashes_.try_emplace(task->GetId(), textHash);
+    if (!inserted) {
+        if (it->second == textHash) {
+            return;
+        }
+        it->second = textHash;
+    }
+    
+    Erase(task->GetId());
+    Signature signature;
+    if (ComputeSignature(*task, signature)) {
+        Insert(task->GetId(), signature);
+    }
+}
+
+void DuplicateDetector::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void DuplicateDetector::OnTaskRemoved(const TaskPtr& task) {
+    Erase(task->GetId());
+    textHashes_.erase(task->GetId());
+}
+
+void DuplicateDetector::Build(const std::vector<TaskPtr>& tasks, unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (tasks.size() < PARALLEL_THRESHOLD) {
+        threadCount = 1;
+    }
+    
+    std::vector<Signature> signatures(tasks.size());
+    std::vector<char> hasText(tasks.size());
+    auto compute = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            hasText[i] = ComputeSignature(*tasks[i], signatures[i]);
+        }
+    };
+    if (threadCount == 1) {
+        compute(0, tasks.size());
+    } else {
+        std::vector<std::thread> workers;
+        size_t chunk = (tasks.size() + threadCount - 1) / threadCount;
+        for (unsigned i = 0; i < threadCount; ++i) {
+            size_t begin = std::min(tasks.size(), i * chunk);
+            size_t end = std::min(tasks.size(), begin + chunk);
+            workers.emplace_back(compute, begin, end);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    signatures_.clear();
+    textHashes_.clear();
+    buckets_.clear();
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        textHashes_[tasks[i]->GetId()] = TextHash(*tasks[i]);
+        if (hasText[i]) {
+            Erase(tasks[i]->GetId());
+            Insert(tasks[i]->GetId(), signatures[i]);
+        }
+    }
+}
+
+// Queries
+std::vector<SimilarTask> DuplicateDetector::FindSimilar(const Task& task, double threshold, size_t limit) const {
+    std::vector<SimilarTask> result;
+    Signature signature;
+    if (!ComputeSignature(task, signature)) {
+        return result;
+    }
+    
+    std::unordered_set<int> seen;
+    for (size_t band = 0; band < BANDS; ++band) {
+        auto it = buckets_.find(BandKey(signature, band));
+        if (it == buckets_.end()) {
+            continue;
+        }
+        for (int candidate : it->second) {
+            if (candidate == task.GetId() || !seen.insert(candidate).second) {
+                continue;
+            }
+            double similarity = Similarity(signature, signatures_.at(candidate));
+            if (similarity >= threshold) {
+                result.push_back(SimilarTask{candidate, similarity});
+            }
+        }
+    }
+    
+    std::sort(result.begin(), result.end(), [](const SimilarTask& lhs, const SimilarTask& rhs) {
+        return lhs.similarity != rhs.similarity ? lhs.similarity > rhs.similarity : lhs.taskId < rhs.taskId;
+    });
+    if (result.size() > limit) {
+        result.resize(limit);
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> DuplicateDetector::FindDuplicates(double threshold) const {
+    std::vector<int> ids;
+    std::unordered_map<int, size_t> indexById;
+    for (const auto& [taskId, signature] : signatures_) {
+        indexById.emplace(taskId, ids.size());
+        ids.push_back(taskId);
+    }
+    std::vector<size_t> parent(ids.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    
+    auto unite = [&](int lhs, int rhs) {
+        size_t a = Find(parent, indexById[lhs]);
+        parent[a] = Find(parent, indexById[rhs]);
+    };
+    
+    for (const auto& [key, members] : buckets_) {
+        if (members.size() <= PAIRWISE_BUCKET_MAX) {
+            // Every pair, skipping those already joined through another pair
+            for (size_t i = 0; i < members.size(); ++i) {
+                const Signature& signature = signatures_.at(members[i]);
+                for (size_t j = i + 1; j < members.size(); ++j) {
+                    if (Find(parent, indexById[members[i]]) != Find(parent, indexById[members[j]]) &&
+                        Similarity(signature, signatures_.at(members[j])) >= threshold) {
+                        unite(members[i], members[j]);
+                    }
+                }
+            }
+            continue;
+        }
+        
+        // Large buckets check each member against the cluster leaders only,
+        // so a bucket of n copies costs O(n), not O(n^2)
+        std::vector<int> leaders;
+        for (int member : members) {
+            const Signature& signature = signatures_.at(member);
+            bool joined = false;
+            for (int leader : leaders) {
+                if (Similarity(signature, signatures_.at(leader)) >= threshold) {
+                    unite(member, leader);
+                    joined = true;
+                    break;
+                }
+            }
+            if (!joined) {
+                leaders.push_back(member);
+            }
+        }
+    }
+    
+    std::unordered_map<size_t, std::vector<int>> groups;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        groups[Find(parent, i)].push_back(ids[i]);
+    }
+    std::vector<std::vector<int>> clusters;
+    for (auto& [root, members] : groups) {
+        if (members.size() > 1) {
+            std::sort(members.begin(), members.end());
+            clusters.push_back(std::move(members));
+        }
+    }
+    std::sort(clusters.begin(), clusters.end(), [](const std::vector<int>& lhs, const std::vector<int>& rhs) {
+        return lhs.size() != rhs.size() ? lhs.size() > rhs.size() : lhs.front() < rhs.front();
+    });
+    return clusters;
+}
+
+size_t DuplicateDetector::Size() const {
+    return signatures_.size();
+}
+
+bool DuplicateDetector::ComputeSignature(const Task& task, Signature& signature) {
+    std::string text;
+    AppendNormalized(task.GetTitle(), text);
+    AppendNormalized(task.GetDescription(), text);
+    if (text.empty()) {
+        return false;
+    }
+    
+    signature.fill(UINT32_MAX);
+    const auto& seeds = Seeds();
+    size_t shingles = text.size() >= SHINGLE_SIZE ? text.size() - SHINGLE_SIZE + 1 : 1;
+    for (size_t i = 0; i < shingles; ++i) {
+        uint64_t shingle = HashUtils::Fnv1a(std::string_view(text).substr(i, SHINGLE_SIZE));
+        for (size_t h = 0; h < SIGNATURE_SIZE; ++h) {
+            uint32_t value = static_cast<uint32_t>(HashUtils::Mix(shingle ^ seeds[h]));
+            signature[h] = std::min(signature[h], value);
+        }
+    }
+    return true;
+}
+
+double DuplicateDetector::Similarity(const Signature& lhs, const Signature& rhs) {
+    size_t equal = 0;
+    for (size_t i = 0; i < SIGNATURE_SIZE; ++i) {
+        equal += lhs[i] == rhs[i] ? 1 : 0;
+    }
+    return static_cast<double>(equal) / SIGNATURE_SIZE;
+}
+
+// Maintenance
+void DuplicateDetector::Insert(int taskId, const Signature& signature) {
+    signatures_[taskId] = signature;
+    for (size_t band = 0; band < BANDS; ++band) {
+        buckets_[BandKey(signature, band)].push_back(taskId);
+    }
+}
+
+void DuplicateDetector::Erase(int taskId) {
+    auto it = signatures_.find(taskId);
+    if (it == signatures_.end()) {
+        return;
+    }
+    for (size_t band = 0; band < BANDS; ++band) {
+        auto bucket = buckets_.find(BandKey(it->second, band));
+        if (bucket == buckets_.end()) {
+            continue;
+        }
+        auto& members = bucket->second;
+        members.erase(std::remove(members.begin(), members.end(), taskId), members.end());
+        if (members.empty()) {
+            buckets_.erase(bucket);
+        }
+    }
+    signatures_.erase(it);
+}
+
+uint64_t DuplicateDetector::BandKey(const Signature& signature, size_t band) {
+    uint64_t key = HashUtils::Mix(band + 1);
+    for (size_t row = 0; row < ROWS; ++row) {
+        key = HashUtils::Mix(key ^ signature[band * ROWS + row]);
+    }
+    return key;
+}
+
+uint64_t DuplicateDetector::TextHash(const Task& task) {
+    // Mixing between the fields keeps "ab" + "c" apart from "a" + "bc"
+    return HashUtils::Fnv1a(task.GetDescription(), HashUtils::Mix(HashUtils::Fnv1a(task.GetTitle())));
+}
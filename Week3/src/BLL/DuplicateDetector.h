@@ -0,0 +1,71 @@
+#ifndef _DUPLICATEDETECTOR_H_
+#define _DUPLICATEDETECTOR_H_
+
+#include "../BLL/ITaskObserver.h"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct SimilarTask {
+    int taskId = 0;
+    double similarity = 0.0; // Estimated Jaccard similarity of the shingle sets
+};
+
+// Near-duplicate detection with MinHash signatures over character shingles
+// of the normalized title and description. Signatures are split into BANDS
+// bands of ROWS values; tasks sharing any band land in the same LSH bucket
+// and only those pairs are compared, so candidate generation is roughly
+// linear. With 16 x 4 the chance of becoming candidates, 1 - (1 - s^4)^16,
+// is about 64% at similarity 0.5 and above 99% at 0.8. Updates that leave
+// the text unchanged are detected by a text hash and skip the MinHash.
+class DuplicateDetector : public ITaskObserver {
+public:
+    static constexpr size_t SIGNATURE_SIZE = 64;
+    static constexpr size_t BANDS = 16;
+    static constexpr size_t ROWS = SIGNATURE_SIZE / BANDS;
+    static constexpr size_t SHINGLE_SIZE = 4;
+    static constexpr double DEFAULT_THRESHOLD = 0.7;
+    static constexpr size_t PARALLEL_THRESHOLD = 50000;
+    static constexpr size_t PAIRWISE_BUCKET_MAX = 64;
+
+    using Signature = std::array<uint32_t, SIGNATURE_SIZE>;
+
+    DuplicateDetector() = default;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    // Replaces the contents; signatures are computed on threadCount threads
+    // (0 = hardware count) for large inputs
+    void Build(const std::vector<TaskPtr>& tasks, unsigned threadCount = 0);
+
+    // Indexed tasks similar to this one (itself excluded), most similar first;
+    // usable before inserting a new task
+    std::vector<SimilarTask> FindSimilar(const Task& task, double threshold = DEFAULT_THRESHOLD,
+                                         size_t limit = 10) const;
+    // Groups of two or more task IDs whose similarity reaches the threshold
+    // (transitively), each sorted, largest group first. Buckets of up to
+    // PAIRWISE_BUCKET_MAX tasks compare every pair; larger ones compare each
+    // task with the bucket's cluster leaders only and may split a group whose
+    // links run through non-leaders.
+    std::vector<std::vector<int>> FindDuplicates(double threshold = DEFAULT_THRESHOLD) const;
+
+    size_t Size() const;
+    static bool ComputeSignature(const Task& task, Signature& signature); // False for empty text
+    static double Similarity(const Signature& lhs, const Signature& rhs);
+
+private:
+    std::unordered_map<int, Signature> signatures_;              // key: task ID
+    std::unordered_map<int, uint64_t> textHashes_;               // key: task ID, raw title + description
+    std::unordered_map<uint64_t, std::vector<int>> buckets_;     // key: band hash
+
+    void Insert(int taskId, const Signature& signature);
+    void Erase(int taskId);
+    static uint64_t BandKey(const Signature& signature, size_t band);
+    static uint64_t TextHash(const Task& task);
+};
+
+#endif // _DUPLICATEDETECTOR_H_
@@ -0,0 +1,167 @@
+#include "FuzzySearchIndex.h"
+#include "../LIB/FuzzyMatcher.h"
+#include "../LIB/StringUtils.h"
+#include <algorithm>
+
+// ITaskObserver
+void FuzzySearchIndex::OnTaskAdded(const TaskPtr& task) {
+    std::vector<std::string> fields;
+    fields.push_back(StringUtils::ToLower(task->GetTitle()));
+    for (const auto& tag : task->GetTags()) {
+        fields.push_back(StringUtils::ToLower(tag));
+    }
+    
+    uint32_t ordinal;
+    auto it = ordinalByTask_.find(task->GetId());
+    if (it != ordinalByTask_.end()) {
+        ordinal = it->second;
+        if (documents_[ordinal].fields == fields) {
+            return;
+        }
+        Index(ordinal, false);
+    } else if (!freeOrdinals_.empty()) {
+        ordinal = freeOrdinals_.back();
+        freeOrdinals_.pop_back();
+        ordinalByTask_.emplace(task->GetId(), ordinal);
+    } else {
+        ordinal = static_cast<uint32_t>(documents_.size());
+        documents_.emplace_back();
+        ordinalByTask_.emplace(task->GetId(), ordinal);
+    }
+    
+    Document document;
+    document.taskId = task->GetId();
+    for (const auto& field : fields) {
+        for (size_t i = 0; i + Q <= field.size(); ++i) {
+            document.grams.push_back(Gram(field.data() + i));
+        }
+    }
+    std::sort(document.grams.begin(), document.grams.end());
+    document.grams.erase(std::unique(document.grams.begin(), document.grams.end()), document.grams.end());
+    document.fields = std::move(fields);
+    
+    documents_[ordinal] = std::move(document);
+    Index(ordinal, true);
+}
+
+void FuzzySearchIndex::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void FuzzySearchIndex::OnTaskRemoved(const TaskPtr& task) {
+    auto it = ordinalByTask_.find(task->GetId());
+    if (it == ordinalByTask_.end()) {
+        return;
+    }
+    Index(it->second, false);
+    documents_[it->second] = Document();
+    freeOrdinals_.push_back(it->second);
+    ordinalByTask_.erase(it);
+}
+
+size_t FuzzySearchIndex::Size() const {
+    return ordinalByTask_.size();
+}
+
+// Queries
+std::vector<FuzzyHit> FuzzySearchIndex::Search(const std::string& pattern, int maxErrors, size_t limit) const {
+    std::vector<FuzzyHit> hits;
+    if (pattern.empty() || maxErrors < 0) {
+        return hits;
+    }
+    
+    FuzzyMatcher matcher(pattern);
+    for (uint32_t ordinal : Candidates(pattern, maxErrors)) {
+        const Document& document = documents_[ordinal];
+        FuzzyHit hit{document.taskId, -1, ""};
+        for (const auto& field : document.fields) {
+            int distance = matcher.Distance(field, hit.distance < 0 ? maxErrors : hit.distance - 1);
+            if (distance >= 0) {
+                hit.distance = distance;
+                hit.match = field;
+            }
+        }
+        if (hit.distance >= 0) {
+            hits.push_back(std::move(hit));
+        }
+    }
+    
+    auto better = [](const FuzzyHit& lhs, const FuzzyHit& rhs) {
+        return lhs.distance != rhs.distance ? lhs.distance < rhs.distance : lhs.taskId < rhs.taskId;
+    };
+    size_t count = std::min(limit, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + count, hits.end(), better);
+    hits.resize(count);
+    return hits;
+}
+
+size_t FuzzySearchIndex::CountCandidates(const std::string& pattern, int maxErrors) const {
+    return Candidates(pattern, maxErrors).size();
+}
+
+std::vector<uint32_t> FuzzySearchIndex::Candidates(const std::string& pattern, int maxErrors) const {
+    std::vector<uint32_t> candidates;
+    std::string folded = StringUtils::ToLower(pattern);
+    size_t pieces = static_cast<size_t>(maxErrors) + 1;
+    
+    if (folded.size() < pieces * Q) {
+        for (const auto& [taskId, ordinal] : ordinalByTask_) {
+            candidates.push_back(ordinal);
+        }
+        std::sort(candidates.begin(), candidates.end());
+        return candidates;
+    }
+    
+    // Union over pieces of the documents holding all of the piece's grams,
+    // intersecting the rarest posting lists first
+    RoaringBitmap matches;
+    std::vector<const RoaringBitmap*> postings;
+    for (size_t piece = 0; piece < pieces; ++piece) {
+        size_t begin = piece * folded.size() / pieces;
+        size_t end = (piece + 1) * folded.size() / pieces;
+        postings.clear();
+        for (size_t i = begin; i + Q <= end; ++i) {
+            auto it = grams_.find(Gram(folded.data() + i));
+            if (it == grams_.end()) {
+                postings.clear();
+                break;
+            }
+            postings.push_back(&it->second);
+        }
+        if (postings.empty()) {
+            continue;
+        }
+        std::sort(postings.begin(), postings.end(), [](const RoaringBitmap* lhs, const RoaringBitmap* rhs) {
+            return lhs->Cardinality() < rhs->Cardinality();
+        });
+        
+        RoaringBitmap holders = *postings.front();
+        for (size_t i = 1; i < postings.size() && !holders.Empty(); ++i) {
+            holders &= *postings[i];
+        }
+        matches |= holders;
+    }
+    matches.ForEach([&candidates](uint32_t ordinal) { candidates.push_back(ordinal); });
+    return candidates;
+}
+
+// Maintenance
+void FuzzySearchIndex::Index(uint32_t ordinal, bool add) {
+    for (uint32_t gram : documents_[ordinal].grams) {
+        if (add) {
+            grams_[gram].Add(ordinal);
+        } else {
+            auto it = grams_.find(gram);
+            it->second.Remove(ordinal);
+            if (it->second.Empty()) {
+                grams_.erase(it);
+            }
+        }
+    }
+}
+
+uint32_t FuzzySearchIndex::Gram(const char* text) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+}
@@ -0,0 +1,58 @@
+#ifndef _FUZZYSEARCHINDEX_H_
+#define _FUZZYSEARCHINDEX_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../LIB/RoaringBitmap.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct FuzzyHit {
+    int taskId = 0;
+    int distance = 0;
+    std::string match; // Title or tag that matched best
+};
+
+// Typo-tolerant search over task titles and tags. By the pigeonhole
+// principle, a pattern found with at most k errors contains one of its k + 1
+// disjoint pieces exactly, so only tasks holding every Q-gram of some piece
+// are verified with FuzzyMatcher. Trigrams keep the posting lists selective
+// where common bigrams would match most tasks. Patterns shorter than
+// (k + 1) * Q cannot be split that way and every task is verified.
+class FuzzySearchIndex : public ITaskObserver {
+public:
+    FuzzySearchIndex() = default;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    size_t Size() const;
+
+    // Tasks matching within maxErrors edits, by distance then task ID
+    std::vector<FuzzyHit> Search(const std::string& pattern, int maxErrors, size_t limit = 20) const;
+    // Candidates the q-gram filter would pass on to verification
+    size_t CountCandidates(const std::string& pattern, int maxErrors) const;
+
+    static constexpr size_t Q = 3;
+
+private:
+    struct Document {
+        int taskId = 0;
+        std::vector<std::string> fields; // Case-folded title and tags
+        std::vector<uint32_t> grams;     // Distinct
+    };
+
+    std::unordered_map<uint32_t, RoaringBitmap> grams_;
+    std::vector<Document> documents_; // key: ordinal
+    std::unordered_map<int, uint32_t> ordinalByTask_;
+    std::vector<uint32_t> freeOrdinals_;
+
+    std::vector<uint32_t> Candidates(const std::string& pattern, int maxErrors) const;
+    void Index(uint32_t ordinal, bool add);
+    static uint32_t Gram(const char* text);
+};
+
+#endif // _FUZZYSEARCHINDEX_H_
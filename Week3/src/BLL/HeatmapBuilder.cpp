@@ -0,0 +1,156 @@
+#include "HeatmapBuilder.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include <unordered_map>
+
+using namespace std::chrono;
+
+namespace {
+    constexpr int64_t SECONDS_PER_DAY = 86400;
+    constexpr int64_t THURSDAY = 4; // 1970-01-01
+
+    int64_t ToSeconds(const system_clock::time_point& time) {
+        if (time == system_clock::time_point::min()) return INT64_MIN;
+        if (time == system_clock::time_point::max()) return INT64_MAX;
+        return floor<seconds>(time.time_since_epoch()).count();
+    }
+}
+
+void HeatmapBuilder::Result::Merge(const Result& other) {
+    overall.Merge(other.overall);
+    for (const auto& [categoryId, heatmap] : other.byCategory) {
+        byCategory[categoryId].Merge(heatmap);
+    }
+}
+
+HeatmapBuilder::Result HeatmapBuilder::Build(const std::vector<TaskPtr>& tasks,
+                                             const system_clock::time_point& startDate,
+                                             const system_clock::time_point& endDate,
+                                             unsigned threadCount,
+                                             const UtcOffsetTable& offsets) {
+    int64_t startSeconds = ToSeconds(startDate);
+    int64_t endSeconds = ToSeconds(endDate);
+    
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (tasks.size() < PARALLEL_THRESHOLD) {
+        threadCount = 1;
+    }
+    
+    std::vector<Result> results(threadCount);
+    if (threadCount == 1) {
+        Accumulate(tasks, 0, tasks.size(), startSeconds, endSeconds, offsets, results[0]);
+    } else {
+        std::vector<std::thread> workers;
+        size_t chunk = (tasks.size() + threadCount - 1) / threadCount;
+        for (unsigned i = 0; i < threadCount; ++i) {
+            size_t begin = std::min(tasks.size(), i * chunk);
+            size_t end = std::min(tasks.size(), begin + chunk);
+            workers.emplace_back(Accumulate, std::cref(tasks), begin, end,
+                                 startSeconds, endSeconds, std::cref(offsets), std::ref(results[i]));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (unsigned i = 1; i < threadCount; ++i) {
+            results[0].Merge(results[i]);
+        }
+    }
+    return std::move(results[0]);
+}
+
+void HeatmapBuilder::ToCells(const int64_t* utcSeconds, size_t count,
+                             const UtcOffsetTable& offsets, uint8_t* cells) {
+    // Offsets: completions cluster in time, so the last segment usually matches
+    int64_t local[BATCH_SIZE];
+    size_t segment = offsets.FindSegment(count > 0 ? utcSeconds[0] : 0);
+    for (size_t done = 0; done < count; done += BATCH_SIZE) {
+        size_t n = std::min(BATCH_SIZE, count - done);
+        const int64_t* utc = utcSeconds + done;
+        
+        for (size_t i = 0; i < n; ++i) {
+            if (utc[i] < offsets.GetSegmentStart(segment) || utc[i] >= offsets.GetSegmentEnd(segment)) {
+                segment = offsets.FindSegment(utc[i]);
+            }
+            local[i] = utc[i] + offsets.GetSegmentOffset(segment);
+        }
+        
+        // Branch-free cell arithmetic over the batch (vectorizable)
+        uint8_t* out = cells + done;
+        for (size_t i = 0; i < n; ++i) {
+            int64_t t = local[i];
+            int64_t day = (t - (t < 0) * (SECONDS_PER_DAY - 1)) / SECONDS_PER_DAY;
+            int64_t weekday = (day % 7 + 7 + THURSDAY) % 7;
+            int64_t hour = (t - day * SECONDS_PER_DAY) / 3600;
+            out[i] = static_cast<uint8_t>(weekday * CompletionHeatmap::HOURS + hour);
+        }
+    }
+}
+
+void HeatmapBuilder::Accumulate(const std::vector<TaskPtr>& tasks, size_t begin, size_t end,
+                                int64_t startSeconds, int64_t endSeconds,
+                                const UtcOffsetTable& offsets, Result& result) {
+    int64_t times[BATCH_SIZE];
+    int categoryIds[BATCH_SIZE];
+    uint8_t cells[BATCH_SIZE];
+    
+    // Per-category tallies in flat arrays until the end of the chunk
+    std::unordered_map<int, std::array<int, CompletionHeatmap::CELLS>> byCategory;
+    auto& overall = result.overall.GetCells();
+    
+    auto flush = [&](size_t n) {
+        ToCells(times, n, offsets, cells);
+        
+        // Four interleaved tallies avoid a store-to-load chain on hot cells
+        std::array<std::array<int, CompletionHeatmap::CELLS>, 4> partial{};
+        for (size_t i = 0; i < n; ++i) {
+            ++partial[i & 3][cells[i]];
+        }
+        for (int c = 0; c < CompletionHeatmap::CELLS; ++c) {
+            overall[c] += partial[0][c] + partial[1][c] + partial[2][c] + partial[3][c];
+        }
+        
+        int lastCategoryId = 0;
+        std::array<int, CompletionHeatmap::CELLS>* lastCategory = nullptr;
+        for (size_t i = 0; i < n; ++i) {
+            if (categoryIds[i] == 0) {
+                continue;
+            }
+            if (!lastCategory || categoryIds[i] != lastCategoryId) {
+                lastCategoryId = categoryIds[i];
+                lastCategory = &byCategory[lastCategoryId];
+            }
+            ++(*lastCategory)[cells[i]];
+        }
+    };
+    
+    size_t n = 0;
+    for (size_t i = begin; i < end; ++i) {
+        const Task& task = *tasks[i];
+        if (task.GetStatus() != Enums::TaskStatus::COMPLETED ||
+            task.GetCompletedAt() == system_clock::time_point::min()) {
+            continue;
+        }
+        int64_t completed = ToSeconds(task.GetCompletedAt());
+        if (completed < startSeconds || completed >= endSeconds) {
+            continue;
+        }
+        
+        times[n] = completed;
+        categoryIds[n] = task.GetCategoryId();
+        if (++n == BATCH_SIZE) {
+            flush(n);
+            n = 0;
+        }
+    }
+    flush(n);
+    
+    for (auto& [categoryId, cellCounts] : byCategory) {
+        auto& target = result.byCategory[categoryId].GetCells();
+        for (int c = 0; c < CompletionHeatmap::CELLS; ++c) {
+            target[c] += cellCounts[c];
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef _HEATMAPBUILDER_H_
+#define _HEATMAPBUILDER_H_
+
+#include "../DTO/CompletionHeatmap.h"
+#include "../DTO/Task.h"
+#include "../LIB/UtcOffsetTable.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Weekday x hour completion heatmaps, overall and per category. Completion
+// times are gathered in batches, converted to local cells with a
+// precomputed offset table (no localtime calls) and tallied in bulk.
+class HeatmapBuilder {
+public:
+    struct Result {
+        CompletionHeatmap overall;
+        std::map<int, CompletionHeatmap> byCategory; // key: category ID
+
+        void Merge(const Result& other);
+    };
+
+    // Completed tasks with completedAt in [startDate, endDate).
+    // threadCount = 0 picks the hardware count.
+    static Result Build(const std::vector<TaskPtr>& tasks,
+                        const std::chrono::system_clock::time_point& startDate,
+                        const std::chrono::system_clock::time_point& endDate,
+                        unsigned threadCount = 0,
+                        const UtcOffsetTable& offsets = UtcOffsetTable::Local());
+
+    // Converts count UTC timestamps (seconds) to heatmap cell indexes
+    static void ToCells(const int64_t* utcSeconds, size_t count,
+                        const UtcOffsetTable& offsets, uint8_t* cells);
+
+    static constexpr size_t BATCH_SIZE = 1024;
+    static constexpr size_t PARALLEL_THRESHOLD = 50000;
+
+private:
+    static void Accumulate(const std::vector<TaskPtr>& tasks, size_t begin, size_t end,
+                           int64_t startSeconds, int64_t endSeconds,
+                           const UtcOffsetTable& offsets, Result& result);
+};
+
+#endif // _HEATMAPBUILDER_H_
@@ -0,0 +1,60 @@
+#include "HyperLogLog.h"
+#include "../LIB/HashUtils.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+HyperLogLog::HyperLogLog(int precision)
+    : precision_(precision) {
+    
+    if (precision < 4 || precision > 18) {
+        throw std::invalid_argument("HyperLogLog precision must be between 4 and 18");
+    }
+    registers_.assign(size_t{1} << precision, 0);
+}
+
+void HyperLogLog::Add(std::string_view value) {
+    // FNV-1a alone leaves the high bits poorly mixed for short strings
+    AddHash(HashUtils::Mix(HashUtils::Fnv1a(value)));
+}
+
+void HyperLogLog::AddHash(uint64_t hash) {
+    size_t index = static_cast<size_t>(hash >> (64 - precision_));
+    // Rank of the first set bit in the remaining bits (sentinel bit bounds it)
+    uint64_t rest = (hash << precision_) | (uint64_t{1} << (precision_ - 1));
+    uint8_t rank = static_cast<uint8_t>(std::countl_zero(rest) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+    if (other.precision_ != precision_) {
+        throw std::invalid_argument("Cannot merge HyperLogLog sketches of different precision");
+    }
+    for (size_t i = 0; i < registers_.size(); ++i) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+double HyperLogLog::Estimate() const {
+    double m = static_cast<double>(registers_.size());
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (uint8_t reg : registers_) {
+        sum += std::ldexp(1.0, -static_cast<int>(reg));
+        zeros += reg == 0;
+    }
+    
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    
+    // Linear counting is more accurate for small cardinalities
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(m / static_cast<double>(zeros));
+    }
+    return estimate;
+}
+
+int HyperLogLog::GetPrecision() const {
+    return precision_;
+}
@@ -0,0 +1,27 @@
+#ifndef _HYPERLOGLOG_H_
+#define _HYPERLOGLOG_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Distinct-count estimator in 2^precision bytes (standard error about
+// 1.04 / sqrt(2^precision), ~1.6% at the default). Merging takes the
+// register-wise maximum, so per-thread sketches combine losslessly.
+class HyperLogLog {
+public:
+    explicit HyperLogLog(int precision = 12);
+
+    void Add(std::string_view value);
+    void AddHash(uint64_t hash);
+    void Merge(const HyperLogLog& other); // Throws std::invalid_argument on precision mismatch
+
+    double Estimate() const;
+    int GetPrecision() const;
+
+private:
+    int precision_;
+    std::vector<uint8_t> registers_;
+};
+
+#endif // _HYPERLOGLOG_H_
@@ -0,0 +1,17 @@
+#ifndef _ITASKOBSERVER_H_
+#define _ITASKOBSERVER_H_
+
+#include "../DTO/Task.h"
+
+// Notified by TaskService after every change to its collection.
+// OnTaskUpdated is called after the task has been modified; observers that
+// need the previous state keep their own per-task snapshot keyed by ID.
+class ITaskObserver {
+public:
+    virtual ~ITaskObserver() = default;
+    virtual void OnTaskAdded(const TaskPtr& task) = 0;
+    virtual void OnTaskUpdated(const TaskPtr& task) = 0;
+    virtual void OnTaskRemoved(const TaskPtr& task) = 0;
+};
+
+#endif // _ITASKOBSERVER_H_
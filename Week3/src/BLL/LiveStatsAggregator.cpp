@@ -0,0 +1,135 @@
+#include "LiveStatsAggregator.h"
+#include <cmath>
+
+LiveStatsAggregator::LiveStatsAggregator(const Clock& clock)
+    : clock_(clock) {
+}
+
+// ITaskObserver
+void LiveStatsAggregator::OnTaskAdded(const TaskPtr& task) {
+    auto contribution = MakeContribution(*task);
+    
+    auto it = contributions_.find(task->GetId());
+    if (it != contributions_.end()) {
+        Apply(it->second, -1);
+        it->second = contribution;
+    } else {
+        contributions_.emplace(task->GetId(), contribution);
+    }
+    Apply(contribution, 1);
+}
+
+void LiveStatsAggregator::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void LiveStatsAggregator::OnTaskRemoved(const TaskPtr& task) {
+    auto it = contributions_.find(task->GetId());
+    if (it == contributions_.end()) {
+        return;
+    }
+    Apply(it->second, -1);
+    contributions_.erase(it);
+}
+
+// Current stats
+ProductivityStats LiveStatsAggregator::GetOverallStats() const {
+    return overall_.ToStats();
+}
+
+ProductivityStats LiveStatsAggregator::GetCategoryStats(int categoryId) const {
+    auto it = byCategory_.find(categoryId);
+    return it == byCategory_.end() ? ProductivityStats() : it->second.ToStats();
+}
+
+std::vector<int> LiveStatsAggregator::GetCategoryIds() const {
+    std::vector<int> ids;
+    for (const auto& [categoryId, accumulator] : byCategory_) {
+        if (accumulator.totalTasks > 0) {
+            ids.push_back(categoryId);
+        }
+    }
+    return ids;
+}
+
+void LiveStatsAggregator::Recompute(const std::vector<TaskPtr>& tasks) {
+    overall_ = StatsAccumulator();
+    byCategory_.clear();
+    contributions_.clear();
+    for (const auto& task : tasks) {
+        OnTaskAdded(task);
+    }
+}
+
+bool LiveStatsAggregator::Verify(const std::vector<TaskPtr>& tasks) const {
+    LiveStatsAggregator fresh;
+    for (const auto& task : tasks) {
+        // Re-use each task's recorded evaluation time so overdue counts compare like for like
+        auto contribution = MakeContribution(*task);
+        auto it = contributions_.find(task->GetId());
+        if (it != contributions_.end()) {
+            contribution.asOf = it->second.asOf;
+        }
+        fresh.contributions_.emplace(task->GetId(), contribution);
+        fresh.Apply(contribution, 1);
+    }
+    
+    if (!SameCounts(overall_, fresh.overall_)) {
+        return false;
+    }
+    
+    for (const auto& [categoryId, accumulator] : byCategory_) {
+        auto it = fresh.byCategory_.find(categoryId);
+        StatsAccumulator expected = it == fresh.byCategory_.end() ? StatsAccumulator() : it->second;
+        if (!SameCounts(accumulator, expected)) {
+            return false;
+        }
+    }
+    for (const auto& [categoryId, accumulator] : fresh.byCategory_) {
+        if (accumulator.totalTasks > 0 && !byCategory_.count(categoryId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LiveStatsAggregator::Apply(const Contribution& contribution, int sign) {
+    auto apply = [&](StatsAccumulator& accumulator) {
+        if (sign > 0) {
+            accumulator.Add(contribution.status, contribution.priority, contribution.dueDate,
+                            contribution.createdAt, contribution.completedAt, contribution.asOf);
+        } else {
+            accumulator.Remove(contribution.status, contribution.priority, contribution.dueDate,
+                               contribution.createdAt, contribution.completedAt, contribution.asOf);
+        }
+    };
+    
+    apply(overall_);
+    if (contribution.categoryId != 0) {
+        apply(byCategory_[contribution.categoryId]);
+    }
+}
+
+LiveStatsAggregator::Contribution LiveStatsAggregator::MakeContribution(const Task& task) const {
+    return Contribution{
+        task.GetStatus(),
+        task.GetPriority(),
+        task.GetCategoryId(),
+        task.GetDueDate(),
+        task.GetCreatedAt(),
+        task.GetCompletedAt(),
+        clock_.Now()
+    };
+}
+
+bool LiveStatsAggregator::SameCounts(const StatsAccumulator& lhs, const StatsAccumulator& rhs) {
+    return lhs.totalTasks == rhs.totalTasks &&
+           lhs.completedTasks == rhs.completedTasks &&
+           lhs.overdueTasks == rhs.overdueTasks &&
+           lhs.pendingTasks == rhs.pendingTasks &&
+           lhs.timedCompletions == rhs.timedCompletions &&
+           lhs.byPriority == rhs.byPriority &&
+           lhs.byStatus == rhs.byStatus &&
+           lhs.completionTimes == rhs.completionTimes &&
+           std::fabs(lhs.completionHoursSum - rhs.completionHoursSum) < 1e-6 * (1.0 + std::fabs(rhs.completionHoursSum));
+}
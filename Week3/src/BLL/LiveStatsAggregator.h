@@ -0,0 +1,58 @@
+#ifndef _LIVESTATSAGGREGATOR_H_
+#define _LIVESTATSAGGREGATOR_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../BLL/StatsAccumulator.h"
+#include "../DTO/ProductivityStats.h"
+#include "../LIB/Clock.h"
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+// Keeps overall and per-category stats up to date by applying O(1) deltas
+// on every task change. Overdue is evaluated when a task is added/updated,
+// so tasks that become overdue later are only picked up by Recompute().
+class LiveStatsAggregator : public ITaskObserver {
+public:
+    // The clock is kept by reference and must outlive the aggregator
+    explicit LiveStatsAggregator(const Clock& clock = Clock::GetInstance());
+    explicit LiveStatsAggregator(const Clock&& clock) = delete;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    // Current stats
+    ProductivityStats GetOverallStats() const;
+    ProductivityStats GetCategoryStats(int categoryId) const;
+    std::vector<int> GetCategoryIds() const;
+
+    // Full rebuild (also refreshes overdue counts as of now)
+    void Recompute(const std::vector<TaskPtr>& tasks);
+    // Compares the incremental state with a full recompute over the tasks
+    bool Verify(const std::vector<TaskPtr>& tasks) const;
+
+private:
+    // What a task last contributed, so it can be subtracted exactly
+    struct Contribution {
+        Enums::TaskStatus status;
+        Enums::Priority priority;
+        int categoryId;
+        std::chrono::system_clock::time_point dueDate;
+        std::chrono::system_clock::time_point createdAt;
+        std::chrono::system_clock::time_point completedAt;
+        std::chrono::system_clock::time_point asOf;
+    };
+
+    const Clock& clock_;
+    StatsAccumulator overall_;
+    std::unordered_map<int, StatsAccumulator> byCategory_;
+    std::unordered_map<int, Contribution> contributions_; // key: task ID
+
+    void Apply(const Contribution& contribution, int sign);
+    Contribution MakeContribution(const Task& task) const;
+    static bool SameCounts(const StatsAccumulator& lhs, const StatsAccumulator& rhs);
+};
+
+#endif // _LIVESTATSAGGREGATOR_H_
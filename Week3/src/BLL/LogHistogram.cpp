@@ -0,0 +1,101 @@
+#include "LogHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+void LogHistogram::Add(int64_t value, int64_t count) {
+    size_t index = BucketIndex(value);
+    if (index >= buckets_.size()) {
+        buckets_.resize(index + 1, 0);
+    }
+    buckets_[index] += count;
+    totalCount_ += count;
+}
+
+void LogHistogram::Remove(int64_t value, int64_t count) {
+    Add(value, -count);
+}
+
+void LogHistogram::Merge(const LogHistogram& other) {
+    if (other.buckets_.size() > buckets_.size()) {
+        buckets_.resize(other.buckets_.size(), 0);
+    }
+    for (size_t i = 0; i < other.buckets_.size(); ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    totalCount_ += other.totalCount_;
+}
+
+void LogHistogram::Clear() {
+    buckets_.clear();
+    totalCount_ = 0;
+}
+
+int64_t LogHistogram::GetTotalCount() const {
+    return totalCount_;
+}
+
+bool LogHistogram::IsEmpty() const {
+    return totalCount_ <= 0;
+}
+
+double LogHistogram::Quantile(double q) const {
+    if (IsEmpty()) {
+        return 0.0;
+    }
+    
+    q = std::clamp(q, 0.0, 1.0);
+    int64_t rank = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(q * static_cast<double>(totalCount_))));
+    int64_t seen = 0;
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return static_cast<double>(BucketLowerBound(i)) + (BucketWidth(i) - 1) / 2.0;
+        }
+    }
+    size_t last = buckets_.size() - 1;
+    return static_cast<double>(BucketLowerBound(last));
+}
+
+size_t LogHistogram::BucketIndex(int64_t value) {
+    if (value < 2 * SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(std::max<int64_t>(value, 0));
+    }
+    // value in [2^k, 2^(k+1)), k > SUB_BUCKET_BITS
+    int k = std::bit_width(static_cast<uint64_t>(value)) - 1;
+    int shift = k - SUB_BUCKET_BITS;
+    int64_t sub = value >> shift; // In [SUB_BUCKET_COUNT, 2 * SUB_BUCKET_COUNT)
+    return static_cast<size_t>(shift * SUB_BUCKET_COUNT + sub);
+}
+
+int64_t LogHistogram::BucketLowerBound(size_t index) {
+    if (index < static_cast<size_t>(2 * SUB_BUCKET_COUNT)) {
+        return static_cast<int64_t>(index);
+    }
+    int shift = static_cast<int>(index / SUB_BUCKET_COUNT) - 1;
+    int64_t sub = static_cast<int64_t>(index % SUB_BUCKET_COUNT) + SUB_BUCKET_COUNT;
+    return sub << shift;
+}
+
+int64_t LogHistogram::BucketWidth(size_t index) {
+    if (index < static_cast<size_t>(2 * SUB_BUCKET_COUNT)) {
+        return 1;
+    }
+    return 1LL << (static_cast<int>(index / SUB_BUCKET_COUNT) - 1);
+}
+
+bool LogHistogram::operator==(const LogHistogram& other) const {
+    if (totalCount_ != other.totalCount_) {
+        return false;
+    }
+    size_t common = std::min(buckets_.size(), other.buckets_.size());
+    for (size_t i = 0; i < common; ++i) {
+        if (buckets_[i] != other.buckets_[i]) {
+            return false;
+        }
+    }
+    // Trailing buckets may have been grown and emptied again
+    const auto& longer = buckets_.size() > common ? buckets_ : other.buckets_;
+    return std::all_of(longer.begin() + static_cast<std::ptrdiff_t>(common), longer.end(),
+                       [](int64_t count) { return count == 0; });
+}
@@ -0,0 +1,39 @@
+#ifndef _LOGHISTOGRAM_H_
+#define _LOGHISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// HDR-style histogram of non-negative integers: exact below 64, then 32
+// linear sub-buckets per power of two, so a bucket midpoint is within 1/64
+// (~1.6%) of every value in the bucket. Counts can be removed again and
+// histograms merge by adding buckets, so it fits per-thread, per-shard and
+// incremental accumulation.
+class LogHistogram {
+public:
+    void Add(int64_t value, int64_t count = 1);
+    void Remove(int64_t value, int64_t count = 1);
+    void Merge(const LogHistogram& other);
+    void Clear();
+
+    int64_t GetTotalCount() const;
+    bool IsEmpty() const;
+    // Value at quantile q in [0, 1] (bucket midpoint); 0 when empty
+    double Quantile(double q) const;
+
+    static size_t BucketIndex(int64_t value);
+    static int64_t BucketLowerBound(size_t index);
+    static int64_t BucketWidth(size_t index);
+
+    bool operator==(const LogHistogram& other) const;
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int64_t SUB_BUCKET_COUNT = 1LL << SUB_BUCKET_BITS;
+
+    std::vector<int64_t> buckets_; // Grown on demand
+    int64_t totalCount_ = 0;
+};
+
+#endif // _LOGHISTOGRAM_H_
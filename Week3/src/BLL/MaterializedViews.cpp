@@ -0,0 +1,312 @@
+#include "MaterializedViews.h"
+#include "../BLL/PageCursor.h"
+#include "../LIB/DateUtils.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+    constexpr system_clock::duration TICK(1);
+
+    const char* const DEFAULT_VIEWS[][2] = {
+        {"overdue", "status in (PENDING, IN_PROGRESS) and due < now order by due asc"},
+        {"today", "status in (PENDING, IN_PROGRESS) and due >= today and due < today+1d "
+                  "order by priority desc, due asc"},
+        {"upcoming", "status in (PENDING, IN_PROGRESS) and due >= today+1d and due < today+8d "
+                     "order by due asc"}
+    };
+
+    system_clock::time_point FieldTime(const Task& task, QueryField field) {
+        switch (field) {
+            case QueryField::CREATED: return task.GetCreatedAt();
+            case QueryField::COMPLETED: return task.GetCompletedAt();
+            default: return task.GetDueDate();
+        }
+    }
+}
+
+bool MaterializedViews::RowLess::operator()(const RowKey& lhs, const RowKey& rhs) const {
+    // Same ordering as TaskQuery::Compare
+    for (size_t i = 0; i < order->size(); ++i) {
+        int result;
+        if ((*order)[i].field == QueryField::TITLE) {
+            int compare = lhs.title.compare(rhs.title);
+            result = compare < 0 ? -1 : (compare > 0 ? 1 : 0);
+        } else {
+            result = lhs.values[i] < rhs.values[i] ? -1 : (lhs.values[i] > rhs.values[i] ? 1 : 0);
+        }
+        if (result != 0) {
+            return ((*order)[i].descending ? -result : result) < 0;
+        }
+    }
+    return lhs.taskId < rhs.taskId;
+}
+
+MaterializedViews::View::View(TaskQuery viewQuery)
+    : query(std::move(viewQuery)), rows(RowLess{&query.GetOrder()}) {
+}
+
+MaterializedViews::MaterializedViews(const Clock& clock)
+    : MaterializedViews(clock.Now(), clock) {
+}
+
+MaterializedViews::MaterializedViews(const TimePoint& now, const Clock& clock)
+    : clock_(clock), now_(now), dueDates_(false) {
+}
+
+// ITaskObserver
+void MaterializedViews::OnTaskAdded(const TaskPtr& task) {
+    tasks_[task->GetId()] = task;
+    dueDates_.OnTaskAdded(task);
+    for (auto& [name, view] : views_) {
+        Evaluate(*view, task);
+    }
+}
+
+void MaterializedViews::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void MaterializedViews::OnTaskRemoved(const TaskPtr& task) {
+    tasks_.erase(task->GetId());
+    dueDates_.OnTaskRemoved(task);
+    for (auto& [name, view] : views_) {
+        Remove(*view, task->GetId());
+    }
+}
+
+// Definitions
+void MaterializedViews::DefineView(const std::string& name, const std::string& query) {
+    if (views_.count(name)) {
+        throw std::invalid_argument("View already defined: " + name);
+    }
+    TaskQuery parsed = TaskQuery::Parse(query);
+    if (parsed.GetLimit() != 0) {
+        throw std::invalid_argument("Views cannot have a limit; page them instead");
+    }
+    if (!PageCursor::CanPage(parsed.GetOrder())) {
+        throw std::invalid_argument("Views cannot be ordered by tag");
+    }
+
+    auto view = std::make_unique<View>(std::move(parsed));
+    if (view->query.HasFilter()) {
+        CollectRelative(view->query.GetFilter(), *view);
+        view->times = QueryTimes(view->query.GetFilter(), now_);
+    }
+    for (const auto& [id, task] : tasks_) {
+        Evaluate(*view, task);
+    }
+    views_[name] = std::move(view);
+}
+
+bool MaterializedViews::DropView(const std::string& name) {
+    return views_.erase(name) > 0;
+}
+
+bool MaterializedViews::HasView(const std::string& name) const {
+    return views_.count(name) > 0;
+}
+
+std::vector<std::string> MaterializedViews::GetViewNames() const {
+    std::vector<std::string> names;
+    for (const auto& [name, view] : views_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+void MaterializedViews::DefineDefaultViews() {
+    for (const auto& [name, query] : DEFAULT_VIEWS) {
+        DefineView(name, query);
+    }
+}
+
+// Reading
+QueryResult MaterializedViews::GetPage(const std::string& name, const std::string& cursor, size_t count) const {
+    if (count == 0) {
+        throw std::invalid_argument("Page size must be positive");
+    }
+    const View& view = GetView(name);
+    const auto& order = view.query.GetOrder();
+    PageCursor position = PageCursor::Decode(cursor, order);
+
+    auto it = view.rows.begin();
+    if (!position.IsStart()) {
+        RowKey after;
+        for (size_t i = 0; i < order.size(); ++i) {
+            after.values.push_back(position.GetValue(i));
+        }
+        after.title = position.GetTitle();
+        after.taskId = position.GetTaskId();
+        it = view.rows.upper_bound(after);
+    }
+
+    QueryResult result;
+    for (; it != view.rows.end() && result.tasks.size() < count; ++it) {
+        result.tasks.push_back(tasks_.at(it->taskId));
+    }
+    if (it != view.rows.end()) {
+        result.nextCursor = PageCursor::After(*result.tasks.back(), order).Encode();
+    }
+    return result;
+}
+
+size_t MaterializedViews::GetCount(const std::string& name) const {
+    return GetView(name).rows.size();
+}
+
+// Time
+size_t MaterializedViews::Refresh() {
+    return Refresh(clock_.Now());
+}
+
+size_t MaterializedViews::Refresh(const TimePoint& now) {
+    TimePoint previous = now_;
+    now_ = now;
+    size_t checked = 0;
+    for (auto& [name, view] : views_) {
+        if (view->query.HasFilter()) {
+            view->times = QueryTimes(view->query.GetFilter(), now_);
+        }
+        if (!view->otherPredicates.empty()) {
+            for (const auto& [id, task] : tasks_) {
+                Evaluate(*view, task);
+            }
+            checked += tasks_.size();
+            continue;
+        }
+
+        // A due bound can only flip for tasks due between its old and new value
+        std::vector<int> ids;
+        for (const QueryPredicate* predicate : view->duePredicates) {
+            TimePoint before = predicate->time.Resolve(previous);
+            TimePoint after = predicate->time.Resolve(now);
+            if (before == after) {
+                continue;
+            }
+            dueDates_.ForEachInRange(std::min(before, after), std::max(before, after) + TICK,
+                                     [&ids](const DueDateIndex::Entry& entry) { ids.push_back(entry.taskId); });
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        for (int id : ids) {
+            Evaluate(*view, tasks_.at(id));
+        }
+        checked += ids.size();
+    }
+    return checked;
+}
+
+MaterializedViews::TimePoint MaterializedViews::GetNow() const {
+    return now_;
+}
+
+MaterializedViews::TimePoint MaterializedViews::NextRefreshTime() const {
+    TimePoint next = TimePoint::max();
+    for (const auto& [name, view] : views_) {
+        for (const QueryPredicate* predicate : view->duePredicates) {
+            next = std::min(next, NextCrossing(*predicate));
+        }
+        for (const QueryPredicate* predicate : view->otherPredicates) {
+            next = std::min(next, NextCrossing(*predicate));
+        }
+    }
+    return next;
+}
+
+// Helpers
+const MaterializedViews::View& MaterializedViews::GetView(const std::string& name) const {
+    auto it = views_.find(name);
+    if (it == views_.end()) {
+        throw std::invalid_argument("Unknown view: " + name);
+    }
+    return *it->second;
+}
+
+void MaterializedViews::Evaluate(View& view, const TaskPtr& task) const {
+    Remove(view, task->GetId());
+    if (view.query.HasFilter() && !TaskQuery::Matches(view.query.GetFilter(), *task, view.times)) {
+        return;
+    }
+
+    RowKey key;
+    key.taskId = task->GetId();
+    for (const auto& order : view.query.GetOrder()) {
+        key.values.push_back(TaskQuery::OrderValue(*task, order.field));
+        if (order.field == QueryField::TITLE) {
+            key.title = task->GetTitle();
+        }
+    }
+    view.rows.insert(key);
+    view.keys.emplace(key.taskId, std::move(key));
+}
+
+void MaterializedViews::Remove(View& view, int taskId) {
+    auto it = view.keys.find(taskId);
+    if (it != view.keys.end()) {
+        view.rows.erase(it->second);
+        view.keys.erase(it);
+    }
+}
+
+void MaterializedViews::CollectRelative(const QueryNode& node, View& view) {
+    if (node.kind != QueryNode::Kind::PREDICATE) {
+        for (const auto& child : node.children) {
+            CollectRelative(child, view);
+        }
+        return;
+    }
+    const QueryPredicate& predicate = node.predicate;
+    if (!predicate.time.relative) {
+        return;
+    }
+    if (predicate.field == QueryField::DUE) {
+        view.duePredicates.push_back(&predicate);
+    } else if (predicate.field == QueryField::CREATED || predicate.field == QueryField::COMPLETED) {
+        view.otherPredicates.push_back(&predicate);
+    }
+}
+
+MaterializedViews::TimePoint MaterializedViews::NextCrossing(const QueryPredicate& predicate) const {
+    // A "today" bound only moves at local midnight
+    if (predicate.time.startOfDay) {
+        return DateUtils::AddCalendarDays(DateUtils::StartOfDay(now_), 1);
+    }
+
+    // The bound is now + offset; find the first task time at or after the
+    // point where the comparison can next flip
+    TimePoint bound = predicate.time.Resolve(now_);
+    bool strict = predicate.op == QueryOp::LE || predicate.op == QueryOp::GT;
+    TimePoint from = strict ? bound + TICK : bound;
+    TimePoint first = TimePoint::max();
+    if (predicate.field == QueryField::DUE) {
+        auto entries = dueDates_.FirstAfter(from, 1);
+        if (!entries.empty()) {
+            first = entries.front().GetDueDate();
+        }
+    } else {
+        for (const auto& [id, task] : tasks_) {
+            TimePoint time = FieldTime(*task, predicate.field);
+            if (time >= from && time < first) {
+                first = time;
+            }
+        }
+    }
+    if (first == TimePoint::max()) {
+        return first;
+    }
+
+    // LT and GE flip one tick after the bound reaches the time, LE and GT
+    // when it reaches it; EQ and NE at both
+    switch (predicate.op) {
+        case QueryOp::LT:
+        case QueryOp::GE:
+            return now_ + (first - bound) + TICK;
+        case QueryOp::EQ:
+        case QueryOp::NE:
+            return first == bound ? now_ + TICK : now_ + (first - bound);
+        default:
+            return now_ + (first - bound);
+    }
+}
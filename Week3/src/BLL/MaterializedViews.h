@@ -0,0 +1,97 @@
+#ifndef _MATERIALIZEDVIEWS_H_
+#define _MATERIALIZEDVIEWS_H_
+
+#include "../BLL/DueDateIndex.h"
+#include "../BLL/ITaskObserver.h"
+#include "../BLL/QueryEngine.h"
+#include "../BLL/TaskQuery.h"
+#include "../LIB/Clock.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Named task lists (filter + order) kept sorted as tasks change, so reading
+// a page costs O(log n + page size) instead of re-running the query. Each
+// change re-checks only the changed task against every view. Relative times
+// ("now", "today") are evaluated at the views' current time; Refresh moves
+// that time forward and re-checks only the tasks whose due date lies
+// between the old and new boundaries. Views with relative created or
+// completed bounds are rescanned on refresh.
+class MaterializedViews : public ITaskObserver {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    // The clock is kept by reference and must outlive the views
+    explicit MaterializedViews(const Clock& clock = Clock::GetInstance()); // Clock time as now
+    explicit MaterializedViews(const TimePoint& now, const Clock& clock = Clock::GetInstance());
+    explicit MaterializedViews(const Clock&& clock) = delete;
+    MaterializedViews(const TimePoint& now, const Clock&& clock) = delete;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    // Throws std::invalid_argument for a taken name, a parse error, a limit
+    // clause or a tag order
+    void DefineView(const std::string& name, const std::string& query);
+    bool DropView(const std::string& name);
+    bool HasView(const std::string& name) const;
+    std::vector<std::string> GetViewNames() const;
+    // "overdue", "today" and "upcoming" (the next seven days) over open tasks
+    void DefineDefaultViews();
+
+    // Up to count tasks after the cursor (empty for the first page); the
+    // result's nextCursor is empty on the last page
+    QueryResult GetPage(const std::string& name, const std::string& cursor, size_t count) const;
+    size_t GetCount(const std::string& name) const;
+
+    // Re-evaluates tasks that crossed a time boundary; returns how many were checked
+    size_t Refresh(const TimePoint& now);
+    size_t Refresh(); // Clock time
+    TimePoint GetNow() const;
+    // Earliest time at which some view may change without a task change
+    // (time_point::max() if never)
+    TimePoint NextRefreshTime() const;
+
+private:
+    struct RowKey {
+        std::vector<int64_t> values; // TaskQuery::OrderValue per order key
+        std::string title;
+        int taskId = 0;
+    };
+
+    struct RowLess {
+        const std::vector<QueryOrder>* order;
+        bool operator()(const RowKey& lhs, const RowKey& rhs) const;
+    };
+
+    struct View {
+        TaskQuery query;
+        std::set<RowKey, RowLess> rows;
+        std::unordered_map<int, RowKey> keys; // Snapshot per member, tasks change in place
+        std::vector<const QueryPredicate*> duePredicates;   // Relative due bounds
+        std::vector<const QueryPredicate*> otherPredicates; // Relative created/completed bounds
+        QueryTimes times;                                   // Filter times at now_
+
+        explicit View(TaskQuery viewQuery);
+    };
+
+    const Clock& clock_;
+    TimePoint now_;
+    std::unordered_map<int, TaskPtr> tasks_;
+    DueDateIndex dueDates_;
+    std::map<std::string, std::unique_ptr<View>> views_;
+
+    const View& GetView(const std::string& name) const;
+    void Evaluate(View& view, const TaskPtr& task) const;
+    static void Remove(View& view, int taskId);
+    static void CollectRelative(const QueryNode& node, View& view);
+    TimePoint NextCrossing(const QueryPredicate& predicate) const;
+};
+
+#endif // _MATERIALIZEDVIEWS_H_
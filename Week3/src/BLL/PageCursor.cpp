@@ -0,0 +1,175 @@
+#include "PageCursor.h"
+#include "../LIB/HashUtils.h"
+#include "../LIB/Varint.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    constexpr uint8_t CURSOR_VERSION = 1;
+    constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    int HexValue(char ch) {
+        if (ch >= '0' && ch <= '9') return ch - '0';
+        if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+        return -1;
+    }
+
+    uint32_t Checksum(const std::vector<uint8_t>& bytes, size_t size) {
+        std::string_view data(reinterpret_cast<const char*>(bytes.data()), size);
+        return static_cast<uint32_t>(HashUtils::Fnv1a(data));
+    }
+}
+
+PageCursor::PageCursor(std::vector<QueryOrder> order)
+    : order_(std::move(order)) {
+    
+    if (!CanPage(order_)) {
+        throw std::invalid_argument("Cannot page a listing ordered by tag");
+    }
+}
+
+PageCursor PageCursor::After(const Task& task, const std::vector<QueryOrder>& order) {
+    PageCursor cursor(order);
+    cursor.start_ = false;
+    cursor.taskId_ = task.GetId();
+    for (const auto& key : order) {
+        cursor.values_.push_back(TaskQuery::OrderValue(task, key.field));
+        if (key.field == QueryField::TITLE) {
+            cursor.title_ = task.GetTitle();
+        }
+    }
+    return cursor;
+}
+
+// Token layout: version, order fingerprint, start flag, values, title, ID, then a 32-bit checksum
+std::string PageCursor::Encode() const {
+    std::vector<uint8_t> bytes;
+    bytes.push_back(CURSOR_VERSION);
+    Varint::Encode(OrderFingerprint(order_), bytes);
+    bytes.push_back(start_ ? 1 : 0);
+    for (int64_t value : values_) {
+        Varint::EncodeSigned(value, bytes);
+    }
+    Varint::Encode(title_.size(), bytes);
+    bytes.insert(bytes.end(), title_.begin(), title_.end());
+    Varint::EncodeSigned(taskId_, bytes);
+    
+    uint32_t checksum = Checksum(bytes, bytes.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        bytes.push_back(static_cast<uint8_t>(checksum >> shift));
+    }
+    
+    std::string token;
+    token.reserve(bytes.size() * 2);
+    for (uint8_t byte : bytes) {
+        token += HEX_DIGITS[byte >> 4];
+        token += HEX_DIGITS[byte & 0x0F];
+    }
+    return token;
+}
+
+PageCursor PageCursor::Decode(const std::string& token, const std::vector<QueryOrder>& order) {
+    PageCursor cursor(order);
+    if (token.empty()) {
+        return cursor;
+    }
+    
+    std::vector<uint8_t> bytes;
+    if (token.size() % 2 != 0 || token.size() < 12) {
+        throw std::invalid_argument("Malformed page cursor");
+    }
+    for (size_t i = 0; i < token.size(); i += 2) {
+        int high = HexValue(token[i]);
+        int low = HexValue(token[i + 1]);
+        if (high < 0 || low < 0) {
+            throw std::invalid_argument("Malformed page cursor");
+        }
+        bytes.push_back(static_cast<uint8_t>(high << 4 | low));
+    }
+    
+    size_t payload = bytes.size() - 4;
+    uint32_t checksum = 0;
+    for (int i = 0; i < 4; ++i) {
+        checksum |= static_cast<uint32_t>(bytes[payload + i]) << (8 * i);
+    }
+    if (checksum != Checksum(bytes, payload) || bytes[0] != CURSOR_VERSION) {
+        throw std::invalid_argument("Malformed page cursor");
+    }
+    
+    try {
+        const uint8_t* pos = bytes.data() + 1;
+        const uint8_t* end = bytes.data() + payload;
+        if (Varint::Decode(pos, end) != OrderFingerprint(order)) {
+            throw std::invalid_argument("Page cursor belongs to a different ordering");
+        }
+        if (pos == end) {
+            throw std::runtime_error("truncated");
+        }
+        cursor.start_ = *pos++ != 0;
+        for (size_t i = 0; i < order.size(); ++i) {
+            cursor.values_.push_back(Varint::DecodeSigned(pos, end));
+        }
+        uint64_t titleSize = Varint::Decode(pos, end);
+        if (titleSize > static_cast<uint64_t>(end - pos)) {
+            throw std::runtime_error("truncated");
+        }
+        cursor.title_.assign(reinterpret_cast<const char*>(pos), titleSize);
+        pos += titleSize;
+        cursor.taskId_ = static_cast<int>(Varint::DecodeSigned(pos, end));
+        if (pos != end) {
+            throw std::runtime_error("trailing bytes");
+        }
+    } catch (const std::runtime_error&) {
+        throw std::invalid_argument("Malformed page cursor");
+    }
+    return cursor;
+}
+
+bool PageCursor::IsStart() const {
+    return start_;
+}
+
+int PageCursor::GetTaskId() const {
+    return taskId_;
+}
+
+int64_t PageCursor::GetValue(size_t key) const {
+    return values_.at(key);
+}
+
+const std::string& PageCursor::GetTitle() const {
+    return title_;
+}
+
+bool PageCursor::Precedes(const Task& task) const {
+    if (start_) {
+        return true;
+    }
+    // Same ordering as TaskQuery::Compare
+    for (size_t i = 0; i < order_.size(); ++i) {
+        int result;
+        if (order_[i].field == QueryField::TITLE) {
+            int compare = task.GetTitle().compare(title_);
+            result = compare < 0 ? -1 : (compare > 0 ? 1 : 0);
+        } else {
+            int64_t value = TaskQuery::OrderValue(task, order_[i].field);
+            result = value < values_[i] ? -1 : (value > values_[i] ? 1 : 0);
+        }
+        if (result != 0) {
+            return (order_[i].descending ? -result : result) > 0;
+        }
+    }
+    return task.GetId() > taskId_;
+}
+
+bool PageCursor::CanPage(const std::vector<QueryOrder>& order) {
+    return std::none_of(order.begin(), order.end(), [](const QueryOrder& key) { return key.field == QueryField::TAG; });
+}
+
+uint64_t PageCursor::OrderFingerprint(const std::vector<QueryOrder>& order) {
+    FingerprintBuilder builder;
+    for (const auto& key : order) {
+        builder.Add(static_cast<int64_t>(key.field)).Add(static_cast<int64_t>(key.descending));
+    }
+    return builder.Finish();
+}
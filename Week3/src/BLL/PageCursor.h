@@ -0,0 +1,43 @@
+#ifndef _PAGECURSOR_H_
+#define _PAGECURSOR_H_
+
+#include "../BLL/TaskQuery.h"
+#include "../DTO/Task.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Keyset pagination position: the order-key values and ID of the last task
+// on a page. Encoded as an opaque hex token bound to the query's order and
+// checksummed, so a token from another listing or a damaged one is rejected
+// (std::invalid_argument) instead of silently returning a wrong page.
+// Tasks added or edited between pages appear on a later page only if their
+// key sorts after the cursor; no task is repeated or skipped otherwise.
+class PageCursor {
+public:
+    explicit PageCursor(std::vector<QueryOrder> order = {}); // Start of the listing
+
+    static PageCursor After(const Task& task, const std::vector<QueryOrder>& order);
+    static PageCursor Decode(const std::string& token, const std::vector<QueryOrder>& order);
+    std::string Encode() const;
+
+    bool IsStart() const;
+    int GetTaskId() const;
+    int64_t GetValue(size_t key) const;
+    const std::string& GetTitle() const;
+    // True when the task sorts strictly after the cursor position
+    bool Precedes(const Task& task) const;
+
+    static bool CanPage(const std::vector<QueryOrder>& order); // Tag order is not supported
+
+private:
+    std::vector<QueryOrder> order_;
+    bool start_ = true;
+    std::vector<int64_t> values_; // One per order key
+    std::string title_;           // Title key value, if any
+    int taskId_ = 0;
+
+    static uint64_t OrderFingerprint(const std::vector<QueryOrder>& order);
+};
+
+#endif // _PAGECURSOR_H_
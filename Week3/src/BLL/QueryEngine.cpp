@@ -0,0 +1,384 @@
+#include "QueryEngine.h"
+#include "../BLL/TaskSorter.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <cstdio>
+
+using namespace std::chrono;
+
+namespace {
+    // Appends timed stages when explain output is wanted (stages != nullptr)
+    class StageTimer {
+    public:
+        explicit StageTimer(std::vector<QueryStage>* stages)
+            : stages_(stages), start_(stages ? steady_clock::now() : steady_clock::time_point()) {}
+
+        void Finish(std::string name, std::string detail, size_t rows) {
+            if (!stages_) {
+                return;
+            }
+            auto now = steady_clock::now();
+            stages_->push_back(QueryStage{std::move(name), std::move(detail), rows,
+                                          duration<double, std::micro>(now - start_).count()});
+            start_ = now;
+        }
+
+    private:
+        std::vector<QueryStage>* stages_;
+        steady_clock::time_point start_;
+    };
+
+    bool IsDuePredicate(const QueryNode& node) {
+        return node.kind == QueryNode::Kind::PREDICATE && node.predicate.field == QueryField::DUE;
+    }
+}
+
+std::string QueryResult::Explain() const {
+    std::string text;
+    char line[64];
+    for (const auto& stage : stages) {
+        std::snprintf(line, sizeof(line), "%-7s ", stage.name.c_str());
+        text += line;
+        text += stage.detail;
+        std::snprintf(line, sizeof(line), "  rows=%zu  %.1f us\n", stage.rows, stage.microseconds);
+        text += line;
+    }
+    return text;
+}
+
+QueryEngine::QueryEngine(const Clock& clock)
+    : clock_(clock), dueDates_(false) {
+}
+
+// ITaskObserver
+void QueryEngine::OnTaskAdded(const TaskPtr& task) {
+    tasks_[task->GetId()] = task;
+    bitmaps_.OnTaskAdded(task);
+    dueDates_.OnTaskAdded(task);
+}
+
+void QueryEngine::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void QueryEngine::OnTaskRemoved(const TaskPtr& task) {
+    tasks_.erase(task->GetId());
+    bitmaps_.OnTaskRemoved(task);
+    dueDates_.OnTaskRemoved(task);
+}
+
+size_t QueryEngine::Size() const {
+    return tasks_.size();
+}
+
+// Execution
+QueryResult QueryEngine::Execute(const std::string& query, bool explain) const {
+    return Execute(TaskQuery::Parse(query), clock_.Now(), explain);
+}
+
+QueryResult QueryEngine::Execute(const TaskQuery& query, const system_clock::time_point& now, bool explain) const {
+    QueryResult result;
+    std::vector<TaskPtr> candidates = Filter(query, now, explain ? &result.stages : nullptr);
+    StageTimer timer(explain ? &result.stages : nullptr);
+    
+    // Ordering
+    const auto& order = query.GetOrder();
+    size_t limit = query.GetLimit();
+    auto less = [&order](const TaskPtr& lhs, const TaskPtr& rhs) { return TaskQuery::Compare(order, *lhs, *rhs) < 0; };
+    std::string orderText = order.empty() ? "id asc" : TaskQuery::Describe(order);
+    if (limit > 0 && limit < candidates.size()) {
+        std::partial_sort(candidates.begin(), candidates.begin() + limit, candidates.end(), less);
+        candidates.resize(limit);
+        timer.Finish("top-k", orderText + " limit " + std::to_string(limit), candidates.size());
+    } else {
+        TaskSorter::Sort(candidates, order);
+        timer.Finish("sort", orderText + (TaskSorter::CanPack(order) ? " [radix]" : ""), candidates.size());
+    }
+    
+    result.tasks = std::move(candidates);
+    return result;
+}
+
+QueryResult QueryEngine::ExecutePage(const TaskQuery& query, const std::string& cursor,
+                                     const system_clock::time_point& now, bool explain) const {
+    size_t limit = query.GetLimit();
+    if (limit == 0) {
+        throw std::invalid_argument("Paged queries need a limit");
+    }
+    const auto& order = query.GetOrder();
+    PageCursor position = PageCursor::Decode(cursor, order);
+    
+    QueryResult result;
+    std::vector<TaskPtr> page;
+    bool dueOrder = !order.empty() && order[0].field == QueryField::DUE && !order[0].descending &&
+                    (order.size() == 1 || (order.size() == 2 && order[1].field == QueryField::ID && !order[1].descending));
+    if (dueOrder) {
+        // The index is ordered by (due, ID), exactly the listing order
+        StageTimer timer(explain ? &result.stages : nullptr);
+        DueDateIndex::Entry after{INT64_MIN, INT_MIN};
+        if (!position.IsStart()) {
+            after = DueDateIndex::Entry{position.GetValue(0), position.GetTaskId()};
+        }
+        QueryTimes times = query.HasFilter() ? QueryTimes(query.GetFilter(), now) : QueryTimes();
+        size_t visited = 0;
+        dueDates_.ForEachAfter(after, [&](const DueDateIndex::Entry& entry) {
+            ++visited;
+            const TaskPtr& task = tasks_.at(entry.taskId);
+            if (!query.HasFilter() || TaskQuery::Matches(query.GetFilter(), *task, times)) {
+                page.push_back(task);
+            }
+            return page.size() <= limit;
+        });
+        timer.Finish("seek", "due-date index after cursor [" + std::to_string(visited) + " visited]", page.size());
+    } else {
+        page = Filter(query, now, explain ? &result.stages : nullptr);
+        StageTimer timer(explain ? &result.stages : nullptr);
+        
+        // Keep the rows after the cursor, then select the first limit + 1
+        page.erase(std::remove_if(page.begin(), page.end(), [&position](const TaskPtr& task) {
+            return !position.Precedes(*task);
+        }), page.end());
+        size_t keep = std::min(page.size(), limit + 1);
+        std::partial_sort(page.begin(), page.begin() + keep, page.end(), [&order](const TaskPtr& lhs, const TaskPtr& rhs) {
+            return TaskQuery::Compare(order, *lhs, *rhs) < 0;
+        });
+        page.resize(keep);
+        timer.Finish("top-k", (order.empty() ? "id asc" : TaskQuery::Describe(order)) + " after cursor limit " +
+                     std::to_string(limit), page.size());
+    }
+    
+    // One extra row tells whether another page follows
+    if (page.size() > limit) {
+        page.resize(limit);
+        result.nextCursor = PageCursor::After(*page.back(), order).Encode();
+    }
+    result.tasks = std::move(page);
+    return result;
+}
+
+std::vector<TaskPtr> QueryEngine::Filter(const TaskQuery& query, const system_clock::time_point& now,
+                                         std::vector<QueryStage>* stages) const {
+    StageTimer timer(stages);
+    
+    // Split the filter into indexed conjuncts and residual predicates
+    std::vector<const QueryNode*> conjuncts;
+    if (query.HasFilter()) {
+        const QueryNode& filter = query.GetFilter();
+        if (filter.kind == QueryNode::Kind::AND) {
+            for (const auto& child : filter.children) {
+                conjuncts.push_back(&child);
+            }
+        } else {
+            conjuncts.push_back(&filter);
+        }
+    }
+    
+    std::vector<std::pair<const QueryNode*, RoaringBitmap>> indexed;
+    std::vector<const QueryNode*> residual;
+    for (const QueryNode* node : conjuncts) {
+        if (IsDuePredicate(*node)) {
+            size_t estimate = EstimateDue(node->predicate, now);
+            if (static_cast<double>(estimate) > DUE_INDEX_MAX_SELECTIVITY * static_cast<double>(tasks_.size())) {
+                residual.push_back(node);
+                continue;
+            }
+        }
+        if (IsIndexable(*node)) {
+            indexed.emplace_back(node, EvaluateIndex(*node, now));
+        } else {
+            residual.push_back(node);
+        }
+    }
+    
+    std::vector<TaskPtr> candidates;
+    if (indexed.empty()) {
+        candidates.reserve(tasks_.size());
+        for (const auto& [id, task] : tasks_) {
+            candidates.push_back(task);
+        }
+        timer.Finish("scan", "all tasks", candidates.size());
+    } else {
+        std::sort(indexed.begin(), indexed.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.Cardinality() < rhs.second.Cardinality();
+        });
+        RoaringBitmap matches = indexed.front().second;
+        for (size_t i = 0; i < indexed.size(); ++i) {
+            if (i > 0) {
+                matches &= indexed[i].second;
+            }
+            const QueryNode& node = *indexed[i].first;
+            std::string source = IsDuePredicate(node) ? "due-date index" : "bitmap index";
+            timer.Finish("index", TaskQuery::Describe(node) + " [" + source + ", " +
+                         std::to_string(indexed[i].second.Cardinality()) + " postings]", matches.Cardinality());
+        }
+        candidates.reserve(matches.Cardinality());
+        matches.ForEach([&](uint32_t ordinal) {
+            auto it = tasks_.find(bitmaps_.GetTaskId(ordinal));
+            if (it != tasks_.end()) {
+                candidates.push_back(it->second);
+            }
+        });
+    }
+    
+    // Residual predicates, one batch at a time so each predicate runs over a cache-sized slice
+    if (!residual.empty()) {
+        QueryTimes times(query.GetFilter(), now);
+        size_t kept = 0;
+        for (size_t begin = 0; begin < candidates.size(); begin += BATCH_SIZE) {
+            size_t end = std::min(begin + BATCH_SIZE, candidates.size());
+            size_t batchEnd = end;
+            for (const QueryNode* node : residual) {
+                size_t out = begin;
+                for (size_t i = begin; i < batchEnd; ++i) {
+                    if (TaskQuery::Matches(*node, *candidates[i], times)) {
+                        candidates[out++] = std::move(candidates[i]);
+                    }
+                }
+                batchEnd = out;
+            }
+            for (size_t i = begin; i < batchEnd; ++i) {
+                candidates[kept++] = std::move(candidates[i]);
+            }
+        }
+        size_t batches = (candidates.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+        candidates.resize(kept);
+        
+        std::string detail;
+        for (const QueryNode* node : residual) {
+            detail += (detail.empty() ? "" : " and ") + TaskQuery::Describe(*node);
+        }
+        timer.Finish("filter", detail + " [" + std::to_string(batches) + " batches]", candidates.size());
+    }
+    
+    return candidates;
+}
+
+// Index evaluation
+bool QueryEngine::IsIndexable(const QueryNode& node) const {
+    if (node.kind != QueryNode::Kind::PREDICATE) {
+        return std::all_of(node.children.begin(), node.children.end(),
+                           [this](const QueryNode& child) { return IsIndexable(child); });
+    }
+    switch (node.predicate.field) {
+        case QueryField::STATUS:
+        case QueryField::PRIORITY:
+        case QueryField::DUE:
+            return true;
+        case QueryField::CATEGORY:
+        case QueryField::TAG:
+            return node.predicate.op == QueryOp::EQ || node.predicate.op == QueryOp::NE || node.predicate.op == QueryOp::IN;
+        default:
+            return false;
+    }
+}
+
+RoaringBitmap QueryEngine::EvaluateIndex(const QueryNode& node, const system_clock::time_point& now) const {
+    switch (node.kind) {
+        case QueryNode::Kind::AND: {
+            RoaringBitmap result = EvaluateIndex(node.children.front(), now);
+            for (size_t i = 1; i < node.children.size() && !result.Empty(); ++i) {
+                result &= EvaluateIndex(node.children[i], now);
+            }
+            return result;
+        }
+        case QueryNode::Kind::OR: {
+            RoaringBitmap result;
+            for (const auto& child : node.children) {
+                result |= EvaluateIndex(child, now);
+            }
+            return result;
+        }
+        case QueryNode::Kind::NOT: {
+            RoaringBitmap result = bitmaps_.All();
+            return result.AndNot(EvaluateIndex(node.children.front(), now));
+        }
+        case QueryNode::Kind::PREDICATE:
+            break;
+    }
+    
+    const QueryPredicate& predicate = node.predicate;
+    if (predicate.field == QueryField::DUE) {
+        return EvaluateDue(predicate, now);
+    }
+    
+    // Union of the posting lists of every value the predicate accepts
+    RoaringBitmap result;
+    auto unionIf = [&](size_t count, auto&& lookup) {
+        for (size_t value = 0; value < count; ++value) {
+            bool accepted = predicate.op == QueryOp::IN
+                ? std::find(predicate.numbers.begin(), predicate.numbers.end(), static_cast<int64_t>(value)) != predicate.numbers.end()
+                : predicate.op == QueryOp::EQ ? static_cast<int64_t>(value) == predicate.numbers.front()
+                : predicate.op == QueryOp::NE ? static_cast<int64_t>(value) != predicate.numbers.front()
+                : predicate.op == QueryOp::LT ? static_cast<int64_t>(value) < predicate.numbers.front()
+                : predicate.op == QueryOp::LE ? static_cast<int64_t>(value) <= predicate.numbers.front()
+                : predicate.op == QueryOp::GT ? static_cast<int64_t>(value) > predicate.numbers.front()
+                : static_cast<int64_t>(value) >= predicate.numbers.front();
+            if (accepted) {
+                result |= lookup(value);
+            }
+        }
+    };
+    
+    switch (predicate.field) {
+        case QueryField::STATUS:
+            unionIf(TASK_STATUS_COUNT, [this](size_t value) -> const RoaringBitmap& {
+                return bitmaps_.WithStatus(static_cast<Enums::TaskStatus>(value));
+            });
+            return result;
+        case QueryField::PRIORITY:
+            unionIf(PRIORITY_COUNT, [this](size_t value) -> const RoaringBitmap& {
+                return bitmaps_.WithPriority(static_cast<Enums::Priority>(value));
+            });
+            return result;
+        case QueryField::CATEGORY:
+            for (int64_t categoryId : predicate.numbers) {
+                result |= bitmaps_.WithCategory(static_cast<int>(categoryId));
+            }
+            break;
+        case QueryField::TAG:
+            for (const auto& tag : predicate.strings) {
+                result |= bitmaps_.WithTag(tag);
+            }
+            break;
+        default:
+            break;
+    }
+    if (predicate.op == QueryOp::NE) {
+        RoaringBitmap all = bitmaps_.All();
+        return all.AndNot(result);
+    }
+    return result;
+}
+
+RoaringBitmap QueryEngine::EvaluateDue(const QueryPredicate& predicate, const system_clock::time_point& now) const {
+    RoaringBitmap result;
+    auto [from, to] = DueRange(predicate, now);
+    dueDates_.ForEachInRange(from, to, [&](const DueDateIndex::Entry& entry) {
+        result.Add(static_cast<uint32_t>(bitmaps_.GetOrdinal(entry.taskId)));
+    });
+    if (predicate.op == QueryOp::NE) {
+        RoaringBitmap all = bitmaps_.All();
+        return all.AndNot(result);
+    }
+    return result;
+}
+
+size_t QueryEngine::EstimateDue(const QueryPredicate& predicate, const system_clock::time_point& now) const {
+    auto [from, to] = DueRange(predicate, now);
+    size_t count = dueDates_.Count(from, to);
+    return predicate.op == QueryOp::NE ? dueDates_.Size() - count : count;
+}
+
+std::pair<system_clock::time_point, system_clock::time_point>
+QueryEngine::DueRange(const QueryPredicate& predicate, const system_clock::time_point& now) {
+    auto time = predicate.time.Resolve(now);
+    auto next = time + system_clock::duration(1);
+    switch (predicate.op) {
+        case QueryOp::LT: return {system_clock::time_point::min(), time};
+        case QueryOp::LE: return {system_clock::time_point::min(), next};
+        case QueryOp::GT: return {next, system_clock::time_point::max()};
+        case QueryOp::GE: return {time, system_clock::time_point::max()};
+        default: return {time, next}; // EQ, and the complement of NE
+    }
+}
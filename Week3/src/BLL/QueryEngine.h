@@ -0,0 +1,77 @@
+#ifndef _QUERYENGINE_H_
+#define _QUERYENGINE_H_
+
+#include "../BLL/DueDateIndex.h"
+#include "../BLL/ITaskObserver.h"
+#include "../BLL/PageCursor.h"
+#include "../BLL/TaskBitmapIndex.h"
+#include "../BLL/TaskQuery.h"
+#include "../LIB/Clock.h"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct QueryStage {
+    std::string name;   // index, scan, sort, top-k, limit
+    std::string detail;
+    size_t rows = 0;    // Rows leaving the stage
+    double microseconds = 0.0;
+};
+
+struct QueryResult {
+    std::vector<TaskPtr> tasks;
+    std::vector<QueryStage> stages; // Filled when explain is requested
+    std::string nextCursor;         // From ExecutePage; empty on the last page
+
+    std::string Explain() const;
+};
+
+// Executes TaskQuery plans against tasks it follows as a TaskService
+// observer. Top-level conjuncts over status, priority, category and tag are
+// answered from bitmap indexes and due-date ranges from the ordered index
+// when selective; everything else is checked in batches over the remaining
+// candidates. A limit uses a partial sort instead of sorting every match.
+class QueryEngine : public ITaskObserver {
+public:
+    // The clock is kept by reference and must outlive the engine
+    explicit QueryEngine(const Clock& clock = Clock::GetInstance());
+    explicit QueryEngine(const Clock&& clock) = delete;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    QueryResult Execute(const TaskQuery& query, const std::chrono::system_clock::time_point& now,
+                        bool explain = false) const;
+    QueryResult Execute(const std::string& query, bool explain = false) const; // Clock time as now
+    // One page of `limit` rows after the cursor (empty cursor for the first
+    // page). Listings ordered by due date walk the due-date index from the
+    // cursor; others keep a bounded top-K of the rows after it.
+    QueryResult ExecutePage(const TaskQuery& query, const std::string& cursor,
+                            const std::chrono::system_clock::time_point& now, bool explain = false) const;
+
+    size_t Size() const;
+
+    static constexpr size_t BATCH_SIZE = 1024;
+    // Due-date ranges matching more than this share of tasks are scanned instead
+    static constexpr double DUE_INDEX_MAX_SELECTIVITY = 0.25;
+
+private:
+    const Clock& clock_;
+    TaskBitmapIndex bitmaps_;
+    DueDateIndex dueDates_;
+    std::unordered_map<int, TaskPtr> tasks_;
+
+    std::vector<TaskPtr> Filter(const TaskQuery& query, const std::chrono::system_clock::time_point& now,
+                                std::vector<QueryStage>* stages) const;
+    bool IsIndexable(const QueryNode& node) const;
+    RoaringBitmap EvaluateIndex(const QueryNode& node, const std::chrono::system_clock::time_point& now) const;
+    RoaringBitmap EvaluateDue(const QueryPredicate& predicate, const std::chrono::system_clock::time_point& now) const;
+    size_t EstimateDue(const QueryPredicate& predicate, const std::chrono::system_clock::time_point& now) const;
+    static std::pair<std::chrono::system_clock::time_point, std::chrono::system_clock::time_point>
+        DueRange(const QueryPredicate& predicate, const std::chrono::system_clock::time_point& now);
+};
+
+#endif // _QUERYENGINE_H_
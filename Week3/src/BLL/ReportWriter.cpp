@@ -0,0 +1,65 @@
+#include "ReportWriter.h"
+#include "../LIB/Logger.h"
+#include <cerrno>
+#include <cstring>
+
+ReportWriter::ReportWriter(int fd, ReportFormat format, size_t flushThreshold)
+    : fd_(fd)
+    , format_(format)
+    , flushThreshold_(flushThreshold)
+    , buffer_(flushThreshold + 4096) {
+}
+
+ReportWriter::~ReportWriter() {
+    if (!Flush()) {
+        LOG_ERROR("Dropping " + std::to_string(buffer_.Size()) + " unwritten bytes of reports");
+    }
+}
+
+bool ReportWriter::Write(const ProductivityReport& report) {
+    switch (format_) {
+        case ReportFormat::CSV:
+            if (reportCount_ == 0) {
+                ProductivityReport::RenderCsvHeader(buffer_);
+            }
+            report.RenderCsv(buffer_);
+            break;
+        case ReportFormat::JSON:
+            report.RenderJson(buffer_);
+            buffer_.Append('\n');
+            break;
+        default:
+            if (reportCount_ > 0) {
+                buffer_.Append('\n');
+            }
+            report.Render(format_, buffer_);
+            break;
+    }
+    ++reportCount_;
+    
+    if (buffer_.Size() >= flushThreshold_) {
+        return Flush();
+    }
+    return true;
+}
+
+bool ReportWriter::Flush() {
+    if (buffer_.Empty()) {
+        return true;
+    }
+    if (!buffer_.FlushTo(fd_)) {
+        lastError_ = errno;
+        LOG_ERROR("Failed to write reports to file descriptor " + std::to_string(fd_) + ": " +
+                  std::strerror(lastError_));
+        return false;
+    }
+    return true;
+}
+
+size_t ReportWriter::GetReportCount() const {
+    return reportCount_;
+}
+
+int ReportWriter::GetLastError() const {
+    return lastError_;
+}
@@ -0,0 +1,37 @@
+#ifndef _REPORTWRITER_H_
+#define _REPORTWRITER_H_
+
+#include "../DTO/ProductivityReport.h"
+#include "../LIB/TextBuffer.h"
+#include <cstddef>
+
+// Batch output of many reports to a file descriptor through one reused
+// buffer; data is written whenever the buffer passes flushThreshold.
+// Text reports are separated by a blank line, JSON is written as JSON Lines
+// and CSV gets a single header row. The descriptor is not closed. A failed
+// write keeps the unwritten data for the next Flush; call Flush before
+// destruction to see errors, the destructor can only log them.
+class ReportWriter {
+public:
+    ReportWriter(int fd, ReportFormat format, size_t flushThreshold = 64 * 1024);
+    ~ReportWriter();
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    bool Write(const ProductivityReport& report);
+    bool Flush();
+
+    size_t GetReportCount() const;
+    int GetLastError() const; // errno of the last failed write, 0 if none
+
+private:
+    int fd_;
+    ReportFormat format_;
+    size_t flushThreshold_;
+    TextBuffer buffer_;
+    size_t reportCount_ = 0;
+    int lastError_ = 0;
+};
+
+#endif // _REPORTWRITER_H_
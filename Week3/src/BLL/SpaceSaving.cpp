@@ -0,0 +1,118 @@
+#include "SpaceSaving.h"
+#include <algorithm>
+#include <stdexcept>
+
+SpaceSaving::SpaceSaving(size_t capacity)
+    : capacity_(capacity) {
+    
+    if (capacity == 0) {
+        throw std::invalid_argument("Space-Saving capacity must be positive");
+    }
+    entries_.reserve(capacity);
+}
+
+void SpaceSaving::Add(const std::string& key, int64_t count) {
+    totalCount_ += count;
+    
+    auto it = indexByKey_.find(key);
+    if (it != indexByKey_.end()) {
+        entries_[it->second].count += count;
+        return;
+    }
+    
+    if (entries_.size() < capacity_) {
+        indexByKey_.emplace(key, entries_.size());
+        entries_.push_back(Entry{key, count, 0});
+        return;
+    }
+    
+    // Evict the smallest counter; the newcomer inherits its count as error
+    size_t victim = MinIndex();
+    Entry& entry = entries_[victim];
+    indexByKey_.erase(entry.key);
+    entry.error = entry.count;
+    entry.count += count;
+    entry.key = key;
+    indexByKey_.emplace(key, victim);
+}
+
+void SpaceSaving::Merge(const SpaceSaving& other) {
+    int64_t ownMin = MinCount();
+    int64_t otherMin = other.MinCount();
+    
+    std::unordered_map<std::string, Entry> combined;
+    for (const auto& entry : entries_) {
+        combined[entry.key] = Entry{entry.key, entry.count + otherMin, entry.error + otherMin};
+    }
+    for (const auto& entry : other.entries_) {
+        auto it = combined.find(entry.key);
+        if (it != combined.end()) {
+            it->second.count += entry.count - otherMin;
+            it->second.error += entry.error - otherMin;
+        } else {
+            combined[entry.key] = Entry{entry.key, entry.count + ownMin, entry.error + ownMin};
+        }
+    }
+    
+    std::vector<Entry> merged;
+    merged.reserve(combined.size());
+    for (auto& [key, entry] : combined) {
+        merged.push_back(std::move(entry));
+    }
+    totalCount_ += other.totalCount_;
+    Rebuild(std::move(merged));
+}
+
+std::vector<SpaceSaving::Entry> SpaceSaving::Top(size_t n) const {
+    std::vector<Entry> result = entries_;
+    auto byCount = [](const Entry& lhs, const Entry& rhs) {
+        return lhs.count != rhs.count ? lhs.count > rhs.count : lhs.key < rhs.key;
+    };
+    n = std::min(n, result.size());
+    std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(n), result.end(), byCount);
+    result.resize(n);
+    return result;
+}
+
+size_t SpaceSaving::GetCapacity() const {
+    return capacity_;
+}
+
+size_t SpaceSaving::Size() const {
+    return entries_.size();
+}
+
+int64_t SpaceSaving::GetTotalCount() const {
+    return totalCount_;
+}
+
+size_t SpaceSaving::MinIndex() const {
+    size_t minIndex = 0;
+    for (size_t i = 1; i < entries_.size(); ++i) {
+        if (entries_[i].count < entries_[minIndex].count) {
+            minIndex = i;
+        }
+    }
+    return minIndex;
+}
+
+int64_t SpaceSaving::MinCount() const {
+    if (entries_.size() < capacity_ || entries_.empty()) {
+        return 0;
+    }
+    return entries_[MinIndex()].count;
+}
+
+void SpaceSaving::Rebuild(std::vector<Entry> entries) {
+    if (entries.size() > capacity_) {
+        std::nth_element(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(capacity_), entries.end(),
+                         [](const Entry& lhs, const Entry& rhs) { return lhs.count > rhs.count; });
+        entries.resize(capacity_);
+    }
+    
+    entries_ = std::move(entries);
+    indexByKey_.clear();
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        indexByKey_.emplace(entries_[i].key, i);
+    }
+}
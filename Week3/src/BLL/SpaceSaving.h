@@ -0,0 +1,43 @@
+#ifndef _SPACESAVING_H_
+#define _SPACESAVING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Space-Saving heavy hitters: keeps at most `capacity` counters. Every item
+// with true frequency above total / capacity is guaranteed to be tracked,
+// and each count overestimates by at most its recorded error.
+class SpaceSaving {
+public:
+    struct Entry {
+        std::string key;
+        int64_t count = 0;
+        int64_t error = 0; // Upper bound on the overestimate
+    };
+
+    explicit SpaceSaving(size_t capacity = 64);
+
+    void Add(const std::string& key, int64_t count = 1);
+    // Mergeable summaries: keys missing from a full side are charged that side's minimum
+    void Merge(const SpaceSaving& other);
+
+    std::vector<Entry> Top(size_t n) const; // Highest counts first
+    size_t GetCapacity() const;
+    size_t Size() const;
+    int64_t GetTotalCount() const;
+
+private:
+    size_t capacity_;
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, size_t> indexByKey_;
+    int64_t totalCount_ = 0;
+
+    size_t MinIndex() const;
+    int64_t MinCount() const; // 0 while not full
+    void Rebuild(std::vector<Entry> entries);
+};
+
+#endif // _SPACESAVING_H_
@@ -0,0 +1,103 @@
+#include "StatisticsManager.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace std::chrono;
+
+ProductivityReportPtr StatisticsManager::BuildReport(const std::vector<TaskPtr>& tasks,
+                                                     const system_clock::time_point& startDate,
+                                                     const system_clock::time_point& endDate,
+                                                     unsigned threadCount,
+                                                     const Clock& clock) {
+    auto report = std::make_shared<ProductivityReport>(startDate, endDate);
+    auto asOf = std::min(clock.Now(), endDate);
+    
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (tasks.size() < PARALLEL_THRESHOLD) {
+        threadCount = 1;
+    }
+    
+    std::vector<Partial> partials(threadCount);
+    if (threadCount == 1) {
+        Accumulate(tasks, 0, tasks.size(), startDate, endDate, asOf, partials[0]);
+    } else {
+        std::vector<std::thread> workers;
+        size_t chunk = (tasks.size() + threadCount - 1) / threadCount;
+        for (unsigned i = 0; i < threadCount; ++i) {
+            size_t begin = std::min(tasks.size(), i * chunk);
+            size_t end = std::min(tasks.size(), begin + chunk);
+            workers.emplace_back(Accumulate, std::cref(tasks), begin, end,
+                                 startDate, endDate, asOf, std::ref(partials[i]));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (unsigned i = 1; i < threadCount; ++i) {
+            partials[0].Merge(partials[i]);
+        }
+    }
+    
+    ToReport(partials[0], *report);
+    return report;
+}
+
+void StatisticsManager::Partial::Merge(const Partial& other) {
+    overall.Merge(other.overall);
+    for (const auto& [categoryId, accumulator] : other.byCategory) {
+        byCategory[categoryId].Merge(accumulator);
+    }
+    topTags.Merge(other.topTags);
+    distinctTags.Merge(other.distinctTags);
+}
+
+void StatisticsManager::ToReport(const Partial& partial, ProductivityReport& report) {
+    std::map<int, ProductivityStats> categoryStats;
+    for (const auto& [categoryId, accumulator] : partial.byCategory) {
+        categoryStats.emplace(categoryId, accumulator.ToStats());
+    }
+    report.SetOverallStats(partial.overall.ToStats());
+    report.SetCategoryStats(std::move(categoryStats));
+    
+    std::vector<TagCount> topTags;
+    for (const auto& entry : partial.topTags.Top(TOP_TAG_COUNT)) {
+        topTags.push_back(TagCount{entry.key, entry.count});
+    }
+    report.SetTopTags(std::move(topTags));
+    report.SetDistinctTagCount(static_cast<size_t>(std::llround(partial.distinctTags.Estimate())));
+}
+
+void StatisticsManager::Accumulate(const std::vector<TaskPtr>& tasks, size_t begin, size_t end,
+                                   const system_clock::time_point& startDate,
+                                   const system_clock::time_point& endDate,
+                                   const system_clock::time_point& asOf,
+                                   Partial& partial) {
+    // Cache the last category slot; tasks tend to cluster by category
+    int lastCategoryId = 0;
+    StatsAccumulator* lastCategory = nullptr;
+    
+    for (size_t i = begin; i < end; ++i) {
+        const Task& task = *tasks[i];
+        if (task.GetCreatedAt() < startDate || task.GetCreatedAt() >= endDate) {
+            continue;
+        }
+        
+        partial.overall.Add(task, asOf);
+        for (const auto& tag : task.GetTags()) {
+            partial.topTags.Add(tag);
+            partial.distinctTags.Add(tag);
+        }
+        
+        int categoryId = task.GetCategoryId();
+        if (categoryId == 0) {
+            continue;
+        }
+        if (!lastCategory || categoryId != lastCategoryId) {
+            lastCategoryId = categoryId;
+            lastCategory = &partial.byCategory[lastCategoryId];
+        }
+        lastCategory->Add(task, asOf);
+    }
+}
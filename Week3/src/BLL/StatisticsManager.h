@@ -0,0 +1,51 @@
+#ifndef _STATISTICSMANAGER_H_
+#define _STATISTICSMANAGER_H_
+
+#include "../BLL/HyperLogLog.h"
+#include "../BLL/SpaceSaving.h"
+#include "../BLL/StatsAccumulator.h"
+#include "../DTO/Task.h"
+#include "../DTO/ProductivityReport.h"
+#include "../LIB/Clock.h"
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+class StatisticsManager {
+public:
+    // Builds overall and per-category stats in a single pass over the tasks.
+    // A task belongs to the window when its createdAt is in [startDate, endDate);
+    // overdue is evaluated at min(now, endDate). Uncategorized tasks (category ID 0) only
+    // count towards the overall stats. threadCount = 0 picks the hardware count.
+    static ProductivityReportPtr BuildReport(const std::vector<TaskPtr>& tasks,
+                                             const std::chrono::system_clock::time_point& startDate,
+                                             const std::chrono::system_clock::time_point& endDate,
+                                             unsigned threadCount = 0,
+                                             const Clock& clock = Clock::GetInstance());
+
+    // Per-chunk result; exposed so other scanners (e.g. streaming readers) can reuse it
+    struct Partial {
+        StatsAccumulator overall;
+        std::unordered_map<int, StatsAccumulator> byCategory;
+        SpaceSaving topTags;
+        HyperLogLog distinctTags;
+
+        void Merge(const Partial& other);
+    };
+
+    static void ToReport(const Partial& partial, ProductivityReport& report);
+
+    // Below this many tasks a single thread is faster than spawning workers
+    static constexpr size_t PARALLEL_THRESHOLD = 50000;
+    // Number of tags listed in the report
+    static constexpr size_t TOP_TAG_COUNT = 10;
+
+private:
+    static void Accumulate(const std::vector<TaskPtr>& tasks, size_t begin, size_t end,
+                           const std::chrono::system_clock::time_point& startDate,
+                           const std::chrono::system_clock::time_point& endDate,
+                           const std::chrono::system_clock::time_point& asOf,
+                           Partial& partial);
+};
+
+#endif // _STATISTICSMANAGER_H_
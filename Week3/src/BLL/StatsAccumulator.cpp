@@ -0,0 +1,119 @@
+#include "StatsAccumulator.h"
+
+using namespace std::chrono;
+
+void StatsAccumulator::Add(Enums::TaskStatus status, Enums::Priority priority,
+                           const system_clock::time_point& dueDate,
+                           const system_clock::time_point& createdAt,
+                           const system_clock::time_point& completedAt,
+                           const system_clock::time_point& asOf) {
+    Apply(1, status, priority, dueDate, createdAt, completedAt, asOf);
+}
+
+void StatsAccumulator::Add(const Task& task, const system_clock::time_point& asOf) {
+    Apply(1, task.GetStatus(), task.GetPriority(), task.GetDueDate(),
+          task.GetCreatedAt(), task.GetCompletedAt(), asOf);
+}
+
+void StatsAccumulator::Remove(Enums::TaskStatus status, Enums::Priority priority,
+                              const system_clock::time_point& dueDate,
+                              const system_clock::time_point& createdAt,
+                              const system_clock::time_point& completedAt,
+                              const system_clock::time_point& asOf) {
+    Apply(-1, status, priority, dueDate, createdAt, completedAt, asOf);
+}
+
+void StatsAccumulator::Apply(int sign, Enums::TaskStatus status, Enums::Priority priority,
+                             const system_clock::time_point& dueDate,
+                             const system_clock::time_point& createdAt,
+                             const system_clock::time_point& completedAt,
+                             const system_clock::time_point& asOf) {
+    totalTasks += sign;
+    byPriority[static_cast<size_t>(priority) & 3] += sign;
+    byStatus[static_cast<size_t>(status) & 3] += sign;
+    
+    if (status == Enums::TaskStatus::COMPLETED) {
+        completedTasks += sign;
+        if (HasCompletionTime(status, createdAt, completedAt)) {
+            timedCompletions += sign;
+            completionHoursSum += sign * CompletionHours(createdAt, completedAt);
+            completionTimes.Add(CompletionSeconds(createdAt, completedAt), sign);
+        }
+    } else if (status == Enums::TaskStatus::PENDING) {
+        pendingTasks += sign;
+    }
+    
+    if (IsOverdue(status, dueDate, asOf)) {
+        overdueTasks += sign;
+    }
+}
+
+void StatsAccumulator::Merge(const StatsAccumulator& other) {
+    totalTasks += other.totalTasks;
+    completedTasks += other.completedTasks;
+    overdueTasks += other.overdueTasks;
+    pendingTasks += other.pendingTasks;
+    timedCompletions += other.timedCompletions;
+    completionHoursSum += other.completionHoursSum;
+    completionTimes.Merge(other.completionTimes);
+    for (size_t i = 0; i < PRIORITY_COUNT; ++i) {
+        byPriority[i] += other.byPriority[i];
+    }
+    for (size_t i = 0; i < TASK_STATUS_COUNT; ++i) {
+        byStatus[i] += other.byStatus[i];
+    }
+}
+
+ProductivityStats StatsAccumulator::ToStats() const {
+    ProductivityStats stats;
+    stats.totalTasks = totalTasks;
+    stats.completedTasks = completedTasks;
+    stats.overdueTasks = overdueTasks;
+    stats.pendingTasks = pendingTasks;
+    stats.completionRate = totalTasks > 0
+        ? static_cast<double>(completedTasks) / totalTasks : 0.0;
+    stats.averageCompletionTimeHours = timedCompletions > 0
+        ? completionHoursSum / timedCompletions : 0.0;
+    stats.completionTimeP50Hours = completionTimes.Quantile(0.50) / 3600.0;
+    stats.completionTimeP90Hours = completionTimes.Quantile(0.90) / 3600.0;
+    stats.completionTimeP99Hours = completionTimes.Quantile(0.99) / 3600.0;
+    
+    // Only non-empty buckets, so reports do not list zero rows
+    for (size_t i = 0; i < PRIORITY_COUNT; ++i) {
+        if (byPriority[i] != 0) {
+            stats.tasksByPriority[static_cast<Enums::Priority>(i)] = byPriority[i];
+        }
+    }
+    for (size_t i = 0; i < TASK_STATUS_COUNT; ++i) {
+        if (byStatus[i] != 0) {
+            stats.tasksByStatus[static_cast<Enums::TaskStatus>(i)] = byStatus[i];
+        }
+    }
+    return stats;
+}
+
+bool StatsAccumulator::IsOverdue(Enums::TaskStatus status,
+                                 const system_clock::time_point& dueDate,
+                                 const system_clock::time_point& asOf) {
+    return status != Enums::TaskStatus::COMPLETED &&
+           status != Enums::TaskStatus::CANCELLED &&
+           dueDate < asOf;
+}
+
+bool StatsAccumulator::HasCompletionTime(Enums::TaskStatus status,
+                                         const system_clock::time_point& createdAt,
+                                         const system_clock::time_point& completedAt) {
+    return status == Enums::TaskStatus::COMPLETED &&
+           completedAt != system_clock::time_point::min() &&
+           completedAt >= createdAt;
+}
+
+int64_t StatsAccumulator::CompletionSeconds(const system_clock::time_point& createdAt,
+                                            const system_clock::time_point& completedAt) {
+    return duration_cast<seconds>(completedAt - createdAt).count();
+}
+
+double StatsAccumulator::CompletionHours(const system_clock::time_point& createdAt,
+                                         const system_clock::time_point& completedAt) {
+    return duration<double, std::ratio<3600>>(completedAt - createdAt).count();
+}
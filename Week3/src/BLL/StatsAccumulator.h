@@ -0,0 +1,63 @@
+#ifndef _STATSACCUMULATOR_H_
+#define _STATSACCUMULATOR_H_
+
+#include "../DTO/Task.h"
+#include "../BLL/LogHistogram.h"
+#include "../DTO/ProductivityStats.h"
+#include <array>
+#include <chrono>
+
+constexpr size_t PRIORITY_COUNT = 4;
+constexpr size_t TASK_STATUS_COUNT = 4;
+
+// Flat, enum-indexed counters for one pass over tasks.
+// Accumulators from different threads/chunks are combined with Merge().
+struct StatsAccumulator {
+    int totalTasks = 0;
+    int completedTasks = 0;
+    int overdueTasks = 0;
+    int pendingTasks = 0;
+    int timedCompletions = 0;            // Completed tasks with a valid completion time
+    double completionHoursSum = 0.0;
+    std::array<int, PRIORITY_COUNT> byPriority{};
+    std::array<int, TASK_STATUS_COUNT> byStatus{};
+    LogHistogram completionTimes;        // Seconds, for percentiles
+
+    // asOf: reference time for the overdue check
+    void Add(Enums::TaskStatus status, Enums::Priority priority,
+             const std::chrono::system_clock::time_point& dueDate,
+             const std::chrono::system_clock::time_point& createdAt,
+             const std::chrono::system_clock::time_point& completedAt,
+             const std::chrono::system_clock::time_point& asOf);
+    void Add(const Task& task, const std::chrono::system_clock::time_point& asOf);
+
+    // Undo a previous Add with the same arguments
+    void Remove(Enums::TaskStatus status, Enums::Priority priority,
+                const std::chrono::system_clock::time_point& dueDate,
+                const std::chrono::system_clock::time_point& createdAt,
+                const std::chrono::system_clock::time_point& completedAt,
+                const std::chrono::system_clock::time_point& asOf);
+
+    void Merge(const StatsAccumulator& other);
+    ProductivityStats ToStats() const;
+
+    static bool IsOverdue(Enums::TaskStatus status,
+                          const std::chrono::system_clock::time_point& dueDate,
+                          const std::chrono::system_clock::time_point& asOf);
+    static bool HasCompletionTime(Enums::TaskStatus status,
+                                  const std::chrono::system_clock::time_point& createdAt,
+                                  const std::chrono::system_clock::time_point& completedAt);
+    static int64_t CompletionSeconds(const std::chrono::system_clock::time_point& createdAt,
+                                     const std::chrono::system_clock::time_point& completedAt);
+    static double CompletionHours(const std::chrono::system_clock::time_point& createdAt,
+                                  const std::chrono::system_clock::time_point& completedAt);
+
+private:
+    void Apply(int sign, Enums::TaskStatus status, Enums::Priority priority,
+               const std::chrono::system_clock::time_point& dueDate,
+               const std::chrono::system_clock::time_point& createdAt,
+               const std::chrono::system_clock::time_point& completedAt,
+               const std::chrono::system_clock::time_point& asOf);
+};
+
+#endif // _STATSACCUMULATOR_H_
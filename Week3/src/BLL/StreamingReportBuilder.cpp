@@ -0,0 +1,525 @@
+#include "StreamingReportBuilder.h"
+#include "../LIB/DateUtils.h"
+#include "../LIB/Logger.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+namespace fs = std::filesystem;
+
+namespace {
+    // CSV column positions written by CSVDataManager::SerializeTask
+    constexpr size_t CSV_DUE_DATE = 3;
+    constexpr size_t CSV_CREATED_AT = 4;
+    constexpr size_t CSV_COMPLETED_AT = 6;
+    constexpr size_t CSV_PRIORITY = 7;
+    constexpr size_t CSV_STATUS = 8;
+    constexpr size_t CSV_CATEGORY_ID = 9;
+    constexpr size_t CSV_TAGS = 15;
+    constexpr size_t CSV_MIN_FIELDS = 16;
+
+    std::optional<Enums::Priority> ParsePriority(std::string_view text) {
+        if (text == "LOW") return Enums::Priority::LOW;
+        if (text == "MEDIUM") return Enums::Priority::MEDIUM;
+        if (text == "HIGH") return Enums::Priority::HIGH;
+        if (text == "URGENT") return Enums::Priority::URGENT;
+        try {
+            return Enums::StringToPriority(std::string(text)); // Other spellings
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Enums::TaskStatus> ParseStatus(std::string_view text) {
+        if (text == "PENDING") return Enums::TaskStatus::PENDING;
+        if (text == "IN_PROGRESS") return Enums::TaskStatus::IN_PROGRESS;
+        if (text == "COMPLETED") return Enums::TaskStatus::COMPLETED;
+        if (text == "CANCELLED") return Enums::TaskStatus::CANCELLED;
+        try {
+            return Enums::StringToTaskStatus(std::string(text));
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    bool ParseInt(std::string_view text, int& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    // Calls onLine(view) for every line that starts in [begin, end). The line
+    // straddling `begin` (or the header, when begin is 0) belongs to the
+    // previous range and is skipped.
+    template <typename OnLine>
+    bool ForEachLine(const std::string& filename, uint64_t begin, uint64_t end, OnLine onLine) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        
+        uint64_t offset = begin == 0 ? 0 : begin - 1;
+        file.seekg(static_cast<std::streamoff>(offset));
+        
+        std::vector<char> block(StreamingReportBuilder::BLOCK_SIZE);
+        std::string pending;       // Line carried over from the previous block
+        bool skipping = true;      // Inside the line before the range
+        uint64_t lineStart = offset;
+        
+        auto emit = [&](std::string_view line) {
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (!line.empty()) {
+                onLine(line);
+            }
+        };
+        
+        while (file && lineStart < end) {
+            file.read(block.data(), static_cast<std::streamsize>(block.size()));
+            size_t count = static_cast<size_t>(file.gcount());
+            if (count == 0) {
+                break;
+            }
+            
+            const char* data = block.data();
+            size_t pos = 0;
+            while (pos < count && lineStart < end) {
+                const char* newline = static_cast<const char*>(std::memchr(data + pos, '\n', count - pos));
+                size_t lineEnd = newline ? static_cast<size_t>(newline - data) : count;
+                
+                if (!newline) {
+                    if (!skipping) {
+                        pending.append(data + pos, lineEnd - pos);
+                    }
+                    offset += count - pos;
+                    pos = count;
+                    break;
+                }
+                
+                if (!skipping) {
+                    if (pending.empty()) {
+                        emit(std::string_view(data + pos, lineEnd - pos));
+                    } else {
+                        pending.append(data + pos, lineEnd - pos);
+                        emit(pending);
+                        pending.clear();
+                    }
+                }
+                skipping = false;
+                offset += lineEnd + 1 - pos;
+                lineStart = offset;
+                pos = lineEnd + 1;
+            }
+        }
+        
+        if (!skipping && !pending.empty() && lineStart < end) {
+            emit(pending); // Last line without a trailing newline
+        }
+        return true;
+    }
+
+    // Splits one CSV line into fields in place (quotes are kept); returns the
+    // number of fields, filling at most fields.size() views
+    template <size_t N>
+    size_t SplitCsv(std::string_view line, std::array<std::string_view, N>& fields) {
+        size_t count = 0;
+        size_t start = 0;
+        bool inQuotes = false;
+        for (size_t i = 0; i <= line.size(); ++i) {
+            if (i < line.size() && line[i] == '"') {
+                inQuotes = !inQuotes; // Doubled quotes toggle twice
+            } else if (i == line.size() || (line[i] == ',' && !inQuotes)) {
+                if (count < N) {
+                    fields[count] = line.substr(start, i - start);
+                }
+                ++count;
+                start = i + 1;
+            }
+        }
+        return count;
+    }
+
+    // Removes CSV quoting; only allocates when the field is quoted
+    std::string_view CsvValue(std::string_view field, std::string& storage) {
+        if (field.size() < 2 || field.front() != '"') {
+            return field;
+        }
+        field = field.substr(1, field.size() - 2);
+        if (field.find('"') == std::string_view::npos) {
+            return field;
+        }
+        storage.clear();
+        for (size_t i = 0; i < field.size(); ++i) {
+            storage += field[i];
+            if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+                ++i;
+            }
+        }
+        return storage;
+    }
+
+    // Index of the closing quote of the string starting at start (or size)
+    size_t JsonStringEnd(std::string_view text, size_t start) {
+        size_t end = start + 1;
+        while (end < text.size() && text[end] != '"') {
+            end += text[end] == '\\' ? 2 : 1;
+        }
+        return std::min(end, text.size());
+    }
+
+    // Start of the value of a top-level key in one serialized task object, or
+    // npos. Only keys of the outer object count, so a title equal to a key
+    // name or a nested field does not match.
+    size_t JsonValueStart(std::string_view object, std::string_view quotedKey) {
+        int depth = 0;
+        bool keyPosition = false;
+        for (size_t pos = 0; pos < object.size(); ++pos) {
+            char c = object[pos];
+            if (c == '"') {
+                size_t end = JsonStringEnd(object, pos);
+                if (depth == 1 && keyPosition) {
+                    keyPosition = false;
+                    size_t colon = end + 1;
+                    while (colon < object.size() && std::isspace(static_cast<unsigned char>(object[colon]))) {
+                        ++colon;
+                    }
+                    if (colon < object.size() && object[colon] == ':' &&
+                        object.substr(pos, end + 1 - pos) == quotedKey) {
+                        size_t value = colon + 1;
+                        while (value < object.size() && std::isspace(static_cast<unsigned char>(object[value]))) {
+                            ++value;
+                        }
+                        return value;
+                    }
+                }
+                pos = end;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+                keyPosition = depth == 1;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            } else if (c == ',') {
+                keyPosition = depth == 1;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    // Raw value of a top-level key: string contents without quotes, or the
+    // literal (number/null)
+    std::string_view JsonValue(std::string_view object, std::string_view quotedKey) {
+        size_t pos = JsonValueStart(object, quotedKey);
+        if (pos >= object.size()) {
+            return {};
+        }
+        
+        if (object[pos] == '"') {
+            return object.substr(pos + 1, JsonStringEnd(object, pos) - pos - 1);
+        }
+        
+        size_t end = pos;
+        while (end < object.size() && object[end] != ',' && object[end] != '\n' && object[end] != '}') {
+            ++end;
+        }
+        return object.substr(pos, end - pos);
+    }
+
+    std::string UnescapeJson(std::string_view text) {
+        std::string result;
+        result.reserve(text.size());
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] != '\\' || i + 1 >= text.size()) {
+                result += text[i];
+                continue;
+            }
+            switch (text[++i]) {
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                default:  result += text[i]; break;
+            }
+        }
+        return result;
+    }
+
+    // Shared by both readers once the fields are decoded
+    void AccumulateFields(Enums::TaskStatus status, Enums::Priority priority,
+                          const system_clock::time_point& dueDate,
+                          const system_clock::time_point& createdAt,
+                          const system_clock::time_point& completedAt,
+                          int categoryId,
+                          StatisticsManager::Partial& partial,
+                          const system_clock::time_point& asOf) {
+        partial.overall.Add(status, priority, dueDate, createdAt, completedAt, asOf);
+        if (categoryId > 0) {
+            partial.byCategory[categoryId].Add(status, priority, dueDate, createdAt, completedAt, asOf);
+        }
+    }
+}
+
+StreamingReportBuilder::Scan::Scan(const system_clock::time_point& start,
+                                   const system_clock::time_point& end,
+                                   const system_clock::time_point& now)
+    : startDate(start)
+    , endDate(end)
+    , asOf(std::min(now, end)) {
+}
+
+ProductivityReportPtr StreamingReportBuilder::BuildFromCsv(const std::string& filename,
+                                                           const system_clock::time_point& startDate,
+                                                           const system_clock::time_point& endDate,
+                                                           unsigned threadCount,
+                                                           const Clock& clock) {
+    std::error_code error;
+    uint64_t size = fs::file_size(filename, error);
+    if (error) {
+        LOG_ERROR("Failed to open file for streaming: " + filename);
+        return nullptr;
+    }
+    
+    if (threadCount == 0) {
+        threadCount = size < PARALLEL_THRESHOLD_BYTES ? 1u : std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    std::vector<Scan> scans(threadCount, Scan(startDate, endDate, clock.Now()));
+    std::vector<char> ok(threadCount, 0);
+    
+    uint64_t chunk = (size + threadCount - 1) / threadCount;
+    auto worker = [&](unsigned i) {
+        uint64_t begin = std::min<uint64_t>(size, i * chunk);
+        uint64_t end = std::min<uint64_t>(size, begin + chunk);
+        ok[i] = ScanCsvRange(filename, begin, i + 1 == threadCount ? size : end, scans[i]);
+    };
+    
+    if (threadCount == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned i = 0; i < threadCount; ++i) {
+            workers.emplace_back(worker, i);
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+    
+    for (unsigned i = 0; i < threadCount; ++i) {
+        if (!ok[i]) {
+            LOG_ERROR("Failed to read file for streaming: " + filename);
+            return nullptr;
+        }
+        if (i > 0) {
+            scans[0].partial.Merge(scans[i].partial);
+            scans[0].records += scans[i].records;
+            scans[0].skipped += scans[i].skipped;
+        }
+    }
+    return Finish(scans[0], filename);
+}
+
+ProductivityReportPtr StreamingReportBuilder::BuildFromJson(const std::string& filename,
+                                                            const system_clock::time_point& startDate,
+                                                            const system_clock::time_point& endDate,
+                                                            const Clock& clock) {
+    Scan scan(startDate, endDate, clock.Now());
+    if (!ScanJson(filename, scan)) {
+        LOG_ERROR("Failed to open file for streaming: " + filename);
+        return nullptr;
+    }
+    return Finish(scan, filename);
+}
+
+ProductivityReportPtr StreamingReportBuilder::BuildFromFile(const std::string& filename,
+                                                            const system_clock::time_point& startDate,
+                                                            const system_clock::time_point& endDate,
+                                                            unsigned threadCount,
+                                                            const Clock& clock) {
+    std::string extension = fs::path(filename).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    
+    if (extension == ".csv") {
+        return BuildFromCsv(filename, startDate, endDate, threadCount, clock);
+    }
+    if (extension == ".json") {
+        return BuildFromJson(filename, startDate, endDate, clock);
+    }
+    throw std::invalid_argument("Unsupported data file type: " + filename);
+}
+
+bool StreamingReportBuilder::ScanCsvRange(const std::string& filename, uint64_t begin, uint64_t end, Scan& scan) {
+    return ForEachLine(filename, begin, end, [&scan](std::string_view line) {
+        ++scan.records;
+        if (!AccumulateCsvRecord(line, scan)) {
+            ++scan.skipped;
+        }
+    });
+}
+
+bool StreamingReportBuilder::ScanJson(const std::string& filename, Scan& scan) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    // Top-level objects of the task array are collected one at a time
+    std::vector<char> block(BLOCK_SIZE);
+    std::string object;
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    
+    while (file) {
+        file.read(block.data(), static_cast<std::streamsize>(block.size()));
+        size_t count = static_cast<size_t>(file.gcount());
+        
+        for (size_t i = 0; i < count; ++i) {
+            char c = block[i];
+            if (depth > 0) {
+                object += c;
+            }
+            
+            if (inString) {
+                if (escaped) {
+                    escaped = false;
+                } else if (c == '\\') {
+                    escaped = true;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '{') {
+                if (depth++ == 0) {
+                    object.assign(1, c);
+                }
+            } else if (c == '}' && depth > 0) {
+                if (--depth == 0) {
+                    ++scan.records;
+                    if (!AccumulateJsonRecord(object, scan)) {
+                        ++scan.skipped;
+                    }
+                    object.clear();
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool StreamingReportBuilder::AccumulateCsvRecord(std::string_view line, Scan& scan) {
+    std::array<std::string_view, CSV_MIN_FIELDS> fields;
+    if (SplitCsv(line, fields) < CSV_MIN_FIELDS) {
+        return false;
+    }
+    
+    std::string storage;
+    system_clock::time_point createdAt;
+    if (!DateUtils::TryParseTimePoint(CsvValue(fields[CSV_CREATED_AT], storage), createdAt)) {
+        return false;
+    }
+    if (createdAt < scan.startDate || createdAt >= scan.endDate) {
+        return true; // Outside the window; nothing else to decode
+    }
+    
+    auto status = ParseStatus(CsvValue(fields[CSV_STATUS], storage));
+    auto priority = ParsePriority(CsvValue(fields[CSV_PRIORITY], storage));
+    system_clock::time_point dueDate;
+    if (!status || !priority || !DateUtils::TryParseTimePoint(CsvValue(fields[CSV_DUE_DATE], storage), dueDate)) {
+        return false;
+    }
+    
+    system_clock::time_point completedAt = system_clock::time_point::min();
+    if (*status == Enums::TaskStatus::COMPLETED &&
+        !DateUtils::TryParseTimePoint(CsvValue(fields[CSV_COMPLETED_AT], storage), completedAt)) {
+        return false;
+    }
+    
+    int categoryId = 0;
+    if (!ParseInt(fields[CSV_CATEGORY_ID], categoryId)) {
+        return false;
+    }
+    
+    AccumulateFields(*status, *priority, dueDate, createdAt, completedAt, categoryId, scan.partial, scan.asOf);
+    
+    std::string_view tags = CsvValue(fields[CSV_TAGS], storage);
+    while (!tags.empty()) {
+        size_t separator = tags.find(';');
+        std::string tag(tags.substr(0, separator));
+        if (!tag.empty()) {
+            scan.partial.topTags.Add(tag);
+            scan.partial.distinctTags.Add(tag);
+        }
+        tags = separator == std::string_view::npos ? std::string_view() : tags.substr(separator + 1);
+    }
+    return true;
+}
+
+bool StreamingReportBuilder::AccumulateJsonRecord(std::string_view object, Scan& scan) {
+    system_clock::time_point createdAt;
+    if (!DateUtils::TryParseTimePoint(JsonValue(object, "\"createdAt\""), createdAt)) {
+        return false;
+    }
+    if (createdAt < scan.startDate || createdAt >= scan.endDate) {
+        return true;
+    }
+    
+    auto status = ParseStatus(JsonValue(object, "\"status\""));
+    auto priority = ParsePriority(JsonValue(object, "\"priority\""));
+    system_clock::time_point dueDate;
+    if (!status || !priority || !DateUtils::TryParseTimePoint(JsonValue(object, "\"dueDate\""), dueDate)) {
+        return false;
+    }
+    
+    system_clock::time_point completedAt = system_clock::time_point::min();
+    if (*status == Enums::TaskStatus::COMPLETED &&
+        !DateUtils::TryParseTimePoint(JsonValue(object, "\"completedAt\""), completedAt)) {
+        return false;
+    }
+    
+    int categoryId = 0;
+    std::string_view category = JsonValue(object, "\"categoryId\"");
+    if (category != "null" && !ParseInt(category, categoryId)) {
+        return false;
+    }
+    
+    AccumulateFields(*status, *priority, dueDate, createdAt, completedAt, categoryId, scan.partial, scan.asOf);
+    
+    // "tags": ["a", "b"]
+    size_t pos = JsonValueStart(object, "\"tags\"");
+    if (pos < object.size() && object[pos] == '[') {
+        size_t i = pos + 1;
+        while (i < object.size() && object[i] != ']') {
+            if (object[i] != '"') {
+                ++i;
+                continue;
+            }
+            size_t end = JsonStringEnd(object, i);
+            std::string tag = UnescapeJson(object.substr(i + 1, end - i - 1));
+            scan.partial.topTags.Add(tag);
+            scan.partial.distinctTags.Add(tag);
+            i = end + 1;
+        }
+    }
+    return true;
+}
+
+ProductivityReportPtr StreamingReportBuilder::Finish(const Scan& scan, const std::string& filename) {
+    if (scan.skipped > 0) {
+        LOG_WARNING("Skipped " + std::to_string(scan.skipped) + " malformed records in " + filename);
+    }
+    LOG_INFO("Streamed " + std::to_string(scan.records) + " records from " + filename);
+    
+    auto report = std::make_shared<ProductivityReport>(scan.startDate, scan.endDate);
+    StatisticsManager::ToReport(scan.partial, *report);
+    return report;
+}
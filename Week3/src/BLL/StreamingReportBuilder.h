@@ -0,0 +1,60 @@
+#ifndef _STREAMINGREPORTBUILDER_H_
+#define _STREAMINGREPORTBUILDER_H_
+
+#include "../BLL/StatisticsManager.h"
+#include "../DTO/ProductivityReport.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Builds a ProductivityReport straight from a repository data file without
+// materializing tasks. Records are read in fixed-size blocks and only the
+// fields the stats use are decoded, so memory does not grow with the file.
+// Same window and overdue rules as StatisticsManager::BuildReport.
+class StreamingReportBuilder {
+public:
+    // CSV files can be split into byte ranges read by separate threads
+    // (threadCount = 0 picks the hardware count for files above the threshold)
+    static ProductivityReportPtr BuildFromCsv(const std::string& filename,
+                                              const std::chrono::system_clock::time_point& startDate,
+                                              const std::chrono::system_clock::time_point& endDate,
+                                              unsigned threadCount = 1,
+                                              const Clock& clock = Clock::GetInstance());
+    static ProductivityReportPtr BuildFromJson(const std::string& filename,
+                                               const std::chrono::system_clock::time_point& startDate,
+                                               const std::chrono::system_clock::time_point& endDate,
+                                               const Clock& clock = Clock::GetInstance());
+    // Picks the reader from the file extension (.csv or .json)
+    static ProductivityReportPtr BuildFromFile(const std::string& filename,
+                                               const std::chrono::system_clock::time_point& startDate,
+                                               const std::chrono::system_clock::time_point& endDate,
+                                               unsigned threadCount = 1,
+                                               const Clock& clock = Clock::GetInstance());
+
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+    // Below this size an automatic thread count reads with one thread
+    static constexpr uint64_t PARALLEL_THRESHOLD_BYTES = 8 << 20;
+
+private:
+    struct Scan {
+        std::chrono::system_clock::time_point startDate;
+        std::chrono::system_clock::time_point endDate;
+        std::chrono::system_clock::time_point asOf;
+        StatisticsManager::Partial partial;
+        size_t records = 0;
+        size_t skipped = 0; // Malformed records
+
+        Scan(const std::chrono::system_clock::time_point& start,
+             const std::chrono::system_clock::time_point& end,
+             const std::chrono::system_clock::time_point& now);
+    };
+
+    static bool ScanCsvRange(const std::string& filename, uint64_t begin, uint64_t end, Scan& scan);
+    static bool ScanJson(const std::string& filename, Scan& scan);
+    static bool AccumulateCsvRecord(std::string_view line, Scan& scan);
+    static bool AccumulateJsonRecord(std::string_view object, Scan& scan);
+    static ProductivityReportPtr Finish(const Scan& scan, const std::string& filename);
+};
+
+#endif // _STREAMINGREPORTBUILDER_H_
@@ -0,0 +1,177 @@
+#include "TaskBitmapIndex.h"
+#include <algorithm>
+
+// ITaskObserver
+void TaskBitmapIndex::OnTaskAdded(const TaskPtr& task) {
+    Posting posting{task->GetStatus(), task->GetPriority(), task->GetCategoryId(), task->GetTags()};
+    
+    auto it = ordinalByTask_.find(task->GetId());
+    if (it != ordinalByTask_.end()) {
+        Index(it->second, postings_[it->second], false);
+        postings_[it->second] = std::move(posting);
+        Index(it->second, postings_[it->second], true);
+        return;
+    }
+    
+    uint32_t ordinal;
+    if (!freeOrdinals_.empty()) {
+        ordinal = freeOrdinals_.back();
+        freeOrdinals_.pop_back();
+        taskByOrdinal_[ordinal] = task->GetId();
+        postings_[ordinal] = std::move(posting);
+    } else {
+        ordinal = static_cast<uint32_t>(taskByOrdinal_.size());
+        taskByOrdinal_.push_back(task->GetId());
+        postings_.push_back(std::move(posting));
+    }
+    ordinalByTask_.emplace(task->GetId(), ordinal);
+    Index(ordinal, postings_[ordinal], true);
+}
+
+void TaskBitmapIndex::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void TaskBitmapIndex::OnTaskRemoved(const TaskPtr& task) {
+    auto it = ordinalByTask_.find(task->GetId());
+    if (it == ordinalByTask_.end()) {
+        return;
+    }
+    uint32_t ordinal = it->second;
+    Index(ordinal, postings_[ordinal], false);
+    postings_[ordinal] = Posting();
+    taskByOrdinal_[ordinal] = 0;
+    freeOrdinals_.push_back(ordinal);
+    ordinalByTask_.erase(it);
+}
+
+size_t TaskBitmapIndex::Size() const {
+    return ordinalByTask_.size();
+}
+
+// Posting lists
+const RoaringBitmap& TaskBitmapIndex::All() const {
+    return all_;
+}
+
+const RoaringBitmap& TaskBitmapIndex::WithStatus(Enums::TaskStatus status) const {
+    return byStatus_.at(static_cast<size_t>(status));
+}
+
+const RoaringBitmap& TaskBitmapIndex::WithPriority(Enums::Priority priority) const {
+    return byPriority_.at(static_cast<size_t>(priority));
+}
+
+const RoaringBitmap& TaskBitmapIndex::WithCategory(int categoryId) const {
+    auto it = byCategory_.find(categoryId);
+    return it == byCategory_.end() ? Empty() : it->second;
+}
+
+const RoaringBitmap& TaskBitmapIndex::WithTag(const std::string& tag) const {
+    auto it = byTag_.find(tag);
+    return it == byTag_.end() ? Empty() : it->second;
+}
+
+// Filters
+RoaringBitmap TaskBitmapIndex::Evaluate(const TaskFilter& filter) const {
+    // Each group is an OR of posting lists; groups are intersected smallest first
+    std::vector<RoaringBitmap> groups;
+    auto addGroup = [&groups](const auto& values, auto&& lookup) {
+        if (values.empty()) {
+            return;
+        }
+        RoaringBitmap group;
+        for (const auto& value : values) {
+            group |= lookup(value);
+        }
+        groups.push_back(std::move(group));
+    };
+    
+    addGroup(filter.statuses, [this](Enums::TaskStatus status) -> const RoaringBitmap& { return WithStatus(status); });
+    addGroup(filter.priorities, [this](Enums::Priority priority) -> const RoaringBitmap& { return WithPriority(priority); });
+    addGroup(filter.categoryIds, [this](int categoryId) -> const RoaringBitmap& { return WithCategory(categoryId); });
+    addGroup(filter.anyTags, [this](const std::string& tag) -> const RoaringBitmap& { return WithTag(tag); });
+    for (const auto& tag : filter.allTags) {
+        groups.push_back(WithTag(tag));
+    }
+    
+    RoaringBitmap result;
+    if (groups.empty()) {
+        result = all_;
+    } else {
+        std::sort(groups.begin(), groups.end(), [](const RoaringBitmap& lhs, const RoaringBitmap& rhs) {
+            return lhs.Cardinality() < rhs.Cardinality();
+        });
+        result = std::move(groups.front());
+        for (size_t i = 1; i < groups.size() && !result.Empty(); ++i) {
+            result &= groups[i];
+        }
+    }
+    
+    for (const auto& tag : filter.excludedTags) {
+        result.AndNot(WithTag(tag));
+    }
+    return result;
+}
+
+std::vector<int> TaskBitmapIndex::ToTaskIds(const RoaringBitmap& ordinals) const {
+    std::vector<int> ids;
+    ids.reserve(ordinals.Cardinality());
+    ordinals.ForEach([&](uint32_t ordinal) {
+        if (ordinal < taskByOrdinal_.size() && taskByOrdinal_[ordinal] != 0) {
+            ids.push_back(taskByOrdinal_[ordinal]);
+        }
+    });
+    return ids;
+}
+
+std::vector<int> TaskBitmapIndex::Find(const TaskFilter& filter) const {
+    return ToTaskIds(Evaluate(filter));
+}
+
+int TaskBitmapIndex::GetOrdinal(int taskId) const {
+    auto it = ordinalByTask_.find(taskId);
+    return it == ordinalByTask_.end() ? -1 : static_cast<int>(it->second);
+}
+
+int TaskBitmapIndex::GetTaskId(uint32_t ordinal) const {
+    return ordinal < taskByOrdinal_.size() ? taskByOrdinal_[ordinal] : 0;
+}
+
+// Maintenance
+void TaskBitmapIndex::Index(uint32_t ordinal, const Posting& posting, bool add) {
+    auto apply = [ordinal, add](RoaringBitmap& bitmap) {
+        if (add) {
+            bitmap.Add(ordinal);
+        } else {
+            bitmap.Remove(ordinal);
+        }
+    };
+    
+    apply(all_);
+    apply(byStatus_.at(static_cast<size_t>(posting.status)));
+    apply(byPriority_.at(static_cast<size_t>(posting.priority)));
+    apply(byCategory_[posting.categoryId]); // 0 = uncategorized, as in TaskQuery::Matches
+    for (const auto& tag : posting.tags) {
+        apply(byTag_[tag]);
+    }
+    
+    // Drop empty lists so removed categories and tags do not accumulate
+    if (!add) {
+        auto category = byCategory_.find(posting.categoryId);
+        if (category != byCategory_.end() && category->second.Empty()) {
+            byCategory_.erase(category);
+        }
+        for (const auto& tag : posting.tags) {
+            auto it = byTag_.find(tag);
+            if (it != byTag_.end() && it->second.Empty()) {
+                byTag_.erase(it);
+            }
+        }
+    }
+}
+
+const RoaringBitmap& TaskBitmapIndex::Empty() {
+    static const RoaringBitmap empty;
+    return empty;
+}
@@ -0,0 +1,75 @@
+#ifndef _TASKBITMAPINDEX_H_
+#define _TASKBITMAPINDEX_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../BLL/StatsAccumulator.h"
+#include "../DTO/Enums.h"
+#include "../LIB/RoaringBitmap.h"
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Conjunction of attribute constraints; an empty list places no constraint.
+// Within one list values are alternatives (OR), except allTags.
+struct TaskFilter {
+    std::vector<Enums::TaskStatus> statuses;
+    std::vector<Enums::Priority> priorities;
+    std::vector<int> categoryIds;
+    std::vector<std::string> allTags;
+    std::vector<std::string> anyTags;
+    std::vector<std::string> excludedTags;
+};
+
+// Compressed bitmap posting lists over task ordinals for status, priority,
+// category and tag, maintained incrementally as a TaskService observer.
+// Ordinals are dense and reused after removal so the bitmaps stay compact.
+class TaskBitmapIndex : public ITaskObserver {
+public:
+    TaskBitmapIndex() = default;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    size_t Size() const;
+
+    // Posting lists (empty bitmap for unknown values)
+    const RoaringBitmap& All() const;
+    const RoaringBitmap& WithStatus(Enums::TaskStatus status) const;
+    const RoaringBitmap& WithPriority(Enums::Priority priority) const;
+    const RoaringBitmap& WithCategory(int categoryId) const; // 0 = uncategorized
+    const RoaringBitmap& WithTag(const std::string& tag) const;
+
+    RoaringBitmap Evaluate(const TaskFilter& filter) const;
+    std::vector<int> ToTaskIds(const RoaringBitmap& ordinals) const;
+    std::vector<int> Find(const TaskFilter& filter) const;
+
+    int GetOrdinal(int taskId) const; // -1 when absent
+    int GetTaskId(uint32_t ordinal) const;
+
+private:
+    struct Posting {
+        Enums::TaskStatus status = Enums::TaskStatus::PENDING;
+        Enums::Priority priority = Enums::Priority::LOW;
+        int categoryId = 0;
+        std::vector<std::string> tags;
+    };
+
+    RoaringBitmap all_;
+    std::array<RoaringBitmap, TASK_STATUS_COUNT> byStatus_;
+    std::array<RoaringBitmap, PRIORITY_COUNT> byPriority_;
+    std::unordered_map<int, RoaringBitmap> byCategory_;
+    std::unordered_map<std::string, RoaringBitmap> byTag_;
+
+    std::unordered_map<int, uint32_t> ordinalByTask_;
+    std::vector<int> taskByOrdinal_;     // 0 for free ordinals
+    std::vector<Posting> postings_;      // key: ordinal
+    std::vector<uint32_t> freeOrdinals_;
+
+    void Index(uint32_t ordinal, const Posting& posting, bool add);
+    static const RoaringBitmap& Empty();
+};
+
+#endif // _TASKBITMAPINDEX_H_
@@ -0,0 +1,308 @@
+#include "TaskEventStore.h"
+#include "../LIB/Varint.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+// ITaskObserver
+void TaskEventStore::OnTaskAdded(const TaskPtr& task) {
+    auto it = lastStatus_.find(task->GetId());
+    if (it != lastStatus_.end()) {
+        OnTaskUpdated(task); // Replayed task; only record a status change
+        return;
+    }
+    
+    bool completed = task->GetStatus() == Enums::TaskStatus::COMPLETED &&
+                     task->GetCompletedAt() != system_clock::time_point::min();
+    
+    TaskEvent event;
+    event.time = task->GetCreatedAt();
+    event.taskId = task->GetId();
+    event.categoryId = task->GetCategoryId();
+    event.created = true;
+    event.toStatus = completed ? Enums::TaskStatus::PENDING : task->GetStatus();
+    event.priority = task->GetPriority();
+    Append(event);
+    
+    if (completed) {
+        event.time = task->GetCompletedAt();
+        event.created = false;
+        event.fromStatus = Enums::TaskStatus::PENDING;
+        event.toStatus = Enums::TaskStatus::COMPLETED;
+        Append(event);
+    }
+    lastStatus_.emplace(task->GetId(), task->GetStatus());
+}
+
+void TaskEventStore::OnTaskUpdated(const TaskPtr& task) {
+    auto it = lastStatus_.find(task->GetId());
+    if (it == lastStatus_.end()) {
+        OnTaskAdded(task);
+        return;
+    }
+    if (it->second == task->GetStatus()) {
+        return;
+    }
+    
+    TaskEvent event;
+    bool completed = task->GetStatus() == Enums::TaskStatus::COMPLETED &&
+                     task->GetCompletedAt() != system_clock::time_point::min();
+    event.time = completed ? task->GetCompletedAt() : task->GetUpdatedAt();
+    event.taskId = task->GetId();
+    event.categoryId = task->GetCategoryId();
+    event.fromStatus = it->second;
+    event.toStatus = task->GetStatus();
+    event.priority = task->GetPriority();
+    Append(event);
+    it->second = task->GetStatus();
+}
+
+void TaskEventStore::OnTaskRemoved(const TaskPtr& task) {
+    // History is kept; only the live status snapshot goes
+    lastStatus_.erase(task->GetId());
+}
+
+void TaskEventStore::Append(const TaskEvent& event) {
+    active_.push_back(ToRaw(event));
+    ++eventCount_;
+    if (active_.size() >= BLOCK_EVENTS) {
+        Seal();
+    }
+}
+
+// Queries
+std::vector<TaskEvent> TaskEventStore::Scan(const system_clock::time_point& from,
+                                            const system_clock::time_point& to) const {
+    std::vector<TaskEvent> events;
+    ForEach(ToSeconds(from), ToSeconds(to),
+            [&events](const RawEvent& raw) { events.push_back(FromRaw(raw)); },
+            [](const Block&) { return false; });
+    return events;
+}
+
+std::vector<int> TaskEventStore::Downsample(const system_clock::time_point& from,
+                                            const system_clock::time_point& to,
+                                            TimeBucket bucket, Enums::TaskStatus status,
+                                            int categoryId) const {
+    int64_t start = ToSeconds(from);
+    int64_t end = ToSeconds(to);
+    int64_t width = static_cast<int64_t>(bucket);
+    if (start == INT64_MIN || end == INT64_MAX) {
+        throw std::invalid_argument("Downsampling needs a bounded time range");
+    }
+    if (end <= start) {
+        return {};
+    }
+    
+    std::vector<int> counts(static_cast<size_t>((end - start + width - 1) / width), 0);
+    size_t statusIndex = static_cast<size_t>(status);
+    
+    ForEach(start, end,
+            [&](const RawEvent& raw) {
+                if (ToStatus(raw) == status && !IsCreated(raw) &&
+                    (categoryId == 0 || raw.categoryId == categoryId)) {
+                    ++counts[static_cast<size_t>((raw.time - start) / width)];
+                }
+            },
+            [&](const Block& block) {
+                // A block within one bucket is counted from its header
+                if (categoryId != 0 || (block.minTime - start) / width != (block.maxTime - start) / width) {
+                    return false;
+                }
+                counts[static_cast<size_t>((block.minTime - start) / width)] += block.toStatusCounts[statusIndex];
+                return true;
+            });
+    return counts;
+}
+
+ProductivityStats TaskEventStore::GetActivityStats(const system_clock::time_point& from,
+                                                   const system_clock::time_point& to,
+                                                   int categoryId) const {
+    StatsAccumulator acc;
+    ForEach(ToSeconds(from), ToSeconds(to),
+            [&](const RawEvent& raw) {
+                if (categoryId != 0 && raw.categoryId != categoryId) {
+                    return;
+                }
+                if (IsCreated(raw)) {
+                    ++acc.totalTasks;
+                    ++acc.byPriority[(raw.flags >> 5) & 3];
+                } else {
+                    ++acc.byStatus[static_cast<size_t>(ToStatus(raw))];
+                }
+            },
+            [&](const Block& block) {
+                if (categoryId != 0) {
+                    return false;
+                }
+                for (size_t i = 0; i < PRIORITY_COUNT; ++i) {
+                    acc.totalTasks += static_cast<int>(block.createdByPriority[i]);
+                    acc.byPriority[i] += static_cast<int>(block.createdByPriority[i]);
+                }
+                for (size_t i = 0; i < TASK_STATUS_COUNT; ++i) {
+                    acc.byStatus[i] += static_cast<int>(block.toStatusCounts[i]);
+                }
+                return true;
+            });
+    acc.completedTasks = acc.byStatus[static_cast<size_t>(Enums::TaskStatus::COMPLETED)];
+    acc.pendingTasks = acc.byStatus[static_cast<size_t>(Enums::TaskStatus::PENDING)];
+    return acc.ToStats();
+}
+
+size_t TaskEventStore::GetEventCount() const {
+    return eventCount_;
+}
+
+size_t TaskEventStore::GetBlockCount() const {
+    return blocks_.size();
+}
+
+size_t TaskEventStore::GetEncodedBytes() const {
+    size_t bytes = active_.size() * sizeof(RawEvent);
+    for (const auto& block : blocks_) {
+        bytes += block.data.size() + sizeof(Block);
+    }
+    return bytes;
+}
+
+// Encoding
+void TaskEventStore::Seal() {
+    if (active_.empty()) {
+        return;
+    }
+    
+    Block block;
+    block.count = static_cast<uint32_t>(active_.size());
+    block.minTime = active_.front().time;
+    block.maxTime = active_.front().time;
+    block.data.reserve(active_.size() * 4);
+    
+    int64_t previousTime = 0;
+    int64_t previousDelta = 0;
+    int32_t previousTaskId = 0;
+    for (size_t i = 0; i < active_.size(); ++i) {
+        const RawEvent& raw = active_[i];
+        block.minTime = std::min(block.minTime, raw.time);
+        block.maxTime = std::max(block.maxTime, raw.time);
+        if (IsCreated(raw)) {
+            ++block.createdByPriority[(raw.flags >> 5) & 3];
+        } else {
+            ++block.toStatusCounts[(raw.flags >> 3) & 3];
+        }
+        
+        // First timestamp raw, then delta, then delta-of-delta
+        if (i == 0) {
+            Varint::EncodeSigned(raw.time, block.data);
+        } else {
+            int64_t delta = raw.time - previousTime;
+            Varint::EncodeSigned(i == 1 ? delta : delta - previousDelta, block.data);
+            previousDelta = delta;
+        }
+        previousTime = raw.time;
+        
+        Varint::EncodeSigned(static_cast<int64_t>(raw.taskId) - previousTaskId, block.data);
+        previousTaskId = raw.taskId;
+        Varint::Encode(static_cast<uint32_t>(raw.categoryId), block.data);
+        block.data.push_back(raw.flags);
+    }
+    
+    block.data.shrink_to_fit();
+    blocks_.push_back(std::move(block));
+    active_.clear();
+}
+
+std::vector<TaskEventStore::RawEvent> TaskEventStore::Decode(const Block& block) {
+    std::vector<RawEvent> events;
+    events.reserve(block.count);
+    
+    const uint8_t* pos = block.data.data();
+    const uint8_t* end = pos + block.data.size();
+    int64_t time = 0;
+    int64_t delta = 0;
+    int32_t taskId = 0;
+    for (uint32_t i = 0; i < block.count; ++i) {
+        if (i == 0) {
+            time = Varint::DecodeSigned(pos, end);
+        } else if (i == 1) {
+            delta = Varint::DecodeSigned(pos, end);
+            time += delta;
+        } else {
+            delta += Varint::DecodeSigned(pos, end);
+            time += delta;
+        }
+        
+        RawEvent raw;
+        raw.time = time;
+        taskId += static_cast<int32_t>(Varint::DecodeSigned(pos, end));
+        raw.taskId = taskId;
+        raw.categoryId = static_cast<int32_t>(Varint::Decode(pos, end));
+        raw.flags = *pos++;
+        events.push_back(raw);
+    }
+    return events;
+}
+
+template <typename OnEvent, typename OnBlock>
+void TaskEventStore::ForEach(int64_t from, int64_t to, OnEvent onEvent, OnBlock onBlock) const {
+    for (const auto& block : blocks_) {
+        if (block.maxTime < from || block.minTime >= to) {
+            continue; // No overlap
+        }
+        if (block.minTime >= from && block.maxTime < to && onBlock(block)) {
+            continue; // Answered from the header
+        }
+        for (const auto& raw : Decode(block)) {
+            if (raw.time >= from && raw.time < to) {
+                onEvent(raw);
+            }
+        }
+    }
+    for (const auto& raw : active_) {
+        if (raw.time >= from && raw.time < to) {
+            onEvent(raw);
+        }
+    }
+}
+
+TaskEventStore::RawEvent TaskEventStore::ToRaw(const TaskEvent& event) {
+    RawEvent raw;
+    raw.time = ToSeconds(event.time);
+    raw.taskId = event.taskId;
+    raw.categoryId = event.categoryId;
+    raw.flags = static_cast<uint8_t>((event.created ? 1 : 0) |
+                                     ((static_cast<int>(event.fromStatus) & 3) << 1) |
+                                     ((static_cast<int>(event.toStatus) & 3) << 3) |
+                                     ((static_cast<int>(event.priority) & 3) << 5));
+    return raw;
+}
+
+TaskEvent TaskEventStore::FromRaw(const RawEvent& raw) {
+    TaskEvent event;
+    event.time = system_clock::time_point(seconds(raw.time));
+    event.taskId = raw.taskId;
+    event.categoryId = raw.categoryId;
+    event.created = IsCreated(raw);
+    event.fromStatus = static_cast<Enums::TaskStatus>((raw.flags >> 1) & 3);
+    event.toStatus = ToStatus(raw);
+    event.priority = static_cast<Enums::Priority>((raw.flags >> 5) & 3);
+    return event;
+}
+
+int64_t TaskEventStore::ToSeconds(const system_clock::time_point& time) {
+    if (time == system_clock::time_point::min()) {
+        return INT64_MIN;
+    }
+    if (time == system_clock::time_point::max()) {
+        return INT64_MAX;
+    }
+    return floor<seconds>(time.time_since_epoch()).count();
+}
+
+Enums::TaskStatus TaskEventStore::ToStatus(const RawEvent& raw) {
+    return static_cast<Enums::TaskStatus>((raw.flags >> 3) & 3);
+}
+
+bool TaskEventStore::IsCreated(const RawEvent& raw) {
+    return (raw.flags & 1) != 0;
+}
@@ -0,0 +1,106 @@
+#ifndef _TASKEVENTSTORE_H_
+#define _TASKEVENTSTORE_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../BLL/StatsAccumulator.h"
+#include "../DTO/ProductivityStats.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// A status transition. For newly added tasks `created` is set and
+// fromStatus is meaningless.
+struct TaskEvent {
+    std::chrono::system_clock::time_point time;
+    int taskId = 0;
+    int categoryId = 0;
+    bool created = false;
+    Enums::TaskStatus fromStatus = Enums::TaskStatus::PENDING;
+    Enums::TaskStatus toStatus = Enums::TaskStatus::PENDING;
+    Enums::Priority priority = Enums::Priority::LOW;
+};
+
+enum class TimeBucket {
+    HOUR = 3600,
+    DAY = 86400,
+    WEEK = 604800
+};
+
+// Append-only history of task status transitions, recorded as a
+// TaskService observer at the task's update time (second precision).
+// Tasks that arrive already completed also get a completion event at
+// their completedAt, so loaded data contributes to completion trends.
+// Events are packed into blocks: timestamps as delta-of-delta varints,
+// IDs as deltas, statuses in one byte. Each sealed block keeps its min/max
+// time and per-status counts, so range queries skip or aggregate whole
+// blocks without decoding them.
+class TaskEventStore : public ITaskObserver {
+public:
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    void Append(const TaskEvent& event);
+
+    // Events with time in [from, to), in append order
+    std::vector<TaskEvent> Scan(const std::chrono::system_clock::time_point& from,
+                                const std::chrono::system_clock::time_point& to) const;
+    // Transitions into `status` per bucket; bucket i covers
+    // [from + i * bucket, from + (i + 1) * bucket). categoryId 0 = all.
+    std::vector<int> Downsample(const std::chrono::system_clock::time_point& from,
+                                const std::chrono::system_clock::time_point& to,
+                                TimeBucket bucket, Enums::TaskStatus status,
+                                int categoryId = 0) const;
+    // Activity in [from, to): totalTasks = tasks added, tasksByStatus =
+    // transitions into each status, completedTasks/pendingTasks follow
+    // those transitions. Completion times and overdue are not derived.
+    ProductivityStats GetActivityStats(const std::chrono::system_clock::time_point& from,
+                                       const std::chrono::system_clock::time_point& to,
+                                       int categoryId = 0) const;
+
+    size_t GetEventCount() const;
+    size_t GetBlockCount() const; // Sealed blocks
+    size_t GetEncodedBytes() const;
+
+    static constexpr size_t BLOCK_EVENTS = 1024;
+
+private:
+    struct RawEvent {
+        int64_t time;   // Seconds since epoch
+        int32_t taskId;
+        int32_t categoryId;
+        uint8_t flags;  // created | from << 1 | to << 3 | priority << 5
+    };
+
+    struct Block {
+        int64_t minTime = 0;
+        int64_t maxTime = 0;
+        uint32_t count = 0;
+        std::array<uint32_t, TASK_STATUS_COUNT> toStatusCounts{};
+        std::array<uint32_t, PRIORITY_COUNT> createdByPriority{};
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<Block> blocks_;
+    std::vector<RawEvent> active_; // Unsealed tail
+    std::unordered_map<int, Enums::TaskStatus> lastStatus_; // key: task ID
+    size_t eventCount_ = 0;
+
+    void Seal();
+    static std::vector<RawEvent> Decode(const Block& block);
+    // Calls fn(rawEvent) for events overlapping [from, to); blocks entirely
+    // inside the range go to onBlock when it accepts them
+    template <typename OnEvent, typename OnBlock>
+    void ForEach(int64_t from, int64_t to, OnEvent onEvent, OnBlock onBlock) const;
+
+    static RawEvent ToRaw(const TaskEvent& event);
+    static TaskEvent FromRaw(const RawEvent& raw);
+    static int64_t ToSeconds(const std::chrono::system_clock::time_point& time);
+    static Enums::TaskStatus ToStatus(const RawEvent& raw);
+    static bool IsCreated(const RawEvent& raw);
+};
+
+#endif // _TASKEVENTSTORE_H_
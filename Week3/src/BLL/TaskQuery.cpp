@@ -0,0 +1,645 @@
+#include "TaskQuery.h"
+#include "../DTO/Enums.h"
+#include "../LIB/DateUtils.h"
+#include "../LIB/StringUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+    enum class TokenType {
+        IDENT,
+        NUMBER,
+        STRING,
+        SYMBOL,
+        END
+    };
+
+    struct Token {
+        TokenType type = TokenType::END;
+        std::string text;
+        size_t position = 0;
+    };
+
+    std::vector<Token> Lex(const std::string& text) {
+        std::vector<Token> tokens;
+        size_t i = 0;
+        while (i < text.size()) {
+            unsigned char ch = static_cast<unsigned char>(text[i]);
+            if (std::isspace(ch)) {
+                ++i;
+                continue;
+            }
+            
+            Token token;
+            token.position = i;
+            if (std::isalpha(ch) || ch == '_') {
+                token.type = TokenType::IDENT;
+                while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_')) {
+                    token.text += text[i++];
+                }
+            } else if (std::isdigit(ch)) {
+                // Digits with an optional unit suffix, e.g. 7d
+                token.type = TokenType::NUMBER;
+                while (i < text.size() && std::isalnum(static_cast<unsigned char>(text[i]))) {
+                    token.text += text[i++];
+                }
+            } else if (ch == '"') {
+                token.type = TokenType::STRING;
+                ++i;
+                while (i < text.size() && text[i] != '"') {
+                    if (text[i] == '\\' && i + 1 < text.size()) {
+                        ++i;
+                    }
+                    token.text += text[i++];
+                }
+                if (i == text.size()) {
+                    throw std::invalid_argument("Unterminated string at position " + std::to_string(token.position));
+                }
+                ++i;
+            } else {
+                token.type = TokenType::SYMBOL;
+                static const char* const twoChar[] = {"!=", "<=", ">="};
+                for (const char* symbol : twoChar) {
+                    if (text.compare(i, 2, symbol) == 0) {
+                        token.text = symbol;
+                    }
+                }
+                if (token.text.empty()) {
+                    if (std::string("(),=<>+-").find(static_cast<char>(ch)) == std::string::npos) {
+                        throw std::invalid_argument("Unexpected character '" + std::string(1, static_cast<char>(ch)) +
+                                                    "' at position " + std::to_string(i));
+                    }
+                    token.text = std::string(1, static_cast<char>(ch));
+                }
+                i += token.text.size();
+            }
+            tokens.push_back(std::move(token));
+        }
+        tokens.push_back(Token{TokenType::END, "", text.size()});
+        return tokens;
+    }
+
+    const char* FieldName(QueryField field) {
+        switch (field) {
+            case QueryField::ID: return "id";
+            case QueryField::STATUS: return "status";
+            case QueryField::PRIORITY: return "priority";
+            case QueryField::CATEGORY: return "category";
+            case QueryField::TAG: return "tag";
+            case QueryField::DUE: return "due";
+            case QueryField::CREATED: return "created";
+            case QueryField::COMPLETED: return "completed";
+            case QueryField::TITLE: return "title";
+        }
+        return "";
+    }
+
+    const char* OpName(QueryOp op) {
+        switch (op) {
+            case QueryOp::EQ: return "=";
+            case QueryOp::NE: return "!=";
+            case QueryOp::LT: return "<";
+            case QueryOp::LE: return "<=";
+            case QueryOp::GT: return ">";
+            case QueryOp::GE: return ">=";
+            case QueryOp::IN: return "in";
+            case QueryOp::CONTAINS: return "contains";
+        }
+        return "";
+    }
+
+    bool IsDateField(QueryField field) {
+        return field == QueryField::DUE || field == QueryField::CREATED || field == QueryField::COMPLETED;
+    }
+
+    template <typename T>
+    bool CompareValues(const T& lhs, const T& rhs, QueryOp op) {
+        switch (op) {
+            case QueryOp::EQ: return lhs == rhs;
+            case QueryOp::NE: return lhs != rhs;
+            case QueryOp::LT: return lhs < rhs;
+            case QueryOp::LE: return lhs <= rhs;
+            case QueryOp::GT: return lhs > rhs;
+            case QueryOp::GE: return lhs >= rhs;
+            default: return false;
+        }
+    }
+
+    class Parser {
+    public:
+        explicit Parser(const std::string& text) : tokens_(Lex(text)) {}
+
+        void ParseQuery(bool& hasFilter, QueryNode& filter, std::vector<QueryOrder>& order, size_t& limit) {
+            hasFilter = !IsKeyword("order") && !IsKeyword("limit") && Peek().type != TokenType::END;
+            if (hasFilter) {
+                filter = ParseOr();
+            }
+            if (AcceptKeyword("order")) {
+                ExpectKeyword("by");
+                do {
+                    QueryOrder key;
+                    key.field = ParseField();
+                    if (AcceptKeyword("desc")) {
+                        key.descending = true;
+                    } else {
+                        AcceptKeyword("asc");
+                    }
+                    order.push_back(key);
+                } while (AcceptSymbol(","));
+            }
+            if (AcceptKeyword("limit")) {
+                limit = static_cast<size_t>(ParseInteger());
+                if (limit == 0) {
+                    Fail("Limit must be positive");
+                }
+            }
+            if (Peek().type != TokenType::END) {
+                Fail("Unexpected '" + Peek().text + "'");
+            }
+        }
+
+    private:
+        std::vector<Token> tokens_;
+        size_t pos_ = 0;
+
+        const Token& Peek() const { return tokens_[pos_]; }
+        const Token& Next() { return tokens_[pos_ == tokens_.size() - 1 ? pos_ : pos_++]; }
+
+        [[noreturn]] void Fail(const std::string& message) const {
+            throw std::invalid_argument(message + " at position " + std::to_string(Peek().position));
+        }
+
+        bool IsKeyword(const char* keyword) const {
+            return Peek().type == TokenType::IDENT && StringUtils::ToLower(Peek().text) == keyword;
+        }
+
+        bool AcceptKeyword(const char* keyword) {
+            if (IsKeyword(keyword)) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        void ExpectKeyword(const char* keyword) {
+            if (!AcceptKeyword(keyword)) {
+                Fail(std::string("Expected '") + keyword + "'");
+            }
+        }
+
+        bool AcceptSymbol(const char* symbol) {
+            if (Peek().type == TokenType::SYMBOL && Peek().text == symbol) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        void ExpectSymbol(const char* symbol) {
+            if (!AcceptSymbol(symbol)) {
+                Fail(std::string("Expected '") + symbol + "'");
+            }
+        }
+
+        QueryNode ParseOr() {
+            QueryNode first = ParseAnd();
+            if (!IsKeyword("or")) {
+                return first;
+            }
+            QueryNode node;
+            node.kind = QueryNode::Kind::OR;
+            node.children.push_back(std::move(first));
+            while (AcceptKeyword("or")) {
+                node.children.push_back(ParseAnd());
+            }
+            return node;
+        }
+
+        QueryNode ParseAnd() {
+            QueryNode first = ParseUnary();
+            if (!IsKeyword("and")) {
+                return first;
+            }
+            QueryNode node;
+            node.kind = QueryNode::Kind::AND;
+            node.children.push_back(std::move(first));
+            while (AcceptKeyword("and")) {
+                node.children.push_back(ParseUnary());
+            }
+            return node;
+        }
+
+        QueryNode ParseUnary() {
+            if (AcceptKeyword("not")) {
+                QueryNode node;
+                node.kind = QueryNode::Kind::NOT;
+                node.children.push_back(ParseUnary());
+                return node;
+            }
+            if (AcceptSymbol("(")) {
+                QueryNode node = ParseOr();
+                ExpectSymbol(")");
+                return node;
+            }
+            QueryNode node;
+            node.predicate = ParsePredicate();
+            return node;
+        }
+
+        QueryField ParseField() {
+            static const QueryField fields[] = {
+                QueryField::ID, QueryField::STATUS, QueryField::PRIORITY, QueryField::CATEGORY, QueryField::TAG,
+                QueryField::DUE, QueryField::CREATED, QueryField::COMPLETED, QueryField::TITLE
+            };
+            for (QueryField field : fields) {
+                if (AcceptKeyword(FieldName(field))) {
+                    return field;
+                }
+            }
+            Fail("Unknown field '" + Peek().text + "'");
+        }
+
+        QueryOp ParseOp() {
+            static const QueryOp symbols[] = {QueryOp::EQ, QueryOp::NE, QueryOp::LT, QueryOp::LE, QueryOp::GT, QueryOp::GE};
+            for (QueryOp op : symbols) {
+                if (AcceptSymbol(OpName(op))) {
+                    return op;
+                }
+            }
+            if (AcceptKeyword("in")) {
+                return QueryOp::IN;
+            }
+            if (AcceptKeyword("contains")) {
+                return QueryOp::CONTAINS;
+            }
+            Fail("Expected an operator");
+        }
+
+        int64_t ParseInteger() {
+            bool negative = AcceptSymbol("-");
+            if (Peek().type != TokenType::NUMBER ||
+                !std::all_of(Peek().text.begin(), Peek().text.end(), [](char ch) { return std::isdigit(static_cast<unsigned char>(ch)); })) {
+                Fail("Expected a number");
+            }
+            int64_t value = std::stoll(Next().text);
+            return negative ? -value : value;
+        }
+
+        std::string ParseWord() {
+            if (Peek().type != TokenType::IDENT && Peek().type != TokenType::STRING) {
+                Fail("Expected a name or string");
+            }
+            return Next().text;
+        }
+
+        QueryTime ParseTime() {
+            QueryTime time;
+            if (Peek().type == TokenType::STRING) {
+                std::string text = Peek().text;
+                if (text.size() == 10) {
+                    text += " 00:00:00";
+                }
+                system_clock::time_point point;
+                if (!DateUtils::TryParseTimePoint(text, point)) {
+                    Fail("Invalid date \"" + Peek().text + "\"");
+                }
+                ++pos_;
+                time.relative = false;
+                time.seconds = floor<seconds>(point.time_since_epoch()).count();
+                return time;
+            }
+            
+            if (AcceptKeyword("today")) {
+                time.startOfDay = true;
+            } else {
+                ExpectKeyword("now");
+            }
+            int sign = AcceptSymbol("+") ? 1 : AcceptSymbol("-") ? -1 : 0;
+            if (sign == 0) {
+                return time;
+            }
+            if (Peek().type != TokenType::NUMBER) {
+                Fail("Expected a duration");
+            }
+            const std::string& text = Peek().text;
+            size_t digits = 0;
+            while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits]))) {
+                ++digits;
+            }
+            static const std::pair<const char*, int64_t> units[] = {
+                {"s", 1}, {"m", 60}, {"h", 3600}, {"d", 86400}, {"w", 7 * 86400}
+            };
+            std::string unit = StringUtils::ToLower(text.substr(digits));
+            for (const auto& [name, scale] : units) {
+                if (unit == name) {
+                    time.seconds = sign * std::stoll(text.substr(0, digits)) * scale;
+                    ++pos_;
+                    return time;
+                }
+            }
+            Fail("Expected a duration unit (s, m, h, d or w)");
+        }
+
+        void ParseValue(QueryPredicate& predicate) {
+            switch (predicate.field) {
+                case QueryField::ID:
+                case QueryField::CATEGORY:
+                    predicate.numbers.push_back(ParseInteger());
+                    break;
+                case QueryField::STATUS:
+                case QueryField::PRIORITY:
+                    try {
+                        std::string name = ParseWord();
+                        predicate.numbers.push_back(predicate.field == QueryField::STATUS
+                            ? static_cast<int64_t>(Enums::StringToTaskStatus(name))
+                            : static_cast<int64_t>(Enums::StringToPriority(name)));
+                    } catch (const std::invalid_argument& e) {
+                        --pos_;
+                        Fail(e.what());
+                    }
+                    break;
+                case QueryField::TAG:
+                case QueryField::TITLE:
+                    predicate.strings.push_back(ParseWord());
+                    break;
+                default:
+                    predicate.time = ParseTime();
+                    break;
+            }
+        }
+
+        QueryPredicate ParsePredicate() {
+            QueryPredicate predicate;
+            predicate.field = ParseField();
+            predicate.op = ParseOp();
+            
+            bool valid = true;
+            if (predicate.op == QueryOp::CONTAINS) {
+                valid = predicate.field == QueryField::TITLE;
+            } else if (predicate.op == QueryOp::IN) {
+                valid = !IsDateField(predicate.field) && predicate.field != QueryField::TITLE;
+            } else if (predicate.op != QueryOp::EQ && predicate.op != QueryOp::NE) {
+                valid = predicate.field != QueryField::TAG && predicate.field != QueryField::TITLE;
+            }
+            if (!valid) {
+                --pos_;
+                Fail(std::string("Operator '") + OpName(predicate.op) + "' does not apply to " + FieldName(predicate.field));
+            }
+            
+            if (predicate.op == QueryOp::IN) {
+                ExpectSymbol("(");
+                do {
+                    ParseValue(predicate);
+                } while (AcceptSymbol(","));
+                ExpectSymbol(")");
+            } else {
+                ParseValue(predicate);
+            }
+            return predicate;
+        }
+    };
+
+    bool MatchesPredicate(const QueryPredicate& predicate, const Task& task, const QueryTimes& times) {
+        auto matchNumber = [&predicate](int64_t value) {
+            if (predicate.op == QueryOp::IN) {
+                return std::find(predicate.numbers.begin(), predicate.numbers.end(), value) != predicate.numbers.end();
+            }
+            return CompareValues(value, predicate.numbers.front(), predicate.op);
+        };
+        
+        switch (predicate.field) {
+            case QueryField::ID:
+                return matchNumber(task.GetId());
+            case QueryField::STATUS:
+                return matchNumber(static_cast<int64_t>(task.GetStatus()));
+            case QueryField::PRIORITY:
+                return matchNumber(static_cast<int64_t>(task.GetPriority()));
+            case QueryField::CATEGORY:
+                return matchNumber(task.GetCategoryId());
+            case QueryField::TAG: {
+                const auto& tags = task.GetTags();
+                bool found = std::any_of(predicate.strings.begin(), predicate.strings.end(), [&tags](const std::string& tag) {
+                    return std::find(tags.begin(), tags.end(), tag) != tags.end();
+                });
+                return predicate.op == QueryOp::NE ? !found : found;
+            }
+            case QueryField::TITLE: {
+                std::string title = StringUtils::ToLower(task.GetTitle());
+                std::string text = StringUtils::ToLower(predicate.strings.front());
+                if (predicate.op == QueryOp::CONTAINS) {
+                    return title.find(text) != std::string::npos;
+                }
+                return CompareValues(title, text, predicate.op);
+            }
+            case QueryField::DUE:
+                return CompareValues(task.GetDueDate(), times.Get(predicate.time), predicate.op);
+            case QueryField::CREATED:
+                return CompareValues(task.GetCreatedAt(), times.Get(predicate.time), predicate.op);
+            case QueryField::COMPLETED:
+                // Only tasks with a completion time take part in completion comparisons
+                return task.GetStatus() == Enums::TaskStatus::COMPLETED &&
+                       task.GetCompletedAt() != system_clock::time_point::min() &&
+                       CompareValues(task.GetCompletedAt(), times.Get(predicate.time), predicate.op);
+        }
+        return false;
+    }
+
+    std::string DescribeTime(const QueryTime& time) {
+        if (!time.relative) {
+            return "\"" + DateUtils::TimePointToString(system_clock::time_point(seconds(time.seconds))) + "\"";
+        }
+        const std::string anchor = time.startOfDay ? "today" : "now";
+        if (time.seconds == 0) {
+            return anchor;
+        }
+        static const std::pair<const char*, int64_t> units[] = {
+            {"w", 7 * 86400}, {"d", 86400}, {"h", 3600}, {"m", 60}, {"s", 1}
+        };
+        int64_t magnitude = time.seconds < 0 ? -time.seconds : time.seconds;
+        for (const auto& [name, scale] : units) {
+            if (magnitude % scale == 0) {
+                return anchor + (time.seconds < 0 ? "-" : "+") + std::to_string(magnitude / scale) + name;
+            }
+        }
+        return anchor;
+    }
+
+    std::string DescribeValue(const QueryPredicate& predicate, size_t index) {
+        switch (predicate.field) {
+            case QueryField::STATUS:
+                return Enums::TaskStatusToString(static_cast<Enums::TaskStatus>(predicate.numbers[index]));
+            case QueryField::PRIORITY:
+                return Enums::PriorityToString(static_cast<Enums::Priority>(predicate.numbers[index]));
+            case QueryField::ID:
+            case QueryField::CATEGORY:
+                return std::to_string(predicate.numbers[index]);
+            case QueryField::TAG:
+            case QueryField::TITLE:
+                return "\"" + predicate.strings[index] + "\"";
+            default:
+                return DescribeTime(predicate.time);
+        }
+    }
+}
+
+system_clock::time_point QueryTime::Resolve(const system_clock::time_point& now) const {
+    if (!relative) {
+        return system_clock::time_point(std::chrono::seconds(seconds));
+    }
+    if (!startOfDay) {
+        return now + std::chrono::seconds(seconds);
+    }
+    // Whole days step the calendar, so today+1d is the next local midnight even across DST
+    auto days = static_cast<int>(seconds / 86400);
+    return DateUtils::AddCalendarDays(DateUtils::StartOfDay(now), days) + std::chrono::seconds(seconds % 86400);
+}
+
+QueryTimes::QueryTimes(const QueryNode& node, const system_clock::time_point& now) : now_(now) {
+    Collect(node);
+}
+
+system_clock::time_point QueryTimes::Get(const QueryTime& time) const {
+    for (const auto& [source, resolved] : resolved_) {
+        if (source == &time) {
+            return resolved;
+        }
+    }
+    return time.Resolve(now_);
+}
+
+void QueryTimes::Collect(const QueryNode& node) {
+    for (const auto& child : node.children) {
+        Collect(child);
+    }
+    if (node.kind == QueryNode::Kind::PREDICATE && node.predicate.time.relative) {
+        resolved_.emplace_back(&node.predicate.time, node.predicate.time.Resolve(now_));
+    }
+}
+
+TaskQuery TaskQuery::Parse(const std::string& text) {
+    TaskQuery query;
+    query.text_ = text;
+    Parser(text).ParseQuery(query.hasFilter_, query.filter_, query.order_, query.limit_);
+    return query;
+}
+
+bool TaskQuery::HasFilter() const {
+    return hasFilter_;
+}
+
+const QueryNode& TaskQuery::GetFilter() const {
+    return filter_;
+}
+
+const std::vector<QueryOrder>& TaskQuery::GetOrder() const {
+    return order_;
+}
+
+size_t TaskQuery::GetLimit() const {
+    return limit_;
+}
+
+const std::string& TaskQuery::GetText() const {
+    return text_;
+}
+
+bool TaskQuery::Matches(const QueryNode& node, const Task& task, const system_clock::time_point& now) {
+    return Matches(node, task, QueryTimes(node, now));
+}
+
+bool TaskQuery::Matches(const QueryNode& node, const Task& task, const QueryTimes& times) {
+    switch (node.kind) {
+        case QueryNode::Kind::AND:
+            return std::all_of(node.children.begin(), node.children.end(),
+                               [&](const QueryNode& child) { return Matches(child, task, times); });
+        case QueryNode::Kind::OR:
+            return std::any_of(node.children.begin(), node.children.end(),
+                               [&](const QueryNode& child) { return Matches(child, task, times); });
+        case QueryNode::Kind::NOT:
+            return !Matches(node.children.front(), task, times);
+        case QueryNode::Kind::PREDICATE:
+            return MatchesPredicate(node.predicate, task, times);
+    }
+    return false;
+}
+
+int TaskQuery::Compare(const std::vector<QueryOrder>& order, const Task& lhs, const Task& rhs) {
+    auto compare = [](const auto& a, const auto& b) { return a < b ? -1 : (b < a ? 1 : 0); };
+    for (const auto& key : order) {
+        int result = 0;
+        switch (key.field) {
+            case QueryField::ID: result = compare(lhs.GetId(), rhs.GetId()); break;
+            case QueryField::STATUS: result = compare(lhs.GetStatus(), rhs.GetStatus()); break;
+            case QueryField::PRIORITY: result = compare(lhs.GetPriority(), rhs.GetPriority()); break;
+            case QueryField::CATEGORY: result = compare(lhs.GetCategoryId(), rhs.GetCategoryId()); break;
+            case QueryField::TAG: result = compare(lhs.GetTags(), rhs.GetTags()); break;
+            case QueryField::DUE: result = compare(lhs.GetDueDate(), rhs.GetDueDate()); break;
+            case QueryField::CREATED: result = compare(lhs.GetCreatedAt(), rhs.GetCreatedAt()); break;
+            case QueryField::COMPLETED: result = compare(lhs.GetCompletedAt(), rhs.GetCompletedAt()); break;
+            case QueryField::TITLE: result = compare(lhs.GetTitle(), rhs.GetTitle()); break;
+        }
+        if (result != 0) {
+            return key.descending ? -result : result;
+        }
+    }
+    return compare(lhs.GetId(), rhs.GetId());
+}
+
+int64_t TaskQuery::OrderValue(const Task& task, QueryField field) {
+    switch (field) {
+        case QueryField::ID: return task.GetId();
+        case QueryField::STATUS: return static_cast<int64_t>(task.GetStatus());
+        case QueryField::PRIORITY: return static_cast<int64_t>(task.GetPriority());
+        case QueryField::CATEGORY: return task.GetCategoryId();
+        case QueryField::DUE: return task.GetDueDate().time_since_epoch().count();
+        case QueryField::CREATED: return task.GetCreatedAt().time_since_epoch().count();
+        case QueryField::COMPLETED: return task.GetCompletedAt().time_since_epoch().count();
+        default: return 0;
+    }
+}
+
+std::string TaskQuery::Describe(const QueryNode& node) {
+    switch (node.kind) {
+        case QueryNode::Kind::AND:
+        case QueryNode::Kind::OR: {
+            std::string text;
+            for (const auto& child : node.children) {
+                if (!text.empty()) {
+                    text += node.kind == QueryNode::Kind::AND ? " and " : " or ";
+                }
+                bool wrap = child.kind == QueryNode::Kind::AND || child.kind == QueryNode::Kind::OR;
+                text += wrap ? "(" + Describe(child) + ")" : Describe(child);
+            }
+            return text;
+        }
+        case QueryNode::Kind::NOT: {
+            const QueryNode& child = node.children.front();
+            return child.kind == QueryNode::Kind::PREDICATE ? "not " + Describe(child) : "not (" + Describe(child) + ")";
+        }
+        case QueryNode::Kind::PREDICATE: {
+            const QueryPredicate& predicate = node.predicate;
+            std::string text = std::string(FieldName(predicate.field)) + " " + OpName(predicate.op) + " ";
+            if (predicate.op != QueryOp::IN) {
+                return text + DescribeValue(predicate, 0);
+            }
+            size_t count = predicate.numbers.empty() ? predicate.strings.size() : predicate.numbers.size();
+            text += "(";
+            for (size_t i = 0; i < count; ++i) {
+                text += (i > 0 ? ", " : "") + DescribeValue(predicate, i);
+            }
+            return text + ")";
+        }
+    }
+    return "";
+}
+
+std::string TaskQuery::Describe(const std::vector<QueryOrder>& order) {
+    std::string text;
+    for (const auto& key : order) {
+        text += (text.empty() ? "" : ", ") + std::string(FieldName(key.field)) + (key.descending ? " desc" : " asc");
+    }
+    return text;
+}
@@ -0,0 +1,120 @@
+#ifndef _TASKQUERY_H_
+#define _TASKQUERY_H_
+
+#include "../DTO/Task.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class QueryField {
+    ID,
+    STATUS,
+    PRIORITY,
+    CATEGORY,
+    TAG,
+    DUE,
+    CREATED,
+    COMPLETED,
+    TITLE
+};
+
+enum class QueryOp {
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+    IN,
+    CONTAINS
+};
+
+// A time literal: "now" or "today" plus an offset, or an absolute time
+struct QueryTime {
+    bool relative = true;
+    bool startOfDay = false; // Offset is from local midnight ("today")
+    int64_t seconds = 0;     // Offset from now, or seconds since epoch
+
+    std::chrono::system_clock::time_point Resolve(const std::chrono::system_clock::time_point& now) const;
+};
+
+struct QueryPredicate {
+    QueryField field = QueryField::ID;
+    QueryOp op = QueryOp::EQ;
+    std::vector<int64_t> numbers;     // ID, category or enum values
+    std::vector<std::string> strings; // Tags or title text
+    QueryTime time;                   // Date fields
+};
+
+struct QueryNode {
+    enum class Kind {
+        AND,
+        OR,
+        NOT,
+        PREDICATE
+    };
+
+    Kind kind = Kind::PREDICATE;
+    std::vector<QueryNode> children;
+    QueryPredicate predicate;
+};
+
+// The relative times of one filter resolved at a single instant, so matching
+// many tasks does not repeat the local time conversions. Refers to the
+// filter's predicates, which must outlive it.
+class QueryTimes {
+public:
+    QueryTimes() = default;
+    QueryTimes(const QueryNode& node, const std::chrono::system_clock::time_point& now);
+
+    // Resolves times from other filters on demand
+    std::chrono::system_clock::time_point Get(const QueryTime& time) const;
+
+private:
+    std::chrono::system_clock::time_point now_;
+    std::vector<std::pair<const QueryTime*, std::chrono::system_clock::time_point>> resolved_;
+
+    void Collect(const QueryNode& node);
+};
+
+struct QueryOrder {
+    QueryField field = QueryField::ID;
+    bool descending = false;
+};
+
+// Parsed form of a task query such as
+//   status in (PENDING, IN_PROGRESS) and due < now+7d and tag = "ops"
+//   order by priority desc, due asc limit 50
+// Keywords and enum names are case-insensitive; times are now[+-N(m|h|d|w)],
+// today[+-N(m|h|d|w)] or "YYYY-MM-DD[ HH:MM:SS]". Relative times are resolved per execution, so
+// a parsed query can be reused. Parse throws std::invalid_argument.
+class TaskQuery {
+public:
+    static TaskQuery Parse(const std::string& text);
+
+    bool HasFilter() const;
+    const QueryNode& GetFilter() const;
+    const std::vector<QueryOrder>& GetOrder() const;
+    size_t GetLimit() const; // 0 when unlimited
+    const std::string& GetText() const;
+
+    static bool Matches(const QueryNode& node, const Task& task, const std::chrono::system_clock::time_point& now);
+    static bool Matches(const QueryNode& node, const Task& task, const QueryTimes& times);
+    // Negative, zero or positive like strcmp, following the order keys, then ID
+    static int Compare(const std::vector<QueryOrder>& order, const Task& lhs, const Task& rhs);
+    // Integer whose order equals the field's order (times as ticks); 0 for title and tag
+    static int64_t OrderValue(const Task& task, QueryField field);
+    static std::string Describe(const QueryNode& node);
+    static std::string Describe(const std::vector<QueryOrder>& order);
+
+private:
+    std::string text_;
+    bool hasFilter_ = false;
+    QueryNode filter_;
+    std::vector<QueryOrder> order_;
+    size_t limit_ = 0;
+};
+
+#endif // _TASKQUERY_H_
@@ -0,0 +1,194 @@
+#include "TaskService.h"
+#include "../LIB/IdGenerator.h"
+#include "../LIB/Logger.h"
+#include <algorithm>
+#include <stdexcept>
+
+TaskService::TaskService(Common::Ref<ITaskRepository> repository)
+    : repository_(std::move(repository)) {
+}
+
+// Observers
+void TaskService::AddObserver(Common::Ref<ITaskObserver> observer) {
+    if (!observer) {
+        throw std::invalid_argument("Observer cannot be null");
+    }
+    
+    // Bring the new observer up to date with the current collection
+    for (const auto& task : tasks_) {
+        observer->OnTaskAdded(task);
+    }
+    observers_.push_back(std::move(observer));
+}
+
+void TaskService::RemoveObserver(const Common::Ref<ITaskObserver>& observer) {
+    observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+}
+
+// Collection
+TaskPtr TaskService::AddTask(TaskPtr task) {
+    if (!task) {
+        throw std::invalid_argument("Task cannot be null");
+    }
+    
+    if (task->GetId() == 0) {
+        task->SetId(IdGenerator::GetInstance().GenerateTaskId());
+    }
+    
+    if (indexById_.count(task->GetId())) {
+        throw std::invalid_argument("Duplicate task ID: " + std::to_string(task->GetId()));
+    }
+    
+    Insert(task);
+    NotifyAdded(task);
+    return task;
+}
+
+bool TaskService::UpdateTask(int id, const std::function<void(Task&)>& mutator) {
+    auto it = indexById_.find(id);
+    if (it == indexById_.end()) {
+        return false;
+    }
+    
+    TaskPtr task = tasks_[it->second];
+    uint64_t before = task->GetVersion();
+    auto notifyIfChanged = [this, &task, before]() {
+        if (task->GetVersion() != before) {
+            task->UpdateTimestamp();
+            NotifyUpdated(task);
+        }
+    };
+    
+    try {
+        mutator(*task);
+    } catch (...) {
+        // Keep observers in step with whatever part of the change was applied
+        notifyIfChanged();
+        throw;
+    }
+    notifyIfChanged();
+    return true;
+}
+
+bool TaskService::SetTaskStatus(int id, Enums::TaskStatus status) {
+    return UpdateTask(id, [status](Task& task) {
+        if (task.GetStatus() != status) {
+            task.SetStatus(status);
+        }
+    });
+}
+
+bool TaskService::RemoveTask(int id) {
+    auto it = indexById_.find(id);
+    if (it == indexById_.end()) {
+        return false;
+    }
+    
+    // Swap with the last element so removal is O(1)
+    size_t index = it->second;
+    TaskPtr removed = tasks_[index];
+    if (index != tasks_.size() - 1) {
+        tasks_[index] = tasks_.back();
+        indexById_[tasks_[index]->GetId()] = index;
+    }
+    tasks_.pop_back();
+    indexById_.erase(id);
+    membershipChanged_ = true;
+    removed->UnlockId();
+    
+    NotifyRemoved(removed);
+    return true;
+}
+
+ConstTaskPtr TaskService::GetTask(int id) const {
+    auto it = indexById_.find(id);
+    return it == indexById_.end() ? nullptr : tasks_[it->second];
+}
+
+TaskView TaskService::GetAllTasks() const {
+    return TaskView(tasks_);
+}
+
+size_t TaskService::GetTaskCount() const {
+    return tasks_.size();
+}
+
+// Persistence
+bool TaskService::LoadTasks() {
+    if (!repository_) {
+        LOG_ERROR("TaskService has no repository to load from");
+        return false;
+    }
+    
+    auto loaded = repository_->LoadTasks();
+    
+    while (!tasks_.empty()) {
+        RemoveTask(tasks_.back()->GetId());
+    }
+    repository_->ClearTaskChanges();
+    
+    for (const auto& task : loaded) {
+        if (indexById_.count(task->GetId())) {
+            LOG_WARNING("Skipping duplicate task ID on load: " + std::to_string(task->GetId()));
+            continue;
+        }
+        Insert(task);
+        NotifyAdded(task);
+    }
+    membershipChanged_ = false;
+    return true;
+}
+
+bool TaskService::SaveTasks() {
+    if (!repository_) {
+        LOG_ERROR("TaskService has no repository to save to");
+        return false;
+    }
+    
+    if (!HasUnsavedChanges()) {
+        return true;
+    }
+    
+    if (!repository_->SaveTasks(tasks_)) {
+        return false;
+    }
+    membershipChanged_ = false;
+    return true;
+}
+
+bool TaskService::HasUnsavedChanges() const {
+    // Removed tasks leave no dirty object behind, hence the separate flag
+    return membershipChanged_ ||
+           std::any_of(tasks_.begin(), tasks_.end(), [](const TaskPtr& task) { return task->IsDirty(); });
+}
+
+void TaskService::Insert(const TaskPtr& task) {
+    indexById_[task->GetId()] = tasks_.size();
+    tasks_.push_back(task);
+    task->LockId();
+    membershipChanged_ = true;
+}
+
+void TaskService::NotifyAdded(const TaskPtr& task) {
+    if (repository_) {
+        repository_->TrackTask(task);
+    }
+    for (const auto& observer : observers_) {
+        observer->OnTaskAdded(task);
+    }
+}
+
+void TaskService::NotifyUpdated(const TaskPtr& task) {
+    for (const auto& observer : observers_) {
+        observer->OnTaskUpdated(task);
+    }
+}
+
+void TaskService::NotifyRemoved(const TaskPtr& task) {
+    if (repository_) {
+        repository_->RecordTaskRemoval(task->GetId());
+    }
+    for (const auto& observer : observers_) {
+        observer->OnTaskRemoved(task);
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef _TASKSERVICE_H_
+#define _TASKSERVICE_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../DAL/ITaskRepository.h"
+#include "../DTO/Task.h"
+#include "../LIB/common.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+// Read-only view of a task vector: elements come out as ConstTaskPtr, so
+// callers cannot edit tasks behind the owner's back
+class TaskView {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ConstTaskPtr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ConstTaskPtr;
+
+        Iterator() = default;
+        explicit Iterator(std::vector<TaskPtr>::const_iterator it) : it_(it) {}
+
+        ConstTaskPtr operator*() const { return *it_; }
+        Iterator& operator++() { ++it_; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++it_; return old; }
+        bool operator==(const Iterator& other) const = default;
+
+    private:
+        std::vector<TaskPtr>::const_iterator it_;
+    };
+
+    explicit TaskView(const std::vector<TaskPtr>& tasks) : tasks_(&tasks) {}
+
+    Iterator begin() const { return Iterator(tasks_->begin()); }
+    Iterator end() const { return Iterator(tasks_->end()); }
+    size_t size() const { return tasks_->size(); }
+    bool empty() const { return tasks_->empty(); }
+    ConstTaskPtr operator[](size_t index) const { return (*tasks_)[index]; }
+
+private:
+    const std::vector<TaskPtr>* tasks_;
+};
+
+// Owns the in-memory task collection and notifies observers (stats,
+// indexes, views) of every add/update/remove. Not thread-safe: use one
+// writer thread or guard calls externally.
+class TaskService {
+public:
+    explicit TaskService(Common::Ref<ITaskRepository> repository = nullptr);
+
+    // Observers
+    void AddObserver(Common::Ref<ITaskObserver> observer);
+    void RemoveObserver(const Common::Ref<ITaskObserver>& observer);
+
+    // Collection
+    TaskPtr AddTask(TaskPtr task); // Assigns an ID when the task has none
+    // Observers are notified even when the mutator throws after changing the
+    // task (the exception is then rethrown); the ID cannot be changed
+    bool UpdateTask(int id, const std::function<void(Task&)>& mutator);
+    bool SetTaskStatus(int id, Enums::TaskStatus status);
+    bool RemoveTask(int id);
+
+    ConstTaskPtr GetTask(int id) const; // Read-only; edit through UpdateTask
+    TaskView GetAllTasks() const; // Read-only, valid until the collection changes
+    size_t GetTaskCount() const;
+
+    // Persistence
+    bool LoadTasks();        // Replaces the collection with the repository contents
+    bool SaveTasks();        // Skips the write when nothing changed since the last save
+    bool HasUnsavedChanges() const;
+
+private:
+    Common::Ref<ITaskRepository> repository_;
+    std::vector<Common::Ref<ITaskObserver>> observers_;
+    std::vector<TaskPtr> tasks_;
+    std::unordered_map<int, size_t> indexById_;
+    bool membershipChanged_ = false; // Tasks added/removed since the last load or save
+
+    void Insert(const TaskPtr& task);
+    void NotifyAdded(const TaskPtr& task);
+    void NotifyUpdated(const TaskPtr& task);
+    void NotifyRemoved(const TaskPtr& task);
+};
+
+#endif // _TASKSERVICE_H_
@@ -0,0 +1,199 @@
+#include "TaskSorter.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <thread>
+
+namespace {
+    using Key128 = unsigned __int128;
+
+    constexpr size_t BUCKETS = size_t(1) << TaskSorter::RADIX_BITS;
+
+    template <typename Key>
+    struct Item {
+        Key key;
+        uint32_t index;
+    };
+
+    // Field value mapped so that unsigned order equals the field's order
+    uint64_t OrderedValue(const Task& task, QueryField field) {
+        return static_cast<uint64_t>(TaskQuery::OrderValue(task, field)) ^ (1ULL << 63);
+    }
+
+    struct Column {
+        std::vector<uint64_t> values;
+        uint64_t min = ~0ULL;
+        uint64_t max = 0;
+        bool descending = false;
+        unsigned bits = 0;
+    };
+
+    template <typename Key>
+    void RadixPass(const std::vector<Item<Key>>& source, std::vector<Item<Key>>& target, unsigned shift,
+                   size_t begin, size_t end, std::array<size_t, BUCKETS>& offsets) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t digit = static_cast<size_t>(source[i].key >> shift) & (BUCKETS - 1);
+            target[offsets[digit]++] = source[i];
+        }
+    }
+
+    template <typename Key>
+    void RadixSort(std::vector<Item<Key>>& items, unsigned bits, unsigned threadCount) {
+        size_t count = items.size();
+        std::vector<Item<Key>> buffer(count);
+        std::vector<std::array<size_t, BUCKETS>> histograms(threadCount);
+        size_t chunk = (count + threadCount - 1) / threadCount;
+        
+        auto forEachChunk = [&](auto&& work) {
+            if (threadCount == 1) {
+                work(0u, size_t(0), count);
+                return;
+            }
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                size_t begin = std::min(count, t * chunk);
+                size_t end = std::min(count, begin + chunk);
+                workers.emplace_back(work, t, begin, end);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        };
+        
+        for (unsigned shift = 0; shift < bits; shift += TaskSorter::RADIX_BITS) {
+            forEachChunk([&](unsigned t, size_t begin, size_t end) {
+                auto& histogram = histograms[t];
+                histogram.fill(0);
+                for (size_t i = begin; i < end; ++i) {
+                    ++histogram[static_cast<size_t>(items[i].key >> shift) & (BUCKETS - 1)];
+                }
+            });
+            
+            // Bucket offsets per chunk keep the pass stable; skip passes with a single digit
+            bool trivial = false;
+            size_t offset = 0;
+            for (size_t digit = 0; digit < BUCKETS; ++digit) {
+                size_t total = 0;
+                for (unsigned t = 0; t < threadCount; ++t) {
+                    size_t bucket = histograms[t][digit];
+                    histograms[t][digit] = offset;
+                    offset += bucket;
+                    total += bucket;
+                }
+                trivial = trivial || total == count;
+            }
+            if (trivial) {
+                continue;
+            }
+            
+            forEachChunk([&](unsigned t, size_t begin, size_t end) {
+                RadixPass(items, buffer, shift, begin, end, histograms[t]);
+            });
+            items.swap(buffer);
+        }
+    }
+
+    template <typename Key>
+    std::vector<uint32_t> PackAndSort(const std::vector<Column>& columns, size_t count, unsigned bits, unsigned threadCount) {
+        std::vector<Item<Key>> items(count);
+        for (size_t i = 0; i < count; ++i) {
+            Key key = 0;
+            for (const auto& column : columns) {
+                uint64_t value = column.values[i] - column.min;
+                if (column.descending) {
+                    value = (column.max - column.min) - value;
+                }
+                if (column.bits >= sizeof(Key) * 8) {
+                    key = value;
+                } else if (column.bits > 0) {
+                    key = (key << column.bits) | value;
+                }
+            }
+            items[i] = Item<Key>{key, static_cast<uint32_t>(i)};
+        }
+        
+        RadixSort(items, bits, threadCount);
+        
+        std::vector<uint32_t> permutation(count);
+        for (size_t i = 0; i < count; ++i) {
+            permutation[i] = items[i].index;
+        }
+        return permutation;
+    }
+}
+
+void TaskSorter::Sort(std::vector<TaskPtr>& tasks, const std::vector<QueryOrder>& order, unsigned threadCount) {
+    std::vector<uint32_t> permutation = SortedOrder(tasks, order, threadCount);
+    std::vector<TaskPtr> sorted;
+    sorted.reserve(tasks.size());
+    for (uint32_t index : permutation) {
+        sorted.push_back(std::move(tasks[index]));
+    }
+    tasks = std::move(sorted);
+}
+
+std::vector<uint32_t> TaskSorter::SortedOrder(const std::vector<TaskPtr>& tasks, const std::vector<QueryOrder>& order,
+                                              unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (tasks.size() < PARALLEL_THRESHOLD) {
+        threadCount = 1;
+    }
+    
+    std::vector<QueryOrder> keys = order;
+    bool hasId = std::any_of(keys.begin(), keys.end(), [](const QueryOrder& key) { return key.field == QueryField::ID; });
+    if (!hasId) {
+        keys.push_back(QueryOrder{QueryField::ID, false});
+    }
+    
+    std::vector<Column> columns;
+    unsigned bits = 0;
+    if (CanPack(keys)) {
+        columns.resize(keys.size());
+        for (size_t k = 0; k < keys.size(); ++k) {
+            Column& column = columns[k];
+            column.descending = keys[k].descending;
+            column.values.resize(tasks.size());
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                uint64_t value = OrderedValue(*tasks[i], keys[k].field);
+                column.values[i] = value;
+                column.min = std::min(column.min, value);
+                column.max = std::max(column.max, value);
+            }
+            column.bits = tasks.empty() ? 0 : static_cast<unsigned>(std::bit_width(column.max - column.min));
+            bits += column.bits;
+        }
+    }
+    
+    if (!CanPack(keys) || bits > 128) {
+        std::vector<uint32_t> permutation(tasks.size());
+        for (size_t i = 0; i < permutation.size(); ++i) {
+            permutation[i] = static_cast<uint32_t>(i);
+        }
+        std::stable_sort(permutation.begin(), permutation.end(), [&](uint32_t lhs, uint32_t rhs) {
+            return TaskQuery::Compare(order, *tasks[lhs], *tasks[rhs]) < 0;
+        });
+        return permutation;
+    }
+    
+    if (bits <= 64) {
+        return PackAndSort<uint64_t>(columns, tasks.size(), bits, threadCount);
+    }
+    return PackAndSort<Key128>(columns, tasks.size(), bits, threadCount);
+}
+
+const std::vector<QueryOrder>& TaskSorter::DefaultOrder() {
+    static const std::vector<QueryOrder> order = {
+        {QueryField::PRIORITY, true},
+        {QueryField::DUE, false},
+        {QueryField::ID, false}
+    };
+    return order;
+}
+
+bool TaskSorter::CanPack(const std::vector<QueryOrder>& order) {
+    return std::none_of(order.begin(), order.end(), [](const QueryOrder& key) {
+        return key.field == QueryField::TITLE || key.field == QueryField::TAG;
+    });
+}
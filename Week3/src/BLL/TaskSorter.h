@@ -0,0 +1,31 @@
+#ifndef _TASKSORTER_H_
+#define _TASKSORTER_H_
+
+#include "../BLL/TaskQuery.h"
+#include "../DTO/Task.h"
+#include <cstdint>
+#include <vector>
+
+// Sorts tasks by packing each task's order keys into one 64- or 128-bit
+// integer (every field rebased to its minimum and sized to its range, with
+// descending fields inverted, then the ID as the final tie-break) and running
+// an LSD radix sort over (key, index) pairs. Passes whose digit is the same
+// for every key are skipped. The result matches TaskQuery::Compare; orders
+// that cannot be packed (title, tag, or more than 128 bits) fall back to
+// std::sort with that comparator.
+class TaskSorter {
+public:
+    static void Sort(std::vector<TaskPtr>& tasks, const std::vector<QueryOrder>& order, unsigned threadCount = 1);
+    // Permutation that sorts the tasks (threadCount = 0 uses the hardware count)
+    static std::vector<uint32_t> SortedOrder(const std::vector<TaskPtr>& tasks, const std::vector<QueryOrder>& order,
+                                             unsigned threadCount = 1);
+
+    // priority desc, due asc, id asc
+    static const std::vector<QueryOrder>& DefaultOrder();
+    static bool CanPack(const std::vector<QueryOrder>& order);
+
+    static constexpr unsigned RADIX_BITS = 8;
+    static constexpr size_t PARALLEL_THRESHOLD = 50000;
+};
+
+#endif // _TASKSORTER_H_
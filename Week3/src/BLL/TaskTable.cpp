@@ -0,0 +1,305 @@
+#include "TaskTable.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+    int64_t Ticks(const system_clock::time_point& time) {
+        return static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    constexpr int8_t COMPLETED = static_cast<int8_t>(Enums::TaskStatus::COMPLETED);
+    constexpr int8_t CANCELLED = static_cast<int8_t>(Enums::TaskStatus::CANCELLED);
+    constexpr int8_t PENDING = static_cast<int8_t>(Enums::TaskStatus::PENDING);
+
+    // Tallies column values over the selected rows in one pass, visiting
+    // only the set bits of each word
+    template <size_t N>
+    std::array<int, N> CountColumn(const Bitmap& selection, const std::vector<int8_t>& column) {
+        if (selection.Size() != column.size()) {
+            throw std::invalid_argument("Selection size does not match the table");
+        }
+        std::array<int, N> counts{};
+        const auto& words = selection.GetWords();
+        for (size_t w = 0; w < words.size(); ++w) {
+            const int8_t* rows = column.data() + w * Bitmap::WORD_BITS;
+            for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+                ++counts[static_cast<size_t>(rows[std::countr_zero(word)])];
+            }
+        }
+        return counts;
+    }
+}
+
+TaskTable::TaskTable(const std::vector<TaskPtr>& tasks) {
+    Build(tasks);
+}
+
+void TaskTable::Build(const std::vector<TaskPtr>& tasks) {
+    Clear();
+    ids_.reserve(tasks.size());
+    status_.reserve(tasks.size());
+    priority_.reserve(tasks.size());
+    category_.reserve(tasks.size());
+    due_.reserve(tasks.size());
+    created_.reserve(tasks.size());
+    completed_.reserve(tasks.size());
+    rowById_.reserve(tasks.size());
+    
+    for (const auto& task : tasks) {
+        if (task && rowById_.find(task->GetId()) == rowById_.end()) {
+            Append(*task);
+        }
+    }
+}
+
+void TaskTable::Clear() {
+    ids_.clear();
+    status_.clear();
+    priority_.clear();
+    category_.clear();
+    due_.clear();
+    created_.clear();
+    completed_.clear();
+    completedValid_.Resize(0);
+    categoryValid_.Resize(0);
+    rowById_.clear();
+}
+
+// ITaskObserver
+void TaskTable::OnTaskAdded(const TaskPtr& task) {
+    auto it = rowById_.find(task->GetId());
+    if (it != rowById_.end()) {
+        Store(it->second, *task);
+    } else {
+        Append(*task);
+    }
+}
+
+void TaskTable::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void TaskTable::OnTaskRemoved(const TaskPtr& task) {
+    auto it = rowById_.find(task->GetId());
+    if (it != rowById_.end()) {
+        RemoveRow(it->second);
+    }
+}
+
+size_t TaskTable::GetRowCount() const {
+    return ids_.size();
+}
+
+int TaskTable::FindRow(int taskId) const {
+    auto it = rowById_.find(taskId);
+    return it == rowById_.end() ? -1 : static_cast<int>(it->second);
+}
+
+int TaskTable::GetTaskId(size_t row) const {
+    return ids_.at(row);
+}
+
+const std::vector<int8_t>& TaskTable::GetStatusColumn() const { return status_; }
+const std::vector<int8_t>& TaskTable::GetPriorityColumn() const { return priority_; }
+const std::vector<int32_t>& TaskTable::GetCategoryColumn() const { return category_; }
+const std::vector<int64_t>& TaskTable::GetDueColumn() const { return due_; }
+const std::vector<int64_t>& TaskTable::GetCreatedColumn() const { return created_; }
+const std::vector<int64_t>& TaskTable::GetCompletedColumn() const { return completed_; }
+const Bitmap& TaskTable::GetCompletedValidity() const { return completedValid_; }
+const Bitmap& TaskTable::GetCategoryValidity() const { return categoryValid_; }
+
+// Predicates
+Bitmap TaskTable::SelectAll() const {
+    return Bitmap(ids_.size(), true);
+}
+
+Bitmap TaskTable::SelectStatus(Enums::TaskStatus status) const {
+    const int8_t* column = status_.data();
+    int8_t value = static_cast<int8_t>(status);
+    return Select([column, value](size_t i) { return column[i] == value; });
+}
+
+Bitmap TaskTable::SelectPriority(Enums::Priority priority) const {
+    const int8_t* column = priority_.data();
+    int8_t value = static_cast<int8_t>(priority);
+    return Select([column, value](size_t i) { return column[i] == value; });
+}
+
+Bitmap TaskTable::SelectPriorityAtLeast(Enums::Priority priority) const {
+    const int8_t* column = priority_.data();
+    int8_t value = static_cast<int8_t>(priority);
+    return Select([column, value](size_t i) { return column[i] >= value; });
+}
+
+Bitmap TaskTable::SelectCategory(int categoryId) const {
+    const int32_t* column = category_.data();
+    return Select([column, categoryId](size_t i) { return column[i] == categoryId; });
+}
+
+Bitmap TaskTable::SelectDueBefore(const system_clock::time_point& time) const {
+    const int64_t* column = due_.data();
+    int64_t ticks = Ticks(time);
+    return Select([column, ticks](size_t i) { return column[i] < ticks; });
+}
+
+Bitmap TaskTable::SelectCreatedBetween(const system_clock::time_point& from,
+                                       const system_clock::time_point& to) const {
+    const int64_t* column = created_.data();
+    int64_t lo = Ticks(from);
+    int64_t hi = Ticks(to);
+    return Select([column, lo, hi](size_t i) { return (column[i] >= lo) & (column[i] < hi); });
+}
+
+Bitmap TaskTable::SelectOverdue(const system_clock::time_point& asOf) const {
+    // Same rule as StatsAccumulator::IsOverdue
+    const int8_t* status = status_.data();
+    const int64_t* due = due_.data();
+    int64_t ticks = Ticks(asOf);
+    return Select([status, due, ticks](size_t i) {
+        return (status[i] != COMPLETED) & (status[i] != CANCELLED) & (due[i] < ticks);
+    });
+}
+
+Bitmap TaskTable::SelectTimedCompletions() const {
+    // Same rule as StatsAccumulator::HasCompletionTime
+    const int8_t* status = status_.data();
+    const int64_t* created = created_.data();
+    const int64_t* completed = completed_.data();
+    Bitmap result = Select([status, created, completed](size_t i) {
+        return (status[i] == COMPLETED) & (completed[i] >= created[i]);
+    });
+    result &= completedValid_;
+    return result;
+}
+
+// Kernels
+std::array<int, TASK_STATUS_COUNT> TaskTable::CountByStatus(const Bitmap& selection) const {
+    return CountColumn<TASK_STATUS_COUNT>(selection, status_);
+}
+
+std::array<int, PRIORITY_COUNT> TaskTable::CountByPriority(const Bitmap& selection) const {
+    return CountColumn<PRIORITY_COUNT>(selection, priority_);
+}
+
+double TaskTable::SumCompletionHours(const Bitmap& selection) const {
+    Bitmap timed = SelectTimedCompletions();
+    timed &= selection;
+    
+    // Independent lanes keep the reduction vectorizable without -ffast-math
+    constexpr size_t LANES = 8;
+    double lanes[LANES] = {};
+    const auto& words = timed.GetWords();
+    const int64_t* created = created_.data();
+    const int64_t* completed = completed_.data();
+    
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t word = words[w];
+        if (word == 0) {
+            continue;
+        }
+        size_t begin = w * Bitmap::WORD_BITS;
+        size_t count = std::min(Bitmap::WORD_BITS, ids_.size() - begin);
+        for (size_t j = 0; j < count; ++j) {
+            double span = static_cast<double>(completed[begin + j] - created[begin + j]);
+            lanes[j % LANES] += ((word >> j) & 1ULL) ? span : 0.0;
+        }
+    }
+    
+    double total = 0.0;
+    for (double lane : lanes) {
+        total += lane;
+    }
+    return duration<double, std::ratio<3600>>(duration<double, system_clock::period>(total)).count();
+}
+
+LogHistogram TaskTable::CompletionHistogram(const Bitmap& selection) const {
+    Bitmap timed = SelectTimedCompletions();
+    timed &= selection;
+    
+    LogHistogram histogram;
+    const auto& words = timed.GetWords();
+    for (size_t w = 0; w < words.size(); ++w) {
+        size_t begin = w * Bitmap::WORD_BITS;
+        for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+            size_t row = begin + static_cast<size_t>(std::countr_zero(word));
+            histogram.Add(duration_cast<seconds>(system_clock::duration(completed_[row] - created_[row])).count());
+        }
+    }
+    return histogram;
+}
+
+ProductivityStats TaskTable::ComputeStats(const Bitmap& selection,
+                                          const system_clock::time_point& asOf) const {
+    StatsAccumulator acc;
+    acc.byStatus = CountByStatus(selection);
+    acc.byPriority = CountByPriority(selection);
+    acc.totalTasks = static_cast<int>(selection.Count());
+    acc.completedTasks = acc.byStatus[static_cast<size_t>(COMPLETED)];
+    acc.pendingTasks = acc.byStatus[static_cast<size_t>(PENDING)];
+    acc.overdueTasks = static_cast<int>((SelectOverdue(asOf) & selection).Count());
+    acc.timedCompletions = static_cast<int>((SelectTimedCompletions() & selection).Count());
+    acc.completionHoursSum = SumCompletionHours(selection);
+    acc.completionTimes = CompletionHistogram(selection);
+    return acc.ToStats();
+}
+
+// Row maintenance
+void TaskTable::Append(const Task& task) {
+    size_t row = ids_.size();
+    ids_.push_back(task.GetId());
+    status_.push_back(0);
+    priority_.push_back(0);
+    category_.push_back(0);
+    due_.push_back(0);
+    created_.push_back(0);
+    completed_.push_back(0);
+    completedValid_.Resize(row + 1);
+    categoryValid_.Resize(row + 1);
+    rowById_[task.GetId()] = row;
+    Store(row, task);
+}
+
+void TaskTable::Store(size_t row, const Task& task) {
+    ids_[row] = task.GetId();
+    status_[row] = static_cast<int8_t>(task.GetStatus());
+    priority_[row] = static_cast<int8_t>(task.GetPriority());
+    category_[row] = task.GetCategoryId();
+    due_[row] = Ticks(task.GetDueDate());
+    created_[row] = Ticks(task.GetCreatedAt());
+    
+    bool hasCompleted = task.GetCompletedAt() != system_clock::time_point::min();
+    completed_[row] = hasCompleted ? Ticks(task.GetCompletedAt()) : 0;
+    completedValid_.Set(row, hasCompleted);
+    categoryValid_.Set(row, task.GetCategoryId() != 0);
+}
+
+void TaskTable::RemoveRow(size_t row) {
+    size_t last = ids_.size() - 1;
+    rowById_.erase(ids_[row]);
+    
+    if (row != last) {
+        ids_[row] = ids_[last];
+        status_[row] = status_[last];
+        priority_[row] = priority_[last];
+        category_[row] = category_[last];
+        due_[row] = due_[last];
+        created_[row] = created_[last];
+        completed_[row] = completed_[last];
+        completedValid_.Set(row, completedValid_.Test(last));
+        categoryValid_.Set(row, categoryValid_.Test(last));
+        rowById_[ids_[row]] = row;
+    }
+    
+    ids_.pop_back();
+    status_.pop_back();
+    priority_.pop_back();
+    category_.pop_back();
+    due_.pop_back();
+    created_.pop_back();
+    completed_.pop_back();
+    completedValid_.Resize(last);
+    categoryValid_.Resize(last);
+}
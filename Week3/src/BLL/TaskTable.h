@@ -0,0 +1,102 @@
+#ifndef _TASKTABLE_H_
+#define _TASKTABLE_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../BLL/LogHistogram.h"
+#include "../BLL/StatsAccumulator.h"
+#include "../DTO/ProductivityStats.h"
+#include "../LIB/Bitmap.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Struct-of-arrays copy of the fields analytics scan most often. Predicates
+// produce selection bitmaps and kernels aggregate over a selection; the
+// loops are branch-free over contiguous columns so the compiler can
+// vectorize them. Rows are unordered (removal swaps in the last row).
+class TaskTable : public ITaskObserver {
+public:
+    TaskTable() = default;
+    explicit TaskTable(const std::vector<TaskPtr>& tasks);
+
+    void Build(const std::vector<TaskPtr>& tasks);
+    void Clear();
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    size_t GetRowCount() const;
+    int FindRow(int taskId) const; // -1 when absent
+    int GetTaskId(size_t row) const;
+
+    // Columns (ticks are system_clock durations since epoch)
+    const std::vector<int8_t>& GetStatusColumn() const;
+    const std::vector<int8_t>& GetPriorityColumn() const;
+    const std::vector<int32_t>& GetCategoryColumn() const;
+    const std::vector<int64_t>& GetDueColumn() const;
+    const std::vector<int64_t>& GetCreatedColumn() const;
+    const std::vector<int64_t>& GetCompletedColumn() const;
+    const Bitmap& GetCompletedValidity() const; // completedAt is set
+    const Bitmap& GetCategoryValidity() const;  // task has a category
+
+    // Predicates
+    Bitmap SelectAll() const;
+    Bitmap SelectStatus(Enums::TaskStatus status) const;
+    Bitmap SelectPriority(Enums::Priority priority) const;
+    Bitmap SelectPriorityAtLeast(Enums::Priority priority) const;
+    Bitmap SelectCategory(int categoryId) const;
+    Bitmap SelectDueBefore(const std::chrono::system_clock::time_point& time) const;
+    Bitmap SelectCreatedBetween(const std::chrono::system_clock::time_point& from,
+                                const std::chrono::system_clock::time_point& to) const; // [from, to)
+    Bitmap SelectOverdue(const std::chrono::system_clock::time_point& asOf) const;
+    Bitmap SelectTimedCompletions() const;
+
+    // Kernels
+    std::array<int, TASK_STATUS_COUNT> CountByStatus(const Bitmap& selection) const;
+    std::array<int, PRIORITY_COUNT> CountByPriority(const Bitmap& selection) const;
+    double SumCompletionHours(const Bitmap& selection) const; // Over timed completions only
+    LogHistogram CompletionHistogram(const Bitmap& selection) const; // Seconds, timed completions only
+    ProductivityStats ComputeStats(const Bitmap& selection,
+                                   const std::chrono::system_clock::time_point& asOf) const;
+
+private:
+    std::vector<int32_t> ids_;
+    std::vector<int8_t> status_;
+    std::vector<int8_t> priority_;
+    std::vector<int32_t> category_;
+    std::vector<int64_t> due_;
+    std::vector<int64_t> created_;
+    std::vector<int64_t> completed_;
+    Bitmap completedValid_;
+    Bitmap categoryValid_;
+    std::unordered_map<int, size_t> rowById_;
+
+    void Append(const Task& task);
+    void Store(size_t row, const Task& task);
+    void RemoveRow(size_t row);
+
+    // Evaluates pred(row) for every row, 64 rows per output word
+    template <typename Predicate>
+    Bitmap Select(Predicate pred) const {
+        size_t rows = ids_.size();
+        Bitmap result(rows);
+        size_t words = result.GetWords().size();
+        for (size_t w = 0; w < words; ++w) {
+            size_t begin = w * Bitmap::WORD_BITS;
+            size_t count = std::min(Bitmap::WORD_BITS, rows - begin);
+            uint64_t bits = 0;
+            for (size_t j = 0; j < count; ++j) {
+                bits |= static_cast<uint64_t>(pred(begin + j)) << j;
+            }
+            result.SetWord(w, bits);
+        }
+        return result;
+    }
+};
+
+#endif // _TASKTABLE_H_
@@ -0,0 +1,237 @@
+#include "TextSearchIndex.h"
+#include "../LIB/HashUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+// ITaskObserver
+void TextSearchIndex::OnTaskAdded(const TaskPtr& task) {
+    std::string text = Lower(task->GetTitle());
+    text += '\n';
+    text += Lower(task->GetDescription());
+    uint64_t textHash = HashUtils::Fnv1a(text);
+    
+    uint32_t ordinal;
+    auto it = ordinalByTask_.find(task->GetId());
+    if (it != ordinalByTask_.end()) {
+        ordinal = it->second;
+        documents_[ordinal].task = task;
+        if (documents_[ordinal].textHash == textHash) {
+            return; // Status or other non-text change
+        }
+        Unindex(ordinal);
+    } else if (!freeOrdinals_.empty()) {
+        ordinal = freeOrdinals_.back();
+        freeOrdinals_.pop_back();
+        ordinalByTask_.emplace(task->GetId(), ordinal);
+    } else {
+        ordinal = static_cast<uint32_t>(documents_.size());
+        documents_.emplace_back();
+        ordinalByTask_.emplace(task->GetId(), ordinal);
+    }
+    
+    Document document;
+    document.task = task;
+    document.textHash = textHash;
+    std::unordered_map<std::string, uint32_t> counts;
+    for (const auto& term : Tokenize(task->GetTitle())) {
+        counts[term] += TITLE_WEIGHT;
+        document.length += TITLE_WEIGHT;
+    }
+    for (const auto& term : Tokenize(task->GetDescription())) {
+        ++counts[term];
+        ++document.length;
+    }
+    for (const auto& [term, tf] : counts) {
+        uint32_t id = TermId(term);
+        auto& list = postings_[id];
+        auto position = std::lower_bound(list.begin(), list.end(), ordinal,
+                                         [](const Posting& posting, uint32_t value) { return posting.ordinal < value; });
+        list.insert(position, Posting{ordinal, tf});
+        document.terms.push_back(id);
+    }
+    
+    for (size_t i = 0; i + 3 <= text.size(); ++i) {
+        document.trigrams.push_back(Trigram(text.data() + i));
+    }
+    std::sort(document.trigrams.begin(), document.trigrams.end());
+    document.trigrams.erase(std::unique(document.trigrams.begin(), document.trigrams.end()), document.trigrams.end());
+    for (uint32_t trigram : document.trigrams) {
+        trigrams_[trigram].Add(ordinal);
+    }
+    
+    totalLength_ += document.length;
+    documents_[ordinal] = std::move(document);
+}
+
+void TextSearchIndex::OnTaskUpdated(const TaskPtr& task) {
+    OnTaskAdded(task);
+}
+
+void TextSearchIndex::OnTaskRemoved(const TaskPtr& task) {
+    auto it = ordinalByTask_.find(task->GetId());
+    if (it == ordinalByTask_.end()) {
+        return;
+    }
+    Unindex(it->second);
+    documents_[it->second] = Document();
+    freeOrdinals_.push_back(it->second);
+    ordinalByTask_.erase(it);
+}
+
+size_t TextSearchIndex::Size() const {
+    return ordinalByTask_.size();
+}
+
+size_t TextSearchIndex::GetDocumentFrequency(const std::string& term) const {
+    auto it = termIds_.find(term);
+    return it == termIds_.end() ? 0 : postings_[it->second].size();
+}
+
+// Queries
+std::vector<SearchHit> TextSearchIndex::Search(const std::string& query, size_t limit) const {
+    std::vector<std::string> terms = Tokenize(query);
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    if (terms.empty() || ordinalByTask_.empty()) {
+        return {};
+    }
+    
+    double documentCount = static_cast<double>(ordinalByTask_.size());
+    double averageLength = std::max(1.0, static_cast<double>(totalLength_) / documentCount);
+    
+    // Accumulate per document; cost depends on posting list sizes, not corpus size
+    std::unordered_map<uint32_t, double> scores;
+    for (const auto& term : terms) {
+        auto it = termIds_.find(term);
+        if (it == termIds_.end() || postings_[it->second].empty()) {
+            continue;
+        }
+        const auto& list = postings_[it->second];
+        double frequency = static_cast<double>(list.size());
+        double idf = std::log(1.0 + (documentCount - frequency + 0.5) / (frequency + 0.5));
+        for (const auto& [ordinal, tf] : list) {
+            double norm = K1 * (1.0 - B + B * documents_[ordinal].length / averageLength);
+            scores[ordinal] += idf * (tf * (K1 + 1.0)) / (tf + norm);
+        }
+    }
+    
+    std::vector<SearchHit> hits;
+    hits.reserve(scores.size());
+    for (const auto& [ordinal, score] : scores) {
+        hits.push_back(SearchHit{documents_[ordinal].task->GetId(), score});
+    }
+    auto better = [](const SearchHit& lhs, const SearchHit& rhs) {
+        return lhs.score != rhs.score ? lhs.score > rhs.score : lhs.taskId < rhs.taskId;
+    };
+    size_t count = std::min(limit, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + count, hits.end(), better);
+    hits.resize(count);
+    return hits;
+}
+
+std::vector<int> TextSearchIndex::FindSubstring(const std::string& text) const {
+    std::string pattern = Lower(text);
+    std::vector<int> ids;
+    auto verify = [&](uint32_t ordinal) {
+        const Task& task = *documents_[ordinal].task;
+        if (ContainsLower(task.GetTitle(), pattern) || ContainsLower(task.GetDescription(), pattern)) {
+            ids.push_back(task.GetId());
+        }
+    };
+    
+    if (pattern.size() < 3) {
+        // Too short for trigrams; scan every document
+        for (const auto& [taskId, ordinal] : ordinalByTask_) {
+            verify(ordinal);
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+    
+    std::vector<const RoaringBitmap*> lists;
+    for (size_t i = 0; i + 3 <= pattern.size(); ++i) {
+        auto it = trigrams_.find(Trigram(pattern.data() + i));
+        if (it == trigrams_.end()) {
+            return ids;
+        }
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const RoaringBitmap* lhs, const RoaringBitmap* rhs) {
+        return lhs->Cardinality() < rhs->Cardinality();
+    });
+    
+    RoaringBitmap candidates = *lists.front();
+    for (size_t i = 1; i < lists.size() && !candidates.Empty(); ++i) {
+        candidates &= *lists[i];
+    }
+    candidates.ForEach(verify);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::vector<std::string> TextSearchIndex::Tokenize(std::string_view text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (char ch : text) {
+        unsigned char byte = static_cast<unsigned char>(ch);
+        if (std::isalnum(byte) || byte >= 0x80) {
+            current += static_cast<char>(std::tolower(byte));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(std::move(current));
+    }
+    return tokens;
+}
+
+// Maintenance
+void TextSearchIndex::Unindex(uint32_t ordinal) {
+    const Document& document = documents_[ordinal];
+    for (uint32_t id : document.terms) {
+        auto& list = postings_[id];
+        auto position = std::lower_bound(list.begin(), list.end(), ordinal,
+                                         [](const Posting& posting, uint32_t value) { return posting.ordinal < value; });
+        list.erase(position);
+    }
+    for (uint32_t trigram : document.trigrams) {
+        auto it = trigrams_.find(trigram);
+        it->second.Remove(ordinal);
+        if (it->second.Empty()) {
+            trigrams_.erase(it);
+        }
+    }
+    totalLength_ -= document.length;
+}
+
+uint32_t TextSearchIndex::TermId(const std::string& term) {
+    auto [it, inserted] = termIds_.try_emplace(term, static_cast<uint32_t>(postings_.size()));
+    if (inserted) {
+        postings_.emplace_back();
+    }
+    return it->second;
+}
+
+std::string TextSearchIndex::Lower(std::string_view text) {
+    std::string lower(text);
+    for (char& ch : lower) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return lower;
+}
+
+bool TextSearchIndex::ContainsLower(std::string_view text, std::string_view lowerPattern) {
+    auto it = std::search(text.begin(), text.end(), lowerPattern.begin(), lowerPattern.end(), [](char lhs, char rhs) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(lhs))) == rhs;
+    });
+    return it != text.end() || lowerPattern.empty();
+}
+
+uint32_t TextSearchIndex::Trigram(const char* text) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+}
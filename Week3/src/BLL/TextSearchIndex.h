@@ -0,0 +1,78 @@
+#ifndef _TEXTSEARCHINDEX_H_
+#define _TEXTSEARCHINDEX_H_
+
+#include "../BLL/ITaskObserver.h"
+#include "../LIB/RoaringBitmap.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct SearchHit {
+    int taskId = 0;
+    double score = 0.0;
+};
+
+// Case-insensitive full-text index over task titles and descriptions.
+// Words go into posting lists (sorted (ordinal, tf) pairs) for BM25
+// ranking; every lowercase byte trigram maps to a bitmap of documents so
+// substring queries only verify candidates that contain all of the
+// pattern's trigrams, against the task's own text. Documents keep no copy
+// of the text, only term IDs and trigrams for un-indexing, and are
+// re-indexed only when a hash of the text changes.
+class TextSearchIndex : public ITaskObserver {
+public:
+    TextSearchIndex() = default;
+
+    // ITaskObserver
+    void OnTaskAdded(const TaskPtr& task) override;
+    void OnTaskUpdated(const TaskPtr& task) override;
+    void OnTaskRemoved(const TaskPtr& task) override;
+
+    size_t Size() const;
+    size_t GetDocumentFrequency(const std::string& term) const;
+
+    // Best matches for the query's words, highest BM25 score first
+    std::vector<SearchHit> Search(const std::string& query, size_t limit = 20) const;
+    // Tasks whose title or description contains the text, ignoring case
+    std::vector<int> FindSubstring(const std::string& text) const;
+
+    // Lowercase ASCII letter/digit runs; bytes >= 0x80 count as letters so
+    // UTF-8 words stay whole
+    static std::vector<std::string> Tokenize(std::string_view text);
+
+    static constexpr double K1 = 1.2;
+    static constexpr double B = 0.75;
+    static constexpr int TITLE_WEIGHT = 2; // Title words count this many times
+
+private:
+    struct Posting {
+        uint32_t ordinal = 0;
+        uint32_t tf = 0;
+    };
+
+    struct Document {
+        TaskPtr task;
+        uint64_t textHash = 0;
+        uint32_t length = 0;            // Weighted token count
+        std::vector<uint32_t> terms;    // Distinct term IDs
+        std::vector<uint32_t> trigrams; // Distinct
+    };
+
+    std::unordered_map<std::string, uint32_t> termIds_;
+    std::vector<std::vector<Posting>> postings_; // key: term ID, sorted by ordinal
+    std::unordered_map<uint32_t, RoaringBitmap> trigrams_;
+    std::vector<Document> documents_;    // key: ordinal
+    std::unordered_map<int, uint32_t> ordinalByTask_;
+    std::vector<uint32_t> freeOrdinals_;
+    uint64_t totalLength_ = 0;
+
+    void Unindex(uint32_t ordinal);
+    uint32_t TermId(const std::string& term);
+    static std::string Lower(std::string_view text);
+    static bool ContainsLower(std::string_view text, std::string_view lowerPattern);
+    static uint32_t Trigram(const char* text);
+};
+
+#endif // _TEXTSEARCHINDEX_H_
@@ -2,6 +2,10 @@
 #include "../LIB/Logger.h"
 #include "../LIB/DateUtils.h"
 #include "../LIB/StringUtils.h"
+#include "../LIB/IdGenerator.h"
+#include "../LIB/HashUtils.h"
+#include "../DAL/RecordFingerprint.h"
+#include "../DTO/RecurrencePatternRegistry.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -36,6 +40,9 @@ CSVDataManager::CSVDataManager(const std::string& dataFolder)
 
 // ITaskRepository implementation
 bool CSVDataManager::SaveTasks(const std::vector<TaskPtr>& tasks) {
+    // Everything stamped up to here is covered by this save
+    uint64_t watermark = IdGenerator::GetInstance().GetCurrentVersion();
+    
     try {
         // Create backup of existing file
         if (fs::exists(tasksFile_)) {
@@ -52,7 +59,7 @@ bool CSVDataManager::SaveTasks(const std::vector<TaskPtr>& tasks) {
         }
         
         // Write CSV header
-        file << "id,title,description,dueDate,createdAt,updatedAt,completedAt,priority,status,categoryId,recurrenceType,recurrenceInterval,daysOfWeek,occurrenceCount,endDate,tags\n";
+        file << "id,title,description,dueDate,createdAt,updatedAt,completedAt,priority,status,categoryId,recurrenceType,recurrenceInterval,daysOfWeek,occurrenceCount,endDate,tags,fingerprint\n";
         
         // Write each task
         for (const auto& task : tasks) {
@@ -64,6 +71,14 @@ bool CSVDataManager::SaveTasks(const std::vector<TaskPtr>& tasks) {
         // Replace original file with temp file
         fs::rename(tempFile, tasksFile_);
         
+        for (const auto& task : tasks) {
+            if (task->GetVersion() <= watermark) {
+                task->MarkClean();
+            }
+            taskChanges_->Track(task);
+        }
+        lastSavedTaskVersion_ = watermark;
+        
         LOG_INFO("Saved " + std::to_string(tasks.size()) + " tasks to " + tasksFile_);
         return true;
         
@@ -112,7 +127,13 @@ std::vector<TaskPtr> CSVDataManager::LoadTasks() {
             }
         }
         
+        taskChanges_->Clear();
+        for (const auto& task : tasks) {
+            taskChanges_->Track(task);
+        }
         LOG_INFO("Loaded " + std::to_string(tasks.size()) + " tasks from " + tasksFile_);
+        // The loaded tasks match the file, like right after a save
+        lastSavedTaskVersion_ = IdGenerator::GetInstance().GetCurrentVersion();
         
     } catch (const std::exception& e) {
         LOG_ERROR("Error loading tasks: " + std::string(e.what()));
@@ -121,8 +142,34 @@ std::vector<TaskPtr> CSVDataManager::LoadTasks() {
     return tasks;
 }
 
+uint64_t CSVDataManager::GetLastSavedVersion() const {
+    return lastSavedTaskVersion_;
+}
+
+void CSVDataManager::TrackTask(const TaskPtr& task) {
+    taskChanges_->Track(task);
+}
+
+void CSVDataManager::RecordTaskRemoval(int taskId) {
+    taskChanges_->RecordRemoval(taskId);
+}
+
+void CSVDataManager::ClearTaskChanges() {
+    taskChanges_->Clear();
+}
+
+std::vector<TaskPtr> CSVDataManager::GetTasksChangedSince(uint64_t version) const {
+    return taskChanges_->GetChangedSince(version);
+}
+
+std::vector<int> CSVDataManager::GetTasksRemovedSince(uint64_t version) const {
+    return taskChanges_->GetRemovedSince(version);
+}
+
 // ICategoryRepository implementation
 bool CSVDataManager::SaveCategories(const std::vector<CategoryPtr>& categories) {
+    uint64_t watermark = IdGenerator::GetInstance().GetCurrentVersion();
+    
     try {
         // Create backup of existing file
         if (fs::exists(categoriesFile_)) {
@@ -139,7 +186,7 @@ bool CSVDataManager::SaveCategories(const std::vector<CategoryPtr>& categories)
         }
         
         // Write CSV header
-        file << "id,name,description,color,createdAt,updatedAt\n";
+        file << "id,name,description,color,createdAt,updatedAt,fingerprint\n";
         
         // Write each category
         for (const auto& category : categories) {
@@ -151,6 +198,14 @@ bool CSVDataManager::SaveCategories(const std::vector<CategoryPtr>& categories)
         // Replace original file with temp file
         fs::rename(tempFile, categoriesFile_);
         
+        for (const auto& category : categories) {
+            if (category->GetVersion() <= watermark) {
+                category->MarkClean();
+            }
+            categoryChanges_->Track(category);
+        }
+        lastSavedCategoryVersion_ = watermark;
+        
         LOG_INFO("Saved " + std::to_string(categories.size()) + " categories to " + categoriesFile_);
         return true;
         
@@ -199,6 +254,10 @@ std::vector<CategoryPtr> CSVDataManager::LoadCategories() {
             }
         }
         
+        categoryChanges_->Clear();
+        for (const auto& category : categories) {
+            categoryChanges_->Track(category);
+        }
         LOG_INFO("Loaded " + std::to_string(categories.size()) + " categories from " + categoriesFile_);
         
     } catch (const std::exception& e) {
@@ -208,6 +267,30 @@ std::vector<CategoryPtr> CSVDataManager::LoadCategories() {
     return categories;
 }
 
+uint64_t CSVDataManager::GetLastSavedCategoryVersion() const {
+    return lastSavedCategoryVersion_;
+}
+
+void CSVDataManager::TrackCategory(const CategoryPtr& category) {
+    categoryChanges_->Track(category);
+}
+
+void CSVDataManager::RecordCategoryRemoval(int categoryId) {
+    categoryChanges_->RecordRemoval(categoryId);
+}
+
+void CSVDataManager::ClearCategoryChanges() {
+    categoryChanges_->Clear();
+}
+
+std::vector<CategoryPtr> CSVDataManager::GetCategoriesChangedSince(uint64_t version) const {
+    return categoryChanges_->GetChangedSince(version);
+}
+
+std::vector<int> CSVDataManager::GetCategoriesRemovedSince(uint64_t version) const {
+    return categoryChanges_->GetRemovedSince(version);
+}
+
 // CSV serialization/deserialization
 std::string CSVDataManager::SerializeTask(const TaskPtr& task) const {
     std::ostringstream csv;
@@ -261,7 +344,8 @@ std::string CSVDataManager::SerializeTask(const TaskPtr& task) const {
             tagsStream << ";";
         }
     }
-    csv << EscapeCSVField(tagsStream.str());
+    csv << EscapeCSVField(tagsStream.str()) << ",";
+    csv << HashUtils::ToHex(task->GetFingerprint());
     
     return csv.str();
 }
@@ -274,7 +358,8 @@ std::string CSVDataManager::SerializeCategory(const CategoryPtr& category) const
     csv << EscapeCSVField(category->GetDescription()) << ",";
     csv << EscapeCSVField(category->GetColor()) << ",";
     csv << EscapeCSVField(DateUtils::TimePointToString(category->GetCreatedAt())) << ",";
-    csv << EscapeCSVField(DateUtils::TimePointToString(category->GetUpdatedAt()));
+    csv << EscapeCSVField(DateUtils::TimePointToString(category->GetUpdatedAt())) << ",";
+    csv << HashUtils::ToHex(category->GetFingerprint());
     
     return csv.str();
 }
@@ -288,29 +373,44 @@ TaskPtr CSVDataManager::DeserializeTask(const std::string& csvLine) const {
             return nullptr;
         }
         
-        TaskPtr task = std::make_shared<Task>();
+        // Parsed fields are moved into the task, never copied
+        TaskFields taskFields;
         
         // Basic fields
-        task->SetId(std::stoi(fields[0]));
-        task->SetTitle(fields[1]);
-        task->SetDescription(fields[2]);
+        taskFields.id = std::stoi(fields[0]);
+        taskFields.title = std::move(fields[1]);
+        taskFields.description = std::move(fields[2]);
         
         if (!fields[3].empty()) {
-            task->SetDueDate(DateUtils::StringToTimePoint(fields[3]));
+            taskFields.dueDate = DateUtils::StringToTimePoint(fields[3]);
+        }
+        
+        if (!fields[4].empty()) {
+            taskFields.createdAt = DateUtils::StringToTimePoint(fields[4]);
+        }
+        
+        if (!fields[5].empty()) {
+            taskFields.updatedAt = DateUtils::StringToTimePoint(fields[5]);
         }
         
-        // Note: Timestamps are read-only
         // Priority and status
         if (!fields[7].empty()) {
-            task->SetPriority(Enums::StringToPriority(fields[7]));
+            taskFields.priority = Enums::StringToPriority(fields[7]);
         }
         
         if (!fields[8].empty()) {
-            task->SetStatus(Enums::StringToTaskStatus(fields[8]));
+            taskFields.status = Enums::StringToTaskStatus(fields[8]);
         }
         
-        // Category ID (will be linked later)
-        // Fields[9] contains category ID
+        // Only completed tasks carry a meaningful completion time
+        if (taskFields.status == Enums::TaskStatus::COMPLETED && !fields[6].empty()) {
+            taskFields.completedAt = DateUtils::StringToTimePoint(fields[6]);
+        }
+        
+        // Keep the category ID on a placeholder; the service layer links the full category
+        if (!fields[9].empty() && std::stoi(fields[9]) > 0) {
+            taskFields.category = Category::Reference(std::stoi(fields[9]));
+        }
         
         // Recurrence pattern
         if (!fields[10].empty() && fields[10] != "NONE") {
@@ -328,17 +428,18 @@ TaskPtr CSVDataManager::DeserializeTask(const std::string& csvLine) const {
                     }
                 }
                 
-                RecurrencePatternPtr pattern = std::make_shared<RecurrencePattern>(type, interval, daysOfWeek);
+                RecurrencePattern pattern(type, interval, std::move(daysOfWeek));
                 
                 if (!fields[13].empty()) {
-                    pattern->SetOccurrenceCount(std::stoi(fields[13]));
+                    pattern.SetOccurrenceCount(std::stoi(fields[13]));
                 }
                 
                 if (!fields[14].empty()) {
-                    pattern->SetEndDate(DateUtils::StringToTimePoint(fields[14]));
+                    pattern.SetEndDate(DateUtils::StringToTimePoint(fields[14]));
                 }
                 
-                task->SetRecurrencePattern(pattern);
+                // Share one instance among all tasks with the same pattern
+                taskFields.recurrencePattern = RecurrencePatternRegistry::GetInstance().Intern(pattern);
             } catch (const std::exception& e) {
                 LOG_WARNING("Failed to parse recurrence pattern: " + std::string(e.what()));
             }
@@ -346,10 +447,13 @@ TaskPtr CSVDataManager::DeserializeTask(const std::string& csvLine) const {
         
         // Tags
         if (!fields[15].empty()) {
-            std::vector<std::string> tags = StringUtils::Split(fields[15], ';');
-            task->SetTags(tags);
+            taskFields.tags = StringUtils::Split(fields[15], ';');
         }
         
+        TaskPtr task = std::make_shared<Task>(std::move(taskFields));
+        if (fields.size() > 16) {
+            RecordFingerprint::Verify(fields[16], task->GetFingerprint(), task->GetId(), "CSV");
+        }
         return task;
         
     } catch (const std::exception& e) {
@@ -370,11 +474,23 @@ CategoryPtr CSVDataManager::DeserializeCategory(const std::string& csvLine) cons
         CategoryPtr category = std::make_shared<Category>();
         
         category->SetId(std::stoi(fields[0]));
-        category->SetName(fields[1]);
-        category->SetDescription(fields[2]);
-        category->SetColor(fields[3]);
+        category->SetName(std::move(fields[1]));
+        category->SetDescription(std::move(fields[2]));
+        category->SetColor(std::move(fields[3]));
+        
+        if (!fields[4].empty()) {
+            category->SetCreatedAt(DateUtils::StringToTimePoint(fields[4]));
+        }
         
-        // Note: Timestamps are read-only
+        if (!fields[5].empty()) {
+            category->SetUpdatedAt(DateUtils::StringToTimePoint(fields[5]));
+        }
+        
+        // Freshly loaded, nothing to save yet
+        category->MarkClean();
+        if (fields.size() > 6) {
+            RecordFingerprint::Verify(fields[6], category->GetFingerprint(), category->GetId(), "CSV");
+        }
         
         return category;
         
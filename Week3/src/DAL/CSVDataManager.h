@@ -1,7 +1,9 @@
 #pragma once
+#include "../DAL/ChangeLog.h"
 #include "../DAL/ITaskRepository.h"
 #include "../DAL/ICategoryRepository.h"
 #include "../LIB/Constants.h"
+#include "../LIB/common.h"
 #include "../DTO/Task.h"
 #include "../DTO/Category.h"
 #include <filesystem>
@@ -13,15 +15,31 @@ public:
     // ITaskRepository
     bool SaveTasks(const std::vector<TaskPtr>& tasks) override;
     std::vector<TaskPtr> LoadTasks() override;
+    uint64_t GetLastSavedVersion() const override;
+    void TrackTask(const TaskPtr& task) override;
+    void RecordTaskRemoval(int taskId) override;
+    void ClearTaskChanges() override;
+    std::vector<TaskPtr> GetTasksChangedSince(uint64_t version) const override;
+    std::vector<int> GetTasksRemovedSince(uint64_t version) const override;
     
     // ICategoryRepository
     bool SaveCategories(const std::vector<CategoryPtr>& categories) override;
     std::vector<CategoryPtr> LoadCategories() override;
+    uint64_t GetLastSavedCategoryVersion() const override;
+    void TrackCategory(const CategoryPtr& category) override;
+    void RecordCategoryRemoval(int categoryId) override;
+    void ClearCategoryChanges() override;
+    std::vector<CategoryPtr> GetCategoriesChangedSince(uint64_t version) const override;
+    std::vector<int> GetCategoriesRemovedSince(uint64_t version) const override;
 
 private:
     std::string dataFolder_;
     std::string tasksFile_;
     std::string categoriesFile_;
+    uint64_t lastSavedTaskVersion_ = 0;
+    uint64_t lastSavedCategoryVersion_ = 0;
+    Common::Ref<TaskChangeLog> taskChanges_ = std::make_shared<TaskChangeLog>();
+    Common::Ref<CategoryChangeLog> categoryChanges_ = std::make_shared<CategoryChangeLog>();
     
     // CSV serialization/deserialization
     std::string SerializeTask(const TaskPtr& task) const;
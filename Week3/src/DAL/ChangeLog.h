@@ -0,0 +1,135 @@
+#ifndef _CHANGELOG_H_
+#define _CHANGELOG_H_
+
+#include "../DTO/Category.h"
+#include "../DTO/ChangeSink.h"
+#include "../DTO/Task.h"
+#include "../LIB/IdGenerator.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Version-ordered record of the last change to each tracked task or
+// category (add, update or removal), so "what changed since version V"
+// costs O(log n + k) instead of a scan over every object. Tracked objects
+// report their own version stamps from every setter, whoever calls it; an
+// object reports to the log that tracked it last. Each object has at most
+// one entry; a new change moves the entry to the new version. Must be owned
+// by a shared_ptr. Thread-safe.
+template <typename T>
+class ChangeLog : public IChangeSink<T>, public std::enable_shared_from_this<ChangeLog<T>> {
+public:
+    // Records the object at its current version and follows its changes
+    void Track(const std::shared_ptr<T>& item);
+    void RecordRemoval(int id); // Stamped with a fresh version; stops following
+    void Clear();               // Stops following everything
+
+    // Live objects whose last recorded change is after the version, oldest first
+    std::vector<std::shared_ptr<T>> GetChangedSince(uint64_t version) const;
+    // IDs removed after the version
+    std::vector<int> GetRemovedSince(uint64_t version) const;
+    size_t Size() const;
+
+    // IChangeSink
+    void OnChanged(const T& item) override;
+
+private:
+    struct Entry {
+        int id;
+        std::shared_ptr<T> item; // Null for a removal
+    };
+
+    mutable std::mutex mutex_;
+    std::map<uint64_t, Entry> byVersion_;
+    std::unordered_map<int, uint64_t> versionById_;
+
+    void Put(int id, uint64_t version, std::shared_ptr<T> item);
+};
+
+using TaskChangeLog = ChangeLog<Task>;
+using CategoryChangeLog = ChangeLog<Category>;
+
+template <typename T>
+void ChangeLog<T>::Track(const std::shared_ptr<T>& item) {
+    if (!item) {
+        return;
+    }
+    item->SetChangeSink(this->weak_from_this());
+    std::lock_guard<std::mutex> lock(mutex_);
+    Put(item->GetId(), item->GetVersion(), item);
+}
+
+template <typename T>
+void ChangeLog<T>::RecordRemoval(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Put(id, IdGenerator::GetInstance().GenerateVersion(), nullptr);
+}
+
+template <typename T>
+void ChangeLog<T>::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    byVersion_.clear();
+    versionById_.clear();
+}
+
+template <typename T>
+std::vector<std::shared_ptr<T>> ChangeLog<T>::GetChangedSince(uint64_t version) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<T>> changed;
+    for (auto it = byVersion_.upper_bound(version); it != byVersion_.end(); ++it) {
+        if (it->second.item) {
+            changed.push_back(it->second.item);
+        }
+    }
+    return changed;
+}
+
+template <typename T>
+std::vector<int> ChangeLog<T>::GetRemovedSince(uint64_t version) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> removed;
+    for (auto it = byVersion_.upper_bound(version); it != byVersion_.end(); ++it) {
+        if (!it->second.item) {
+            removed.push_back(it->second.id);
+        }
+    }
+    return removed;
+}
+
+template <typename T>
+size_t ChangeLog<T>::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return byVersion_.size();
+}
+
+template <typename T>
+void ChangeLog<T>::OnChanged(const T& item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Only the tracked object itself moves its entry, not a copy or a removed one
+    auto it = versionById_.find(item.GetId());
+    if (it == versionById_.end()) {
+        return;
+    }
+    auto entry = byVersion_.find(it->second);
+    if (entry->second.item.get() != &item) {
+        return;
+    }
+    Put(item.GetId(), item.GetVersion(), std::move(entry->second.item));
+}
+
+template <typename T>
+void ChangeLog<T>::Put(int id, uint64_t version, std::shared_ptr<T> item) {
+    auto it = versionById_.find(id);
+    if (it != versionById_.end()) {
+        byVersion_.erase(it->second);
+        it->second = version;
+    } else {
+        versionById_.emplace(id, version);
+    }
+    byVersion_[version] = Entry{id, std::move(item)};
+}
+
+#endif // _CHANGELOG_H_
@@ -2,6 +2,7 @@
 #define _ICATEGORYREPOSITORY_H_
 
 #include "../DTO/Category.h"
+#include <cstdint>
 #include <vector>
 
 class ICategoryRepository {
@@ -9,6 +10,16 @@ public:
     virtual ~ICategoryRepository() = default;
     virtual bool SaveCategories(const std::vector<CategoryPtr>& categories) = 0;
     virtual std::vector<CategoryPtr> LoadCategories() = 0;
+
+    // Version watermark of the last successful SaveCategories (0 = never saved)
+    virtual uint64_t GetLastSavedCategoryVersion() const = 0;
+
+    // Change log, as for tasks in ITaskRepository
+    virtual void TrackCategory(const CategoryPtr& category) = 0;
+    virtual void RecordCategoryRemoval(int categoryId) = 0;
+    virtual void ClearCategoryChanges() = 0;
+    virtual std::vector<CategoryPtr> GetCategoriesChangedSince(uint64_t version) const = 0;
+    virtual std::vector<int> GetCategoriesRemovedSince(uint64_t version) const = 0;
 };
 
-#endif // _ICATEGORYREPOSITORY_H_
\ No newline at end of file
+#endif // _ICATEGORYREPOSITORY_H_
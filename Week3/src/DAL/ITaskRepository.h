@@ -2,6 +2,7 @@
 #define _ITASKREPOSITORY_H_
 
 #include "../DTO/Task.h"
+#include <cstdint>
 #include <vector>
 
 class ITaskRepository {
@@ -9,6 +10,20 @@ public:
     virtual ~ITaskRepository() = default;
     virtual bool SaveTasks(const std::vector<TaskPtr>& tasks) = 0;
     virtual std::vector<TaskPtr> LoadTasks() = 0;
+
+    // Version watermark of the last successful SaveTasks or LoadTasks (0 = neither)
+    virtual uint64_t GetLastSavedVersion() const = 0;
+
+    // Change log: a tracked task reports every version stamp itself, so
+    // edits through any setter are seen. SaveTasks and LoadTasks track the
+    // tasks they handle; LoadTasks first forgets earlier ones
+    virtual void TrackTask(const TaskPtr& task) = 0;
+    virtual void RecordTaskRemoval(int taskId) = 0;
+    virtual void ClearTaskChanges() = 0;
+    // Tasks changed after the given version, e.g. since GetLastSavedVersion(),
+    // answered from the log instead of a scan
+    virtual std::vector<TaskPtr> GetTasksChangedSince(uint64_t version) const = 0;
+    virtual std::vector<int> GetTasksRemovedSince(uint64_t version) const = 0;
 };
 
-#endif // _ITASKREPOSITORY_H_
\ No newline at end of file
+#endif // _ITASKREPOSITORY_H_
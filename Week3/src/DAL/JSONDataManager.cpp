@@ -2,6 +2,10 @@
 #include "../LIB/Logger.h"
 #include "../LIB/DateUtils.h"
 #include "../LIB/StringUtils.h"
+#include "../LIB/IdGenerator.h"
+#include "../LIB/HashUtils.h"
+#include "../DAL/RecordFingerprint.h"
+#include "../DTO/RecurrencePatternRegistry.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -31,6 +35,9 @@ JSONDataManager::JSONDataManager(const std::string& dataFolder)
 bool JSONDataManager::SaveTasks(const std::vector<TaskPtr>& tasks) {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    // Everything stamped up to here is covered by this save
+    uint64_t watermark = IdGenerator::GetInstance().GetCurrentVersion();
+    
     try {
         std::ostringstream json;
         json << "[\n";
@@ -49,6 +56,14 @@ bool JSONDataManager::SaveTasks(const std::vector<TaskPtr>& tasks) {
             return false;
         }
         
+        for (const auto& task : tasks) {
+            if (task->GetVersion() <= watermark) {
+                task->MarkClean();
+            }
+            taskChanges_->Track(task);
+        }
+        lastSavedTaskVersion_ = watermark;
+        
         LOG_INFO("Saved " + std::to_string(tasks.size()) + " tasks to " + tasksFile_);
         return true;
         
@@ -110,7 +125,13 @@ std::vector<TaskPtr> JSONDataManager::LoadTasks() {
             }
         }
         
+        taskChanges_->Clear();
+        for (const auto& task : tasks) {
+            taskChanges_->Track(task);
+        }
         LOG_INFO("Loaded " + std::to_string(tasks.size()) + " tasks from " + tasksFile_);
+        // The loaded tasks match the file, like right after a save
+        lastSavedTaskVersion_ = IdGenerator::GetInstance().GetCurrentVersion();
         
     } catch (const std::exception& e) {
         LOG_ERROR("Error loading tasks: " + std::string(e.what()));
@@ -119,10 +140,36 @@ std::vector<TaskPtr> JSONDataManager::LoadTasks() {
     return tasks;
 }
 
+uint64_t JSONDataManager::GetLastSavedVersion() const {
+    return lastSavedTaskVersion_;
+}
+
+void JSONDataManager::TrackTask(const TaskPtr& task) {
+    taskChanges_->Track(task);
+}
+
+void JSONDataManager::RecordTaskRemoval(int taskId) {
+    taskChanges_->RecordRemoval(taskId);
+}
+
+void JSONDataManager::ClearTaskChanges() {
+    taskChanges_->Clear();
+}
+
+std::vector<TaskPtr> JSONDataManager::GetTasksChangedSince(uint64_t version) const {
+    return taskChanges_->GetChangedSince(version);
+}
+
+std::vector<int> JSONDataManager::GetTasksRemovedSince(uint64_t version) const {
+    return taskChanges_->GetRemovedSince(version);
+}
+
 // ICategoryRepository implementation
 bool JSONDataManager::SaveCategories(const std::vector<CategoryPtr>& categories) {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    uint64_t watermark = IdGenerator::GetInstance().GetCurrentVersion();
+    
     try {
         std::ostringstream json;
         json << "[\n";
@@ -141,6 +188,14 @@ bool JSONDataManager::SaveCategories(const std::vector<CategoryPtr>& categories)
             return false;
         }
         
+        for (const auto& category : categories) {
+            if (category->GetVersion() <= watermark) {
+                category->MarkClean();
+            }
+            categoryChanges_->Track(category);
+        }
+        lastSavedCategoryVersion_ = watermark;
+        
         LOG_INFO("Saved " + std::to_string(categories.size()) + " categories to " + categoriesFile_);
         return true;
         
@@ -199,6 +254,10 @@ std::vector<CategoryPtr> JSONDataManager::LoadCategories() {
             }
         }
         
+        categoryChanges_->Clear();
+        for (const auto& category : categories) {
+            categoryChanges_->Track(category);
+        }
         LOG_INFO("Loaded " + std::to_string(categories.size()) + " categories from " + categoriesFile_);
         
     } catch (const std::exception& e) {
@@ -208,6 +267,30 @@ std::vector<CategoryPtr> JSONDataManager::LoadCategories() {
     return categories;
 }
 
+uint64_t JSONDataManager::GetLastSavedCategoryVersion() const {
+    return lastSavedCategoryVersion_;
+}
+
+void JSONDataManager::TrackCategory(const CategoryPtr& category) {
+    categoryChanges_->Track(category);
+}
+
+void JSONDataManager::RecordCategoryRemoval(int categoryId) {
+    categoryChanges_->RecordRemoval(categoryId);
+}
+
+void JSONDataManager::ClearCategoryChanges() {
+    categoryChanges_->Clear();
+}
+
+std::vector<CategoryPtr> JSONDataManager::GetCategoriesChangedSince(uint64_t version) const {
+    return categoryChanges_->GetChangedSince(version);
+}
+
+std::vector<int> JSONDataManager::GetCategoriesRemovedSince(uint64_t version) const {
+    return categoryChanges_->GetRemovedSince(version);
+}
+
 // JSON serialization/deserialization
 std::string JSONDataManager::SerializeTask(const TaskPtr& task) const {
     std::ostringstream json;
@@ -244,7 +327,8 @@ std::string JSONDataManager::SerializeTask(const TaskPtr& task) const {
             json << ", ";
         }
     }
-    json << "]\n";
+    json << "],\n";
+    json << "    \"fingerprint\": \"" << HashUtils::ToHex(task->GetFingerprint()) << "\"\n";
     json << "  }";
     
     return json.str();
@@ -259,7 +343,8 @@ std::string JSONDataManager::SerializeCategory(const CategoryPtr& category) cons
     json << "    \"description\": \"" << EscapeJsonString(category->GetDescription()) << "\",\n";
     json << "    \"color\": \"" << EscapeJsonString(category->GetColor()) << "\",\n";
     json << "    \"createdAt\": \"" << DateUtils::TimePointToString(category->GetCreatedAt()) << "\",\n";
-    json << "    \"updatedAt\": \"" << DateUtils::TimePointToString(category->GetUpdatedAt()) << "\"\n";
+    json << "    \"updatedAt\": \"" << DateUtils::TimePointToString(category->GetUpdatedAt()) << "\",\n";
+    json << "    \"fingerprint\": \"" << HashUtils::ToHex(category->GetFingerprint()) << "\"\n";
     json << "  }";
     
     return json.str();
@@ -292,47 +377,43 @@ std::string JSONDataManager::SerializeRecurrencePattern(const RecurrencePatternP
 
 TaskPtr JSONDataManager::DeserializeTask(const std::string& jsonStr) const {
     try {
-        TaskPtr task = std::make_shared<Task>();
-        
-        task->SetId(ExtractIntValue(jsonStr, "id"));
-        task->SetTitle(ExtractStringValue(jsonStr, "title"));
-        task->SetDescription(ExtractStringValue(jsonStr, "description"));
+        // Parse every field first, then move them into the task in one step
+        TaskFields fields;
         
-        std::string dueDateStr = ExtractStringValue(jsonStr, "dueDate");
-        task->SetDueDate(DateUtils::StringToTimePoint(dueDateStr));
-        
-        // Set timestamps
-        std::string createdAtStr = ExtractStringValue(jsonStr, "createdAt");
-        std::string updatedAtStr = ExtractStringValue(jsonStr, "updatedAt");
-        std::string completedAtStr = ExtractStringValue(jsonStr, "completedAt");
-        
-        // Note: We don't set these through setters as they're internal timestamps
-        // In a real implementation, these would be set through private methods
+        fields.id = ExtractIntValue(jsonStr, "id");
+        fields.title = ExtractStringValue(jsonStr, "title");
+        fields.description = ExtractStringValue(jsonStr, "description");
+        fields.dueDate = DateUtils::StringToTimePoint(ExtractStringValue(jsonStr, "dueDate"));
+        fields.createdAt = DateUtils::StringToTimePoint(ExtractStringValue(jsonStr, "createdAt"));
+        fields.updatedAt = DateUtils::StringToTimePoint(ExtractStringValue(jsonStr, "updatedAt"));
         
         // Set priority and status
-        std::string priorityStr = ExtractStringValue(jsonStr, "priority");
-        task->SetPriority(Enums::StringToPriority(priorityStr));
+        fields.priority = Enums::StringToPriority(ExtractStringValue(jsonStr, "priority"));
+        fields.status = Enums::StringToTaskStatus(ExtractStringValue(jsonStr, "status"));
         
-        std::string statusStr = ExtractStringValue(jsonStr, "status");
-        task->SetStatus(Enums::StringToTaskStatus(statusStr));
+        // Only completed tasks carry a meaningful completion time
+        if (fields.status == Enums::TaskStatus::COMPLETED) {
+            fields.completedAt = DateUtils::StringToTimePoint(ExtractStringValue(jsonStr, "completedAt"));
+        }
         
-        // Set category ID (category will be linked later)
-        std::string categoryIdStr = ExtractStringValue(jsonStr, "categoryId");
-        if (categoryIdStr != "null") {
-            // Category will be linked by the service layer
+        // Keep the category ID on a placeholder; the service layer links the full category
+        if (ExtractStringValue(jsonStr, "categoryId") != "null") {
+            int categoryId = ExtractIntValue(jsonStr, "categoryId");
+            if (categoryId > 0) {
+                fields.category = Category::Reference(categoryId);
+            }
         }
         
         // Set recurrence pattern
         std::string recurrenceStr = ExtractRecurrencePatternJson(jsonStr);
         if (recurrenceStr != "null") {
-            RecurrencePatternPtr pattern = DeserializeRecurrencePattern(recurrenceStr);
-            task->SetRecurrencePattern(pattern);
+            fields.recurrencePattern = DeserializeRecurrencePattern(recurrenceStr);
         }
         
-        // Set tags
-        std::vector<std::string> tags = ExtractStringArray(jsonStr, "tags");
-        task->SetTags(tags);
+        fields.tags = ExtractStringArray(jsonStr, "tags");
         
+        TaskPtr task = std::make_shared<Task>(std::move(fields));
+        RecordFingerprint::Verify(ExtractStringValue(jsonStr, "fingerprint"), task->GetFingerprint(), task->GetId(), "JSON");
         return task;
         
     } catch (const std::exception& e) {
@@ -350,8 +431,19 @@ CategoryPtr JSONDataManager::DeserializeCategory(const std::string& jsonStr) con
         category->SetDescription(ExtractStringValue(jsonStr, "description"));
         category->SetColor(ExtractStringValue(jsonStr, "color"));
         
-        // Note: Timestamps are read-only in Category
-        // In a real implementation, these would be set through private methods
+        std::string createdAtStr = ExtractStringValue(jsonStr, "createdAt");
+        if (!createdAtStr.empty()) {
+            category->SetCreatedAt(DateUtils::StringToTimePoint(createdAtStr));
+        }
+        
+        std::string updatedAtStr = ExtractStringValue(jsonStr, "updatedAt");
+        if (!updatedAtStr.empty()) {
+            category->SetUpdatedAt(DateUtils::StringToTimePoint(updatedAtStr));
+        }
+        
+        // Freshly loaded, nothing to save yet
+        category->MarkClean();
+        RecordFingerprint::Verify(ExtractStringValue(jsonStr, "fingerprint"), category->GetFingerprint(), category->GetId(), "JSON");
         
         return category;
         
@@ -368,18 +460,17 @@ RecurrencePatternPtr JSONDataManager::DeserializeRecurrencePattern(const std::st
         
         int interval = ExtractIntValue(jsonStr, "interval");
         
-        std::vector<Enums::DayOfWeek> daysOfWeek = ExtractDayOfWeekArray(jsonStr, "daysOfWeek");
+        RecurrencePattern pattern(type, interval, ExtractDayOfWeekArray(jsonStr, "daysOfWeek"));
         
-        RecurrencePatternPtr pattern = std::make_shared<RecurrencePattern>(type, interval, daysOfWeek);
-        
-        pattern->SetOccurrenceCount(ExtractIntValue(jsonStr, "occurrenceCount"));
+        pattern.SetOccurrenceCount(ExtractIntValue(jsonStr, "occurrenceCount"));
         
         std::string endDateStr = ExtractStringValue(jsonStr, "endDate");
         if (!endDateStr.empty() && endDateStr != "null") {
-            pattern->SetEndDate(DateUtils::StringToTimePoint(endDateStr));
+            pattern.SetEndDate(DateUtils::StringToTimePoint(endDateStr));
         }
         
-        return pattern;
+        // Share one instance among all tasks with the same pattern
+        return RecurrencePatternRegistry::GetInstance().Intern(pattern);
         
     } catch (const std::exception& e) {
         LOG_ERROR("Failed to deserialize recurrence pattern from JSON: " + std::string(e.what()));
@@ -480,8 +571,7 @@ std::string JSONDataManager::ExtractStringValue(const std::string& json, const s
             return "";
         }
         
-        std::string value = json.substr(pos, endPos - pos);
-        return UnescapeJsonString(value);
+        return UnescapeJsonString(std::string_view(json).substr(pos, endPos - pos));
         
     } else if (json.substr(pos, 4) == "null") {
         // Null value
@@ -583,8 +673,7 @@ std::vector<std::string> JSONDataManager::ExtractStringArray(const std::string&
                 break;
             }
             
-            std::string value = json.substr(pos, endPos - pos);
-            result.push_back(UnescapeJsonString(value));
+            result.push_back(UnescapeJsonString(std::string_view(json).substr(pos, endPos - pos)));
             pos = endPos + 1;
         }
         
@@ -647,7 +736,12 @@ std::string JSONDataManager::EscapeJsonString(const std::string& str) const {
     return result;
 }
 
-std::string JSONDataManager::UnescapeJsonString(const std::string& str) const {
+std::string JSONDataManager::UnescapeJsonString(std::string_view str) const {
+    // Fast path: nothing to unescape, copy the raw characters once
+    if (str.find('\\') == std::string_view::npos) {
+        return std::string(str);
+    }
+    
     std::string result;
     result.reserve(str.length());
     
@@ -1,13 +1,16 @@
 #ifndef _JSONDATAMANAGER_H_
 #define _JSONDATAMANAGER_H_
 
+#include "../DAL/ChangeLog.h"
 #include "../DAL/ITaskRepository.h"
 #include "../DAL/ICategoryRepository.h"
 #include "../LIB/Constants.h"
+#include "../LIB/common.h"
 #include "../DTO/Task.h"
 #include "../DTO/Category.h"
 #include <filesystem>
 #include <fstream>
+#include <string_view>
 
 class JSONDataManager : public ITaskRepository, public ICategoryRepository {
 public:
@@ -16,15 +19,31 @@ public:
     // ITaskRepository
     bool SaveTasks(const std::vector<TaskPtr>& tasks) override;
     std::vector<TaskPtr> LoadTasks() override;
+    uint64_t GetLastSavedVersion() const override;
+    void TrackTask(const TaskPtr& task) override;
+    void RecordTaskRemoval(int taskId) override;
+    void ClearTaskChanges() override;
+    std::vector<TaskPtr> GetTasksChangedSince(uint64_t version) const override;
+    std::vector<int> GetTasksRemovedSince(uint64_t version) const override;
     
     // ICategoryRepository
     bool SaveCategories(const std::vector<CategoryPtr>& categories) override;
     std::vector<CategoryPtr> LoadCategories() override;
+    uint64_t GetLastSavedCategoryVersion() const override;
+    void TrackCategory(const CategoryPtr& category) override;
+    void RecordCategoryRemoval(int categoryId) override;
+    void ClearCategoryChanges() override;
+    std::vector<CategoryPtr> GetCategoriesChangedSince(uint64_t version) const override;
+    std::vector<int> GetCategoriesRemovedSince(uint64_t version) const override;
 
 private:
     std::string dataFolder_;
     std::string tasksFile_;
     std::string categoriesFile_;
+    uint64_t lastSavedTaskVersion_ = 0;
+    uint64_t lastSavedCategoryVersion_ = 0;
+    Common::Ref<TaskChangeLog> taskChanges_ = std::make_shared<TaskChangeLog>();
+    Common::Ref<CategoryChangeLog> categoryChanges_ = std::make_shared<CategoryChangeLog>();
     
     // JSON serialization/deserialization
     std::string SerializeTask(const TaskPtr& task) const;
@@ -49,7 +68,7 @@ private:
 
     // Helper methods for JSON string escaping
     std::string EscapeJsonString(const std::string& str) const;
-    std::string UnescapeJsonString(const std::string& str) const;
+    std::string UnescapeJsonString(std::string_view str) const;
     // Helper to extract recurrence pattern JSON
     std::string ExtractRecurrencePatternJson(const std::string& json) const;
 };
@@ -0,0 +1,18 @@
+#include "RecordFingerprint.h"
+#include "../LIB/HashUtils.h"
+#include "../LIB/Logger.h"
+#include <stdexcept>
+
+void RecordFingerprint::Verify(const std::string& stored, uint64_t actual, int id, const std::string& format) {
+    if (stored.empty() || stored == "null") {
+        return;
+    }
+    
+    try {
+        if (HashUtils::FromHex(stored) != actual) {
+            LOG_WARNING("Fingerprint mismatch for record " + std::to_string(id) + " in " + format + " data");
+        }
+    } catch (const std::exception& e) {
+        LOG_WARNING("Invalid fingerprint for record " + std::to_string(id) + ": " + std::string(e.what()));
+    }
+}
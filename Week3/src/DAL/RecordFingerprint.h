@@ -0,0 +1,16 @@
+#ifndef _RECORDFINGERPRINT_H_
+#define _RECORDFINGERPRINT_H_
+
+#include <cstdint>
+#include <string>
+
+// Load-time check of a stored record fingerprint, shared by the data managers
+class RecordFingerprint {
+public:
+    // Logs a warning when the stored hex value is malformed or differs from
+    // the loaded record's fingerprint; older files without one ("" or "null")
+    // are accepted
+    static void Verify(const std::string& stored, uint64_t actual, int id, const std::string& format);
+};
+
+#endif // _RECORDFINGERPRINT_H_
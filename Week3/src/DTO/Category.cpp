@@ -1,24 +1,38 @@
 #include "Category.h"
-#include "../LIB/DateUtils.h"
+#include "../LIB/Clock.h"
+#include "../LIB/IdGenerator.h"
+#include "../LIB/HashUtils.h"
+#include <memory>
 #include <stdexcept>
 
-Category::Category() 
+Category::Category(const Clock& clock)
     : id_(0)
     , name_("")
     , description_("")
     , color_("#000000")
-    , createdAt_(DateUtils::Now())
-    , updatedAt_(createdAt_) {
+    , createdAt_(clock.Now())
+    , updatedAt_(createdAt_)
+    , version_(IdGenerator::GetInstance().GenerateVersion())
+    , dirty_(true) {
 }
 
 Category::Category(const std::string& name, const std::string& description, 
-                   const std::string& color)
+                   const std::string& color, const Clock& clock)
     : id_(0)
     , name_(name)
     , description_(description)
     , color_(color)
-    , createdAt_(DateUtils::Now())
-    , updatedAt_(createdAt_) {
+    , createdAt_(clock.Now())
+    , updatedAt_(createdAt_)
+    , version_(IdGenerator::GetInstance().GenerateVersion())
+    , dirty_(true) {
+}
+
+Common::Ref<Category> Category::Reference(int id) {
+    auto category = std::make_shared<Category>("Category " + std::to_string(id));
+    category->SetId(id);
+    category->MarkClean();
+    return category;
 }
 
 // Getters
@@ -51,32 +65,102 @@ void Category::SetId(int id) {
     if (id < 0) {
         throw std::invalid_argument("Category ID cannot be negative");
     }
+    if (id == id_) {
+        return;
+    }
     id_ = id;
+    MarkChanged();
 }
 
-void Category::SetName(const std::string& name) {
+void Category::SetName(std::string name) {
     if (name.empty()) {
         throw std::invalid_argument("Category name cannot be empty");
     }
-    name_ = name;
+    if (name == name_) {
+        return;
+    }
+    name_ = std::move(name);
+    MarkChanged();
 }
 
-void Category::SetDescription(const std::string& description) {
-    description_ = description;
+void Category::SetDescription(std::string description) {
+    if (description == description_) {
+        return;
+    }
+    description_ = std::move(description);
+    MarkChanged();
 }
 
-void Category::SetColor(const std::string& color) {
+void Category::SetColor(std::string color) {
     if (color.empty()) {
         throw std::invalid_argument("Category color cannot be empty");
     }
-    color_ = color;
+    if (color == color_) {
+        return;
+    }
+    color_ = std::move(color);
+    MarkChanged();
+}
+
+void Category::SetCreatedAt(const std::chrono::system_clock::time_point& time) {
+    if (time == createdAt_) {
+        return;
+    }
+    createdAt_ = time;
+    MarkChanged();
 }
 
 void Category::SetUpdatedAt(const std::chrono::system_clock::time_point& time) {
+    if (time == updatedAt_) {
+        return;
+    }
     updatedAt_ = time;
+    MarkChanged();
 }
 
 // Utility methods
-void Category::UpdateTimestamp() {
-    updatedAt_ = DateUtils::Now();
+void Category::UpdateTimestamp(const Clock& clock) {
+    updatedAt_ = clock.Now();
+    MarkChanged();
+}
+
+// Change tracking
+uint64_t Category::GetVersion() const {
+    return version_;
+}
+
+bool Category::IsDirty() const {
+    return dirty_;
+}
+
+void Category::MarkClean() {
+    dirty_ = false;
+}
+
+uint64_t Category::GetFingerprint() const {
+    if (fingerprintVersion_ == version_) {
+        return fingerprint_;
+    }
+    
+    fingerprint_ = FingerprintBuilder()
+        .Add(static_cast<int64_t>(id_))
+        .Add(name_)
+        .Add(description_)
+        .Add(color_)
+        .Add(createdAt_)
+        .Finish();
+    fingerprintVersion_ = version_;
+    return fingerprint_;
+}
+
+void Category::SetChangeSink(std::weak_ptr<IChangeSink<Category>> sink) {
+    changeSink_ = std::move(sink);
+}
+
+void Category::MarkChanged() {
+    version_ = IdGenerator::GetInstance().GenerateVersion();
+    dirty_ = true;
+    if (auto sink = changeSink_.lock()) {
+        sink->OnChanged(*this);
+    }
 }
\ No newline at end of file
@@ -1,15 +1,23 @@
 #ifndef CATEGORY_H
 #define CATEGORY_H
 
+#include "ChangeSink.h"
+#include "../LIB/Clock.h"
 #include "../LIB/common.h"
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 
 class Category {
 public:
-    Category();
+    explicit Category(const Clock& clock = Clock::GetInstance());
     Category(const std::string& name, const std::string& description = "", 
-             const std::string& color = "#000000");
+             const std::string& color = "#000000", const Clock& clock = Clock::GetInstance());
+
+    // Stand-in that carries only an ID until the full category is linked;
+    // named "Category <id>" so the name is never empty
+    static Common::Ref<Category> Reference(int id);
 
     // Getters
     int GetId() const;
@@ -21,21 +29,39 @@ public:
 
     // Setters
     void SetId(int id);
-    void SetName(const std::string& name);
-    void SetDescription(const std::string& description);
-    void SetColor(const std::string& color);
+    void SetName(std::string name);
+    void SetDescription(std::string description);
+    void SetColor(std::string color);
+    void SetCreatedAt(const std::chrono::system_clock::time_point& time);
     void SetUpdatedAt(const std::chrono::system_clock::time_point& time);
 
     // Utility methods
-    void UpdateTimestamp();
+    void UpdateTimestamp(const Clock& clock = Clock::GetInstance());
+
+    // Change tracking
+    uint64_t GetVersion() const;
+    bool IsDirty() const;
+    void MarkClean();
+    // Every later version stamp is reported to the sink while it lives
+    void SetChangeSink(std::weak_ptr<IChangeSink<Category>> sink);
+
+    // 64-bit content hash over the persisted fields (except updatedAt)
+    uint64_t GetFingerprint() const;
 
 private:
+    void MarkChanged();
+
     int id_;
     std::string name_;
     std::string description_;
     std::string color_; // Hex color code
     std::chrono::system_clock::time_point createdAt_;
     std::chrono::system_clock::time_point updatedAt_;
+    uint64_t version_;
+    bool dirty_;
+    std::weak_ptr<IChangeSink<Category>> changeSink_;
+    mutable uint64_t fingerprint_ = 0;
+    mutable uint64_t fingerprintVersion_ = 0; // 0 = not computed
 };
 
 using CategoryPtr = Common::Ref<Category>;
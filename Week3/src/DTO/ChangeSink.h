@@ -0,0 +1,13 @@
+#ifndef CHANGE_SINK_H
+#define CHANGE_SINK_H
+
+// Told about every new version stamp of the objects that point at it, from
+// inside their setters, so a change log sees edits made through any code path
+template <typename T>
+class IChangeSink {
+public:
+    virtual ~IChangeSink() = default;
+    virtual void OnChanged(const T& item) = 0;
+};
+
+#endif // CHANGE_SINK_H
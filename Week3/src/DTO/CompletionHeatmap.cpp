@@ -0,0 +1,58 @@
+#include "CompletionHeatmap.h"
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+void CompletionHeatmap::Add(Enums::DayOfWeek day, int hour, int count) {
+    cells_[Index(day, hour)] += count;
+}
+
+int CompletionHeatmap::Get(Enums::DayOfWeek day, int hour) const {
+    return cells_[Index(day, hour)];
+}
+
+int CompletionHeatmap::GetTotal() const {
+    return std::accumulate(cells_.begin(), cells_.end(), 0);
+}
+
+void CompletionHeatmap::Merge(const CompletionHeatmap& other) {
+    for (int i = 0; i < CELLS; ++i) {
+        cells_[i] += other.cells_[i];
+    }
+}
+
+const std::array<int, CompletionHeatmap::CELLS>& CompletionHeatmap::GetCells() const {
+    return cells_;
+}
+
+std::array<int, CompletionHeatmap::CELLS>& CompletionHeatmap::GetCells() {
+    return cells_;
+}
+
+std::string CompletionHeatmap::GenerateText() const {
+    std::ostringstream oss;
+    
+    oss << "     ";
+    for (int hour = 0; hour < HOURS; ++hour) {
+        oss << std::setw(4) << hour;
+    }
+    oss << "\n";
+    
+    for (int day = 0; day < DAYS; ++day) {
+        oss << Enums::DayOfWeekToString(static_cast<Enums::DayOfWeek>(day)).substr(0, 3) << "  ";
+        for (int hour = 0; hour < HOURS; ++hour) {
+            oss << std::setw(4) << cells_[day * HOURS + hour];
+        }
+        oss << "\n";
+    }
+    return oss.str();
+}
+
+int CompletionHeatmap::Index(Enums::DayOfWeek day, int hour) {
+    int dayIndex = static_cast<int>(day);
+    if (dayIndex < 0 || dayIndex >= DAYS || hour < 0 || hour >= HOURS) {
+        throw std::out_of_range("Heatmap cell out of range");
+    }
+    return dayIndex * HOURS + hour;
+}
@@ -0,0 +1,35 @@
+#ifndef COMPLETION_HEATMAP_H
+#define COMPLETION_HEATMAP_H
+
+#include "Enums.h"
+#include "../LIB/common.h"
+#include <array>
+#include <string>
+
+// Completions per local weekday (Sunday first) and hour of day
+class CompletionHeatmap {
+public:
+    static constexpr int DAYS = 7;
+    static constexpr int HOURS = 24;
+    static constexpr int CELLS = DAYS * HOURS;
+
+    void Add(Enums::DayOfWeek day, int hour, int count = 1);
+    int Get(Enums::DayOfWeek day, int hour) const;
+    int GetTotal() const;
+    void Merge(const CompletionHeatmap& other);
+
+    // Row-major by day: index = day * HOURS + hour
+    const std::array<int, CELLS>& GetCells() const;
+    std::array<int, CELLS>& GetCells();
+
+    std::string GenerateText() const;
+
+private:
+    std::array<int, CELLS> cells_{};
+
+    static int Index(Enums::DayOfWeek day, int hour);
+};
+
+using CompletionHeatmapPtr = Common::Ref<CompletionHeatmap>;
+
+#endif // COMPLETION_HEATMAP_H
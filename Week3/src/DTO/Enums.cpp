@@ -3,7 +3,7 @@
 #include <stdexcept>
 
 namespace Enums {
-    std::string PriorityToString(Priority priority) {
+    std::string_view PriorityName(Priority priority) {
         switch (priority) {
             case Priority::LOW:    return "LOW";
             case Priority::MEDIUM: return "MEDIUM";
@@ -13,6 +13,10 @@ namespace Enums {
         }
     }
 
+    std::string PriorityToString(Priority priority) {
+        return std::string(PriorityName(priority));
+    }
+
     Priority StringToPriority(const std::string& str) {
         std::string upper = str;
         std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
@@ -25,7 +29,7 @@ namespace Enums {
         throw std::invalid_argument("Invalid priority string: " + str);
     }
 
-    std::string TaskStatusToString(TaskStatus status) {
+    std::string_view TaskStatusName(TaskStatus status) {
         switch (status) {
             case TaskStatus::PENDING:      return "PENDING";
             case TaskStatus::IN_PROGRESS:  return "IN_PROGRESS";
@@ -35,6 +39,10 @@ namespace Enums {
         }
     }
 
+    std::string TaskStatusToString(TaskStatus status) {
+        return std::string(TaskStatusName(status));
+    }
+
     TaskStatus StringToTaskStatus(const std::string& str) {
         std::string upper = str;
         std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
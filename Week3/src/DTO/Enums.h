@@ -2,6 +2,7 @@
 #define ENUMS_H
 
 #include <string>
+#include <string_view>
 
 namespace Enums {
     enum class Priority {
@@ -37,9 +38,11 @@ namespace Enums {
     };
 
     // Utility functions
+    std::string_view PriorityName(Priority priority); // Static storage, no allocation
     std::string PriorityToString(Priority priority);
     Priority StringToPriority(const std::string& str);
     
+    std::string_view TaskStatusName(TaskStatus status); // Static storage, no allocation
     std::string TaskStatusToString(TaskStatus status);
     TaskStatus StringToTaskStatus(const std::string& str);
     
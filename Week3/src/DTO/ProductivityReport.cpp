@@ -1,7 +1,5 @@
 #include "ProductivityReport.h"
 #include "../LIB/DateUtils.h"
-#include <sstream>
-#include <iomanip>
 #include <algorithm>
 
 ProductivityReport::ProductivityReport(const std::chrono::system_clock::time_point& startDate,
@@ -31,104 +29,160 @@ const std::chrono::system_clock::time_point& ProductivityReport::GetEndDate() co
     return endDate_;
 }
 
+const std::vector<TagCount>& ProductivityReport::GetTopTags() const {
+    return topTags_;
+}
+
+size_t ProductivityReport::GetDistinctTagCount() const {
+    return distinctTagCount_;
+}
+
+// Setters
+void ProductivityReport::SetOverallStats(ProductivityStats stats) {
+    overallStats_ = std::move(stats);
+}
+
+void ProductivityReport::SetCategoryStats(std::map<int, ProductivityStats> categoryStats) {
+    categoryStats_ = std::move(categoryStats);
+}
+
+void ProductivityReport::SetTopTags(std::vector<TagCount> topTags) {
+    topTags_ = std::move(topTags);
+}
+
+void ProductivityReport::SetDistinctTagCount(size_t count) {
+    distinctTagCount_ = count;
+}
+
 // Report generation
 std::string ProductivityReport::GenerateSummaryReport() const {
-    std::ostringstream oss;
-    
+    TextBuffer out;
+    RenderSummary(out);
+    return out.Str();
+}
+
+std::string ProductivityReport::GenerateDetailedReport() const {
+    TextBuffer out;
+    RenderDetailed(out);
+    return out.Str();
+}
+
+void ProductivityReport::Render(ReportFormat format, TextBuffer& out) const {
+    switch (format) {
+        case ReportFormat::SUMMARY:  RenderSummary(out); break;
+        case ReportFormat::DETAILED: RenderDetailed(out); break;
+        case ReportFormat::JSON:     RenderJson(out); break;
+        case ReportFormat::CSV:      RenderCsv(out); break;
+    }
+}
+
+void ProductivityReport::RenderSummary(TextBuffer& out) const {
     // Report header
-    oss << "PRODUCTIVITY REPORT\n";
-    oss << "===================\n";
-    oss << "Period: " << DateUtils::TimePointToString(startDate_) 
-        << " to " << DateUtils::TimePointToString(endDate_) << "\n";
-    oss << "\n";
+    out.Append("PRODUCTIVITY REPORT\n");
+    out.Append("===================\n");
+    out.Append("Period: ").AppendDateTime(startDate_)
+       .Append(" to ").AppendDateTime(endDate_).Append("\n");
+    out.Append("\n");
     
     // Overall statistics
-    oss << "OVERALL STATISTICS\n";
-    oss << "------------------\n";
-    oss << "Total Tasks: " << overallStats_.totalTasks << "\n";
-    oss << "Completed: " << overallStats_.completedTasks 
-        << " (" << std::fixed << std::setprecision(1) 
-        << overallStats_.completionRate * 100 << "%)\n";
-    oss << "Pending: " << overallStats_.pendingTasks << "\n";
-    oss << "Overdue: " << overallStats_.overdueTasks << "\n";
-    oss << "Avg Completion Time: " << std::fixed << std::setprecision(1) 
-        << overallStats_.averageCompletionTimeHours << " hours\n";
-    oss << "\n";
+    out.Append("OVERALL STATISTICS\n");
+    out.Append("------------------\n");
+    out.Append("Total Tasks: ").AppendInt(overallStats_.totalTasks).Append("\n");
+    out.Append("Completed: ").AppendInt(overallStats_.completedTasks)
+       .Append(" (").AppendFixed(overallStats_.completionRate * 100, 1).Append("%)\n");
+    out.Append("Pending: ").AppendInt(overallStats_.pendingTasks).Append("\n");
+    out.Append("Overdue: ").AppendInt(overallStats_.overdueTasks).Append("\n");
+    out.Append("Avg Completion Time: ")
+       .AppendFixed(overallStats_.averageCompletionTimeHours, 1).Append(" hours\n");
+    if (overallStats_.completionTimeP99Hours > 0) {
+        out.Append("Completion Time p50/p90/p99: ")
+           .AppendFixed(overallStats_.completionTimeP50Hours, 1).Append(" / ")
+           .AppendFixed(overallStats_.completionTimeP90Hours, 1).Append(" / ")
+           .AppendFixed(overallStats_.completionTimeP99Hours, 1).Append(" hours\n");
+    }
+    out.Append("\n");
     
     // Tasks by priority
     if (!overallStats_.tasksByPriority.empty()) {
-        oss << "TASKS BY PRIORITY\n";
-        oss << "-----------------\n";
+        out.Append("TASKS BY PRIORITY\n");
+        out.Append("-----------------\n");
         for (const auto& [priority, count] : overallStats_.tasksByPriority) {
-            oss << Enums::PriorityToString(priority) << ": " << count << "\n";
+            out.Append(Enums::PriorityName(priority)).Append(": ").AppendInt(count).Append("\n");
         }
-        oss << "\n";
+        out.Append("\n");
+    }
+    
+    // Most used tags
+    if (!topTags_.empty()) {
+        out.Append("TOP TAGS\n");
+        out.Append("--------\n");
+        for (const auto& tagCount : topTags_) {
+            out.Append(tagCount.tag).Append(": ").AppendInt(tagCount.count).Append("\n");
+        }
+        out.Append("Distinct Tags: ~").AppendUInt(distinctTagCount_).Append("\n");
+        out.Append("\n");
     }
     
     // Category statistics summary
     if (!categoryStats_.empty()) {
-        oss << "CATEGORY SUMMARY\n";
-        oss << "----------------\n";
+        out.Append("CATEGORY SUMMARY\n");
+        out.Append("----------------\n");
         for (const auto& [categoryId, stats] : categoryStats_) {
-            oss << "Category ID: " << categoryId << "\n";
-            oss << "  Tasks: " << stats.totalTasks 
-                << " (Completed: " << stats.completedTasks 
-                << ", Rate: " << std::fixed << std::setprecision(1) 
-                << stats.completionRate * 100 << "%)\n";
+            out.Append("Category ID: ").AppendInt(categoryId).Append("\n");
+            out.Append("  Tasks: ").AppendInt(stats.totalTasks)
+               .Append(" (Completed: ").AppendInt(stats.completedTasks)
+               .Append(", Rate: ").AppendFixed(stats.completionRate * 100, 1).Append("%)\n");
         }
     }
-    
-    return oss.str();
 }
 
-std::string ProductivityReport::GenerateDetailedReport() const {
-    std::ostringstream oss;
-    
+void ProductivityReport::RenderDetailed(TextBuffer& out) const {
     // Include summary
-    oss << GenerateSummaryReport();
-    oss << "\n";
+    RenderSummary(out);
+    out.Append("\n");
     
     // Detailed category breakdown
     if (!categoryStats_.empty()) {
-        oss << "DETAILED CATEGORY ANALYSIS\n";
-        oss << "-------------------------\n";
+        out.Append("DETAILED CATEGORY ANALYSIS\n");
+        out.Append("-------------------------\n");
         
         for (const auto& [categoryId, stats] : categoryStats_) {
-            oss << "\nCATEGORY ID: " << categoryId << "\n";
-            oss << std::string(15 + std::to_string(categoryId).length(), '-') << "\n";
+            size_t headerStart = out.Size();
+            out.Append("\nCATEGORY ID: ").AppendInt(categoryId).Append("\n");
+            // 15 dashes plus one per digit of the ID
+            out.AppendRepeat('-', out.Size() - headerStart).Append("\n");
             
-            oss << "Total Tasks: " << stats.totalTasks << "\n";
-            oss << "Completed: " << stats.completedTasks << "\n";
-            oss << "Pending: " << stats.pendingTasks << "\n";
-            oss << "Overdue: " << stats.overdueTasks << "\n";
-            oss << "Completion Rate: " << std::fixed << std::setprecision(1) 
-                << stats.completionRate * 100 << "%\n";
-            oss << "Average Completion Time: " << std::fixed << std::setprecision(1) 
-                << stats.averageCompletionTimeHours << " hours\n";
+            out.Append("Total Tasks: ").AppendInt(stats.totalTasks).Append("\n");
+            out.Append("Completed: ").AppendInt(stats.completedTasks).Append("\n");
+            out.Append("Pending: ").AppendInt(stats.pendingTasks).Append("\n");
+            out.Append("Overdue: ").AppendInt(stats.overdueTasks).Append("\n");
+            out.Append("Completion Rate: ").AppendFixed(stats.completionRate * 100, 1).Append("%\n");
+            out.Append("Average Completion Time: ")
+               .AppendFixed(stats.averageCompletionTimeHours, 1).Append(" hours\n");
             
             // Tasks by priority for this category
             if (!stats.tasksByPriority.empty()) {
-                oss << "Priority Breakdown:\n";
+                out.Append("Priority Breakdown:\n");
                 for (const auto& [priority, count] : stats.tasksByPriority) {
-                    oss << "  " << Enums::PriorityToString(priority) 
-                        << ": " << count << "\n";
+                    out.Append("  ").Append(Enums::PriorityName(priority))
+                       .Append(": ").AppendInt(count).Append("\n");
                 }
             }
             
             // Tasks by status for this category
             if (!stats.tasksByStatus.empty()) {
-                oss << "Status Breakdown:\n";
+                out.Append("Status Breakdown:\n");
                 for (const auto& [status, count] : stats.tasksByStatus) {
-                    oss << "  " << Enums::TaskStatusToString(status) 
-                        << ": " << count << "\n";
+                    out.Append("  ").Append(Enums::TaskStatusName(status))
+                       .Append(": ").AppendInt(count).Append("\n");
                 }
             }
         }
     }
     
     // Performance analysis
-    oss << "\nPERFORMANCE ANALYSIS\n";
-    oss << "--------------------\n";
+    out.Append("\nPERFORMANCE ANALYSIS\n");
+    out.Append("--------------------\n");
     
     if (overallStats_.totalTasks > 0) {
         double efficiencyScore = overallStats_.completionRate * 100;
@@ -136,31 +190,106 @@ std::string ProductivityReport::GenerateDetailedReport() const {
             efficiencyScore /= overallStats_.averageCompletionTimeHours;
         }
         
-        oss << "Efficiency Score: " << std::fixed << std::setprecision(2) 
-            << efficiencyScore << "\n";
+        out.Append("Efficiency Score: ").AppendFixed(efficiencyScore, 2).Append("\n");
         
         if (overallStats_.completionRate >= 0.8) {
-            oss << "Performance: EXCELLENT\n";
+            out.Append("Performance: EXCELLENT\n");
         } else if (overallStats_.completionRate >= 0.6) {
-            oss << "Performance: GOOD\n";
+            out.Append("Performance: GOOD\n");
         } else if (overallStats_.completionRate >= 0.4) {
-            oss << "Performance: FAIR\n";
+            out.Append("Performance: FAIR\n");
         } else {
-            oss << "Performance: NEEDS IMPROVEMENT\n";
+            out.Append("Performance: NEEDS IMPROVEMENT\n");
         }
         
         if (overallStats_.overdueTasks > 0) {
             double overdueRate = static_cast<double>(overallStats_.overdueTasks) / 
                                overallStats_.totalTasks;
-            oss << "Overdue Rate: " << std::fixed << std::setprecision(1) 
-                << overdueRate * 100 << "%\n";
+            out.Append("Overdue Rate: ").AppendFixed(overdueRate * 100, 1).Append("%\n");
             
             if (overdueRate > 0.2) {
-                oss << "Recommendation: Focus on meeting deadlines\n";
+                out.Append("Recommendation: Focus on meeting deadlines\n");
             }
         }
     }
+}
+
+void ProductivityReport::RenderJson(TextBuffer& out) const {
+    // Single line, so batches can be written as JSON Lines
+    out.Append("{\"startDate\":\"").AppendDateTime(startDate_);
+    out.Append("\",\"endDate\":\"").AppendDateTime(endDate_).Append("\"");
+    out.Append(",\"overall\":");
+    RenderJsonStats(overallStats_, out);
+    
+    out.Append(",\"categories\":[");
+    bool first = true;
+    for (const auto& [categoryId, stats] : categoryStats_) {
+        out.Append(first ? "" : ",").Append("{\"categoryId\":").AppendInt(categoryId).Append(",\"stats\":");
+        RenderJsonStats(stats, out);
+        out.Append("}");
+        first = false;
+    }
+    
+    out.Append("],\"topTags\":[");
+    first = true;
+    for (const auto& tagCount : topTags_) {
+        out.Append(first ? "{\"tag\":" : ",{\"tag\":").AppendJsonString(tagCount.tag)
+           .Append(",\"count\":").AppendInt(tagCount.count).Append("}");
+        first = false;
+    }
+    out.Append("],\"distinctTags\":").AppendUInt(distinctTagCount_).Append("}");
+}
+
+void ProductivityReport::RenderCsvHeader(TextBuffer& out) {
+    out.Append("startDate,endDate,scope,categoryId,totalTasks,completedTasks,pendingTasks,overdueTasks,"
+               "completionRate,averageCompletionTimeHours,completionTimeP50Hours,"
+               "completionTimeP90Hours,completionTimeP99Hours\n");
+}
 
+void ProductivityReport::RenderCsv(TextBuffer& out) const {
+    auto row = [&](std::string_view scope, int categoryId, const ProductivityStats& stats) {
+        out.AppendDateTime(startDate_).Append(",")
+           .AppendDateTime(endDate_).Append(",")
+           .Append(scope).Append(",").AppendInt(categoryId).Append(",")
+           .AppendInt(stats.totalTasks).Append(",").AppendInt(stats.completedTasks).Append(",")
+           .AppendInt(stats.pendingTasks).Append(",").AppendInt(stats.overdueTasks).Append(",")
+           .AppendDouble(stats.completionRate).Append(",")
+           .AppendDouble(stats.averageCompletionTimeHours).Append(",")
+           .AppendDouble(stats.completionTimeP50Hours).Append(",")
+           .AppendDouble(stats.completionTimeP90Hours).Append(",")
+           .AppendDouble(stats.completionTimeP99Hours).Append("\n");
+    };
     
-    return oss.str();
-}
\ No newline at end of file
+    row("overall", 0, overallStats_);
+    for (const auto& [categoryId, stats] : categoryStats_) {
+        row("category", categoryId, stats);
+    }
+}
+
+void ProductivityReport::RenderJsonStats(const ProductivityStats& stats, TextBuffer& out) {
+    out.Append("{\"totalTasks\":").AppendInt(stats.totalTasks)
+       .Append(",\"completedTasks\":").AppendInt(stats.completedTasks)
+       .Append(",\"pendingTasks\":").AppendInt(stats.pendingTasks)
+       .Append(",\"overdueTasks\":").AppendInt(stats.overdueTasks)
+       .Append(",\"completionRate\":").AppendJsonNumber(stats.completionRate)
+       .Append(",\"averageCompletionTimeHours\":").AppendJsonNumber(stats.averageCompletionTimeHours)
+       .Append(",\"completionTimeP50Hours\":").AppendJsonNumber(stats.completionTimeP50Hours)
+       .Append(",\"completionTimeP90Hours\":").AppendJsonNumber(stats.completionTimeP90Hours)
+       .Append(",\"completionTimeP99Hours\":").AppendJsonNumber(stats.completionTimeP99Hours);
+    
+    out.Append(",\"tasksByPriority\":{");
+    bool first = true;
+    for (const auto& [priority, count] : stats.tasksByPriority) {
+        out.Append(first ? "\"" : ",\"").Append(Enums::PriorityName(priority))
+           .Append("\":").AppendInt(count);
+        first = false;
+    }
+    out.Append("},\"tasksByStatus\":{");
+    first = true;
+    for (const auto& [status, count] : stats.tasksByStatus) {
+        out.Append(first ? "\"" : ",\"").Append(Enums::TaskStatusName(status))
+           .Append("\":").AppendInt(count);
+        first = false;
+    }
+    out.Append("}}");
+}
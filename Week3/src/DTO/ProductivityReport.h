@@ -3,8 +3,23 @@
 
 #include "ProductivityStats.h"
 #include "../LIB/common.h"
+#include "../LIB/TextBuffer.h"
 #include <chrono>
 #include <map>
+#include <string>
+#include <vector>
+
+enum class ReportFormat {
+    SUMMARY,  // Same text as GenerateSummaryReport
+    DETAILED, // Same text as GenerateDetailedReport
+    JSON,     // One object per report, on a single line
+    CSV       // One row per scope; header via RenderCsvHeader
+};
+
+struct TagCount {
+    std::string tag;
+    int64_t count = 0; // Upper bound when produced by a sketch
+};
 
 class ProductivityReport {
 public:
@@ -16,16 +31,36 @@ public:
     const std::map<int, ProductivityStats>& GetCategoryStats() const; // key: category ID
     const std::chrono::system_clock::time_point& GetStartDate() const;
     const std::chrono::system_clock::time_point& GetEndDate() const;
+    const std::vector<TagCount>& GetTopTags() const;
+    size_t GetDistinctTagCount() const; // Estimated
+    
+    // Setters
+    void SetOverallStats(ProductivityStats stats);
+    void SetCategoryStats(std::map<int, ProductivityStats> categoryStats);
+    void SetTopTags(std::vector<TagCount> topTags);
+    void SetDistinctTagCount(size_t count);
     
     // Report generation
     std::string GenerateSummaryReport() const;
     std::string GenerateDetailedReport() const;
+    
+    // Rendering into a caller-owned buffer (appends, never clears)
+    void Render(ReportFormat format, TextBuffer& out) const;
+    void RenderSummary(TextBuffer& out) const;
+    void RenderDetailed(TextBuffer& out) const;
+    void RenderJson(TextBuffer& out) const;
+    void RenderCsv(TextBuffer& out) const;
+    static void RenderCsvHeader(TextBuffer& out);
 
 private:
     std::chrono::system_clock::time_point startDate_;
     std::chrono::system_clock::time_point endDate_;
     ProductivityStats overallStats_;
     std::map<int, ProductivityStats> categoryStats_;
+    std::vector<TagCount> topTags_;
+    size_t distinctTagCount_ = 0;
+
+    static void RenderJsonStats(const ProductivityStats& stats, TextBuffer& out);
 };
 
 using ProductivityReportPtr = Common::Ref<ProductivityReport>;
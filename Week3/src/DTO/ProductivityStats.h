@@ -11,6 +11,10 @@ struct ProductivityStats {
     int pendingTasks = 0;
     double completionRate = 0.0;
     double averageCompletionTimeHours = 0.0;
+    // Approximate completion-time percentiles (histogram buckets, ~1.6% error)
+    double completionTimeP50Hours = 0.0;
+    double completionTimeP90Hours = 0.0;
+    double completionTimeP99Hours = 0.0;
     std::map<Enums::Priority, int> tasksByPriority;
     std::map<Enums::TaskStatus, int> tasksByStatus;
 };
@@ -10,20 +10,31 @@ RecurrencePattern::RecurrencePattern()
 }
 
 RecurrencePattern::RecurrencePattern(Enums::RecurrenceType type, int interval, 
-                                   const std::vector<Enums::DayOfWeek>& daysOfWeek)
+                                   std::vector<Enums::DayOfWeek> daysOfWeek)
     : type_(type)
     , interval_(interval)
-    , daysOfWeek_(daysOfWeek)
+    , daysOfWeek_(std::move(daysOfWeek))
     , occurrenceCount_(0)
     , endDate_(std::chrono::system_clock::time_point::max()) {
-    
-    if (interval <= 0) {
-        throw std::invalid_argument("Recurrence interval must be positive");
-    }
-    
-    if (type == Enums::RecurrenceType::WEEKLY && daysOfWeek_.empty()) {
-        throw std::invalid_argument("Weekly recurrence requires at least one day of week");
-    }
+    Validate();
+}
+
+RecurrencePattern::RecurrencePattern(const RecurrencePattern& other)
+    : type_(other.type_)
+    , interval_(other.interval_)
+    , daysOfWeek_(other.daysOfWeek_)
+    , occurrenceCount_(other.occurrenceCount_)
+    , endDate_(other.endDate_) {
+}
+
+RecurrencePattern& RecurrencePattern::operator=(const RecurrencePattern& other) {
+    EnsureMutable();
+    type_ = other.type_;
+    interval_ = other.interval_;
+    daysOfWeek_ = other.daysOfWeek_;
+    occurrenceCount_ = other.occurrenceCount_;
+    endDate_ = other.endDate_;
+    return *this;
 }
 
 // Getters
@@ -49,24 +60,28 @@ const std::chrono::system_clock::time_point& RecurrencePattern::GetEndDate() con
 
 // Setters
 void RecurrencePattern::SetType(Enums::RecurrenceType type) {
+    EnsureMutable();
     type_ = type;
 }
 
 void RecurrencePattern::SetInterval(int interval) {
+    EnsureMutable();
     if (interval <= 0) {
         throw std::invalid_argument("Recurrence interval must be positive");
     }
     interval_ = interval;
 }
 
-void RecurrencePattern::SetDaysOfWeek(const std::vector<Enums::DayOfWeek>& daysOfWeek) {
+void RecurrencePattern::SetDaysOfWeek(std::vector<Enums::DayOfWeek> daysOfWeek) {
+    EnsureMutable();
     if (type_ == Enums::RecurrenceType::WEEKLY && daysOfWeek.empty()) {
         throw std::invalid_argument("Weekly recurrence requires at least one day of week");
     }
-    daysOfWeek_ = daysOfWeek;
+    daysOfWeek_ = std::move(daysOfWeek);
 }
 
 void RecurrencePattern::SetOccurrenceCount(int count) {
+    EnsureMutable();
     if (count < 0) {
         throw std::invalid_argument("Occurrence count cannot be negative");
     }
@@ -74,6 +89,7 @@ void RecurrencePattern::SetOccurrenceCount(int count) {
 }
 
 void RecurrencePattern::SetEndDate(const std::chrono::system_clock::time_point& endDate) {
+    EnsureMutable();
     endDate_ = endDate;
 }
 
@@ -81,3 +97,28 @@ void RecurrencePattern::SetEndDate(const std::chrono::system_clock::time_point&
 bool RecurrencePattern::IsRecurring() const {
     return type_ != Enums::RecurrenceType::NONE;
 }
+
+
+bool RecurrencePattern::IsInterned() const {
+    return interned_;
+}
+
+RecurrencePatternPtr RecurrencePattern::Clone() const {
+    return std::make_shared<RecurrencePattern>(*this);
+}
+
+void RecurrencePattern::EnsureMutable() const {
+    if (interned_) {
+        throw std::logic_error("Interned recurrence pattern is read-only, clone it before editing");
+    }
+}
+
+void RecurrencePattern::Validate() const {
+    if (interval_ <= 0) {
+        throw std::invalid_argument("Recurrence interval must be positive");
+    }
+    
+    if (type_ == Enums::RecurrenceType::WEEKLY && daysOfWeek_.empty()) {
+        throw std::invalid_argument("Weekly recurrence requires at least one day of week");
+    }
+}
\ No newline at end of file
@@ -11,7 +11,10 @@ class RecurrencePattern {
 public:
     RecurrencePattern();
     RecurrencePattern(Enums::RecurrenceType type, int interval, 
-                     const std::vector<Enums::DayOfWeek>& daysOfWeek = {});
+                     std::vector<Enums::DayOfWeek> daysOfWeek = {});
+    // Copies are never interned, so they can be edited freely
+    RecurrencePattern(const RecurrencePattern& other);
+    RecurrencePattern& operator=(const RecurrencePattern& other);
 
     // Getters
     Enums::RecurrenceType GetType() const;
@@ -23,19 +26,27 @@ public:
     // Setters
     void SetType(Enums::RecurrenceType type);
     void SetInterval(int interval);
-    void SetDaysOfWeek(const std::vector<Enums::DayOfWeek>& daysOfWeek);
+    void SetDaysOfWeek(std::vector<Enums::DayOfWeek> daysOfWeek);
     void SetOccurrenceCount(int count);
     void SetEndDate(const std::chrono::system_clock::time_point& endDate);
 
     // Utility methods
     bool IsRecurring() const;
+    bool IsInterned() const; // Shared canonical instance, read-only
+    Common::Ref<RecurrencePattern> Clone() const; // Private, mutable copy
 
 private:
+    friend class RecurrencePatternRegistry;
+
+    void EnsureMutable() const;
+    void Validate() const;
+
     Enums::RecurrenceType type_;
     int interval_; // e.g., every 2 days, every 3 weeks
     std::vector<Enums::DayOfWeek> daysOfWeek_; // For weekly recurrence
     int occurrenceCount_; // 0 means infinite
     std::chrono::system_clock::time_point endDate_;
+    bool interned_ = false;
 };
 
 using RecurrencePatternPtr = Common::Ref<RecurrencePattern>;
@@ -0,0 +1,83 @@
+#include "RecurrencePatternRegistry.h"
+#include <algorithm>
+#include <functional>
+
+RecurrencePatternRegistry& RecurrencePatternRegistry::GetInstance() {
+    static RecurrencePatternRegistry instance;
+    return instance;
+}
+
+RecurrencePatternPtr RecurrencePatternRegistry::Intern(const RecurrencePattern& pattern) {
+    Key key = MakeKey(pattern);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = patterns_.find(key);
+    if (it != patterns_.end()) {
+        if (auto existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    auto canonical = std::make_shared<RecurrencePattern>(pattern);
+    canonical->interned_ = true;
+    patterns_[std::move(key)] = canonical;
+    if (patterns_.size() >= pruneAt_) {
+        PruneExpired();
+    }
+    return canonical;
+}
+
+RecurrencePatternPtr RecurrencePatternRegistry::Intern(const RecurrencePatternPtr& pattern) {
+    if (!pattern) {
+        return nullptr;
+    }
+    return Intern(*pattern);
+}
+
+size_t RecurrencePatternRegistry::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t live = 0;
+    for (const auto& [key, pattern] : patterns_) {
+        live += pattern.expired() ? 0 : 1;
+    }
+    return live;
+}
+
+void RecurrencePatternRegistry::Clear() {
+    // Tasks keep their shared instances alive; only the lookup table is dropped
+    std::lock_guard<std::mutex> lock(mutex_);
+    patterns_.clear();
+    pruneAt_ = MIN_PRUNE_SIZE;
+}
+
+// Drops released patterns; the threshold doubles with the live count so
+// pruning stays amortized O(1) per Intern
+void RecurrencePatternRegistry::PruneExpired() {
+    std::erase_if(patterns_, [](const auto& entry) { return entry.second.expired(); });
+    pruneAt_ = std::max(MIN_PRUNE_SIZE, patterns_.size() * 2);
+}
+
+RecurrencePatternRegistry::Key RecurrencePatternRegistry::MakeKey(const RecurrencePattern& pattern) {
+    return Key{
+        pattern.GetType(),
+        pattern.GetInterval(),
+        pattern.GetDaysOfWeek(),
+        pattern.GetOccurrenceCount(),
+        static_cast<int64_t>(pattern.GetEndDate().time_since_epoch().count())
+    };
+}
+
+size_t RecurrencePatternRegistry::KeyHash::operator()(const Key& key) const {
+    size_t seed = std::hash<int>()(static_cast<int>(key.type));
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+
+    combine(std::hash<int>()(key.interval));
+    for (auto day : key.daysOfWeek) {
+        combine(std::hash<int>()(static_cast<int>(day)));
+    }
+    combine(std::hash<int>()(key.occurrenceCount));
+    combine(std::hash<int64_t>()(key.endDateTicks));
+    return seed;
+}
@@ -0,0 +1,52 @@
+#ifndef RECURRENCE_PATTERN_REGISTRY_H
+#define RECURRENCE_PATTERN_REGISTRY_H
+
+#include "RecurrencePattern.h"
+#include "../LIB/common.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Flyweight registry: identical patterns share one read-only instance.
+// Tasks that need to edit an interned pattern get a private clone
+// (see Task::EditRecurrencePattern). Entries are weak, so a pattern no
+// task uses any more is released and its slot pruned on a later Intern.
+class RecurrencePatternRegistry {
+public:
+    static RecurrencePatternRegistry& GetInstance();
+
+    RecurrencePatternPtr Intern(const RecurrencePattern& pattern);
+    RecurrencePatternPtr Intern(const RecurrencePatternPtr& pattern);
+
+    size_t Size() const; // Live patterns
+    void Clear();
+
+private:
+    RecurrencePatternRegistry() = default;
+
+    struct Key {
+        Enums::RecurrenceType type;
+        int interval;
+        std::vector<Enums::DayOfWeek> daysOfWeek;
+        int occurrenceCount;
+        int64_t endDateTicks;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    static Key MakeKey(const RecurrencePattern& pattern);
+    void PruneExpired();
+
+    static constexpr size_t MIN_PRUNE_SIZE = 64;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::weak_ptr<RecurrencePattern>, KeyHash> patterns_;
+    size_t pruneAt_ = MIN_PRUNE_SIZE;
+};
+
+#endif // RECURRENCE_PATTERN_REGISTRY_H
@@ -1,36 +1,67 @@
 #include "Task.h"
-#include "../LIB/DateUtils.h"
+#include "../LIB/Clock.h"
+#include "../LIB/IdGenerator.h"
+#include "../LIB/HashUtils.h"
 #include <algorithm>
 #include <stdexcept>
 
-Task::Task()
+Task::Task(const Clock& clock)
     : id_(0)
     , title_("")
     , description_("")
-    , dueDate_(DateUtils::Now())
-    , createdAt_(DateUtils::Now())
+    , dueDate_(clock.Now())
+    , createdAt_(dueDate_)
     , updatedAt_(createdAt_)
     , completedAt_(std::chrono::system_clock::time_point::min())
     , priority_(Enums::Priority::MEDIUM)
     , status_(Enums::TaskStatus::PENDING)
     , category_(nullptr)
-    , recurrencePattern_(nullptr) {
+    , recurrencePattern_(nullptr)
+    , version_(IdGenerator::GetInstance().GenerateVersion())
+    , dirty_(true) {
 }
 
 Task::Task(const std::string& title, const std::string& description,
            const std::chrono::system_clock::time_point& dueDate,
-           Enums::Priority priority, CategoryPtr category)
+           Enums::Priority priority, CategoryPtr category, const Clock& clock)
     : id_(0)
     , title_(title)
     , description_(description)
     , dueDate_(dueDate)
-    , createdAt_(DateUtils::Now())
+    , createdAt_(clock.Now())
     , updatedAt_(createdAt_)
     , completedAt_(std::chrono::system_clock::time_point::min())
     , priority_(priority)
     , status_(Enums::TaskStatus::PENDING)
     , category_(category)
-    , recurrencePattern_(nullptr) {
+    , recurrencePattern_(nullptr)
+    , version_(IdGenerator::GetInstance().GenerateVersion())
+    , dirty_(true) {
+}
+
+Task::Task(TaskFields&& fields)
+    : id_(fields.id)
+    , title_(std::move(fields.title))
+    , description_(std::move(fields.description))
+    , dueDate_(fields.dueDate)
+    , createdAt_(fields.createdAt)
+    , updatedAt_(fields.updatedAt)
+    , completedAt_(fields.completedAt)
+    , priority_(fields.priority)
+    , status_(fields.status)
+    , category_(std::move(fields.category))
+    , recurrencePattern_(std::move(fields.recurrencePattern))
+    , tags_(std::move(fields.tags))
+    , version_(IdGenerator::GetInstance().GenerateVersion())
+    , dirty_(false) {
+    
+    if (id_ < 0) {
+        throw std::invalid_argument("Task ID cannot be negative");
+    }
+    
+    if (title_.empty()) {
+        throw std::invalid_argument("Task title cannot be empty");
+    }
 }
 
 // Getters
@@ -74,10 +105,23 @@ CategoryPtr Task::GetCategory() const {
     return category_;
 }
 
+int Task::GetCategoryId() const {
+    return category_ ? category_->GetId() : 0;
+}
+
 RecurrencePatternPtr Task::GetRecurrencePattern() const {
     return recurrencePattern_;
 }
 
+RecurrencePatternPtr Task::EditRecurrencePattern() {
+    if (recurrencePattern_ && recurrencePattern_->IsInterned()) {
+        recurrencePattern_ = recurrencePattern_->Clone();
+    }
+    // The caller is about to modify the pattern
+    MarkChanged();
+    return recurrencePattern_;
+}
+
 const std::vector<std::string>& Task::GetTags() const {
     return tags_;
 }
@@ -87,57 +131,101 @@ void Task::SetId(int id) {
     if (id < 0) {
         throw std::invalid_argument("Task ID cannot be negative");
     }
+    if (id == id_) {
+        return;
+    }
+    if (idLocked_) {
+        throw std::logic_error("Task ID is locked while the task is owned by a service");
+    }
     id_ = id;
+    MarkChanged();
 }
 
-void Task::SetTitle(const std::string& title) {
+void Task::SetTitle(std::string title) {
     if (title.empty()) {
         throw std::invalid_argument("Task title cannot be empty");
     }
-    title_ = title;
+    if (title == title_) {
+        return;
+    }
+    title_ = std::move(title);
+    MarkChanged();
 }
 
-void Task::SetDescription(const std::string& description) {
-    description_ = description;
+void Task::SetDescription(std::string description) {
+    if (description == description_) {
+        return;
+    }
+    description_ = std::move(description);
+    MarkChanged();
 }
 
 void Task::SetDueDate(const std::chrono::system_clock::time_point& dueDate) {
     if (dueDate < createdAt_) {
         throw std::invalid_argument("Due date cannot be before creation date");
     }
+    if (dueDate == dueDate_) {
+        return;
+    }
     dueDate_ = dueDate;
+    MarkChanged();
 }
 
 void Task::SetPriority(Enums::Priority priority) {
+    if (priority == priority_) {
+        return;
+    }
     priority_ = priority;
+    MarkChanged();
 }
 
-void Task::SetStatus(Enums::TaskStatus status) {
-    if (status == Enums::TaskStatus::COMPLETED && status_ != Enums::TaskStatus::COMPLETED) {
-        completedAt_ = DateUtils::Now();
+void Task::SetStatus(Enums::TaskStatus status, const Clock& clock) {
+    if (status == status_) {
+        return;
+    }
+    if (status == Enums::TaskStatus::COMPLETED) {
+        completedAt_ = clock.Now();
     }
     status_ = status;
+    MarkChanged();
 }
 
 void Task::SetCategory(CategoryPtr category) {
-    category_ = category;
+    if (category == category_) {
+        return;
+    }
+    category_ = std::move(category);
+    MarkChanged();
 }
 
 void Task::SetRecurrencePattern(RecurrencePatternPtr pattern) {
-    recurrencePattern_ = pattern;
+    if (pattern == recurrencePattern_) {
+        return;
+    }
+    recurrencePattern_ = std::move(pattern);
+    MarkChanged();
 }
 
-void Task::SetTags(const std::vector<std::string>& tags) {
-    tags_ = tags;
+void Task::SetTags(std::vector<std::string> tags) {
+    if (tags == tags_) {
+        return;
+    }
+    tags_ = std::move(tags);
+    MarkChanged();
 }
 
 void Task::SetUpdatedAt(const std::chrono::system_clock::time_point& time) {
+    if (time == updatedAt_) {
+        return;
+    }
     updatedAt_ = time;
+    MarkChanged();
 }
 
 // Utility methods
-void Task::UpdateTimestamp() {
-    updatedAt_ = DateUtils::Now();
+void Task::UpdateTimestamp(const Clock& clock) {
+    updatedAt_ = clock.Now();
+    MarkChanged();
 }
 
 bool Task::IsRecurring() const {
@@ -148,7 +236,7 @@ bool Task::HasCategory() const {
     return category_ != nullptr;
 }
 
-void Task::AddTag(const std::string& tag) {
+void Task::AddTag(std::string tag) {
     if (tag.empty()) {
         return;
     }
@@ -156,7 +244,8 @@ void Task::AddTag(const std::string& tag) {
     // Check if tag already exists
     auto it = std::find(tags_.begin(), tags_.end(), tag);
     if (it == tags_.end()) {
-        tags_.push_back(tag);
+        tags_.push_back(std::move(tag));
+        MarkChanged();
     }
 }
 
@@ -164,5 +253,80 @@ void Task::RemoveTag(const std::string& tag) {
     auto it = std::find(tags_.begin(), tags_.end(), tag);
     if (it != tags_.end()) {
         tags_.erase(it);
+        MarkChanged();
+    }
+}
+
+void Task::LockId() {
+    idLocked_ = true;
+}
+
+void Task::UnlockId() {
+    idLocked_ = false;
+}
+
+// Change tracking
+uint64_t Task::GetVersion() const {
+    return version_;
+}
+
+bool Task::IsDirty() const {
+    return dirty_;
+}
+
+void Task::MarkClean() {
+    dirty_ = false;
+}
+
+uint64_t Task::GetFingerprint() const {
+    if (fingerprintVersion_ != version_) {
+        // A reopened task keeps its old completion time, which is not saved
+        bool completed = status_ == Enums::TaskStatus::COMPLETED;
+        FingerprintBuilder prefix;
+        prefix.Add(static_cast<int64_t>(id_))
+              .Add(title_)
+              .Add(description_)
+              .Add(dueDate_)
+              .Add(createdAt_)
+              .Add(completed ? completedAt_ : std::chrono::system_clock::time_point::min())
+              .Add(static_cast<int64_t>(priority_))
+              .Add(static_cast<int64_t>(status_));
+        fingerprintPrefix_ = prefix.GetState();
+        fingerprintVersion_ = version_;
+    }
+    
+    FingerprintBuilder builder(fingerprintPrefix_);
+    builder.Add(static_cast<int64_t>(category_ ? category_->GetId() : 0));
+    
+    if (recurrencePattern_) {
+        builder.Add(static_cast<int64_t>(recurrencePattern_->GetType()))
+               .Add(static_cast<int64_t>(recurrencePattern_->GetInterval()))
+               .Add(static_cast<int64_t>(recurrencePattern_->GetDaysOfWeek().size()));
+        for (auto day : recurrencePattern_->GetDaysOfWeek()) {
+            builder.Add(static_cast<int64_t>(day));
+        }
+        builder.Add(static_cast<int64_t>(recurrencePattern_->GetOccurrenceCount()))
+               .Add(recurrencePattern_->GetEndDate());
+    } else {
+        builder.Add(static_cast<int64_t>(Enums::RecurrenceType::NONE));
+    }
+    
+    builder.Add(static_cast<int64_t>(tags_.size()));
+    for (const auto& tag : tags_) {
+        builder.Add(tag);
+    }
+    
+    return builder.Finish();
+}
+
+void Task::SetChangeSink(std::weak_ptr<IChangeSink<Task>> sink) {
+    changeSink_ = std::move(sink);
+}
+
+void Task::MarkChanged() {
+    version_ = IdGenerator::GetInstance().GenerateVersion();
+    dirty_ = true;
+    if (auto sink = changeSink_.lock()) {
+        sink->OnChanged(*this);
     }
 }
\ No newline at end of file
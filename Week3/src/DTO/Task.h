@@ -2,23 +2,47 @@
 #define TASK_H
 
 #include "Category.h"
+#include "ChangeSink.h"
 #include "RecurrencePattern.h"
 #include "Enums.h"
+#include "../LIB/Clock.h"
 #include "../LIB/common.h"
 #include <string>
 #include <chrono>
 #include <vector>
+#include <cstdint>
+#include <memory>
 
 class Task;
 using TaskPtr = Common::Ref<Task>;
+using ConstTaskPtr = Common::Ref<const Task>;
+
+// All persisted fields of a task, filled by the deserializers and moved
+// into a Task in one step (no per-field copies, no setter side effects)
+struct TaskFields {
+    int id = 0;
+    std::string title;
+    std::string description;
+    std::chrono::system_clock::time_point dueDate;
+    std::chrono::system_clock::time_point createdAt;
+    std::chrono::system_clock::time_point updatedAt;
+    std::chrono::system_clock::time_point completedAt = std::chrono::system_clock::time_point::min();
+    Enums::Priority priority = Enums::Priority::MEDIUM;
+    Enums::TaskStatus status = Enums::TaskStatus::PENDING;
+    CategoryPtr category;
+    RecurrencePatternPtr recurrencePattern;
+    std::vector<std::string> tags;
+};
 
 class Task {
 public:
-    Task();
+    explicit Task(const Clock& clock = Clock::GetInstance());
     Task(const std::string& title, const std::string& description,
          const std::chrono::system_clock::time_point& dueDate,
          Enums::Priority priority = Enums::Priority::MEDIUM,
-         CategoryPtr category = nullptr);
+         CategoryPtr category = nullptr,
+         const Clock& clock = Clock::GetInstance());
+    explicit Task(TaskFields&& fields);
 
     // Getters
     int GetId() const;
@@ -31,29 +55,50 @@ public:
     Enums::Priority GetPriority() const;
     Enums::TaskStatus GetStatus() const;
     CategoryPtr GetCategory() const;
+    int GetCategoryId() const; // 0 when uncategorized; no shared_ptr copy
     RecurrencePatternPtr GetRecurrencePattern() const;
+    RecurrencePatternPtr EditRecurrencePattern(); // Copy-on-write for interned patterns
     const std::vector<std::string>& GetTags() const;
 
     // Setters
     void SetId(int id);
-    void SetTitle(const std::string& title);
-    void SetDescription(const std::string& description);
+    void SetTitle(std::string title);
+    void SetDescription(std::string description);
     void SetDueDate(const std::chrono::system_clock::time_point& dueDate);
     void SetPriority(Enums::Priority priority);
-    void SetStatus(Enums::TaskStatus status);
+    void SetStatus(Enums::TaskStatus status, const Clock& clock = Clock::GetInstance());
     void SetCategory(CategoryPtr category);
     void SetRecurrencePattern(RecurrencePatternPtr pattern);
-    void SetTags(const std::vector<std::string>& tags);
+    void SetTags(std::vector<std::string> tags);
     void SetUpdatedAt(const std::chrono::system_clock::time_point& time);
 
     // Utility methods
-    void UpdateTimestamp();
+    void UpdateTimestamp(const Clock& clock = Clock::GetInstance());
     bool IsRecurring() const;
     bool HasCategory() const;
-    void AddTag(const std::string& tag);
+    void AddTag(std::string tag);
     void RemoveTag(const std::string& tag);
 
+    // Owners that index tasks by ID (TaskService) lock it; SetId then throws
+    // std::logic_error instead of changing it
+    void LockId();
+    void UnlockId();
+
+    // Change tracking
+    uint64_t GetVersion() const;
+    bool IsDirty() const;
+    void MarkClean();
+    // Every later version stamp is reported to the sink while it lives
+    void SetChangeSink(std::weak_ptr<IChangeSink<Task>> sink);
+
+    // 64-bit content hash over the persisted fields (except updatedAt, and
+    // completedAt unless COMPLETED); the
+    // task's own text is rehashed only after the task changes
+    uint64_t GetFingerprint() const;
+
 private:
+    void MarkChanged();
+
     int id_;
     std::string title_;
     std::string description_;
@@ -66,6 +111,15 @@ private:
     CategoryPtr category_;
     RecurrencePatternPtr recurrencePattern_;
     std::vector<std::string> tags_;
+    uint64_t version_;
+    bool dirty_;
+    std::weak_ptr<IChangeSink<Task>> changeSink_;
+    bool idLocked_ = false;
+    // Hash state over the task's own fields up to status; the category and
+    // recurrence pattern can change through their shared pointers without
+    // moving version_, so they are hashed on every call
+    mutable uint64_t fingerprintPrefix_ = 0;
+    mutable uint64_t fingerprintVersion_ = 0; // 0 = not computed
 };
 
 #endif // TASK_H
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "Bitmap.h"
+#include <bit>
+#include <stdexcept>
+
+Bitmap::Bitmap(size_t size, bool value)
+    : size_(size), words_((size + WORD_BITS - 1) / WORD_BITS, value ? ~0ULL : 0ULL) {
+    ClearTail();
+}
+
+size_t Bitmap::Size() const {
+    return size_;
+}
+
+void Bitmap::Resize(size_t size, bool value) {
+    size_t oldSize = size_;
+    words_.resize((size + WORD_BITS - 1) / WORD_BITS, value ? ~0ULL : 0ULL);
+    size_ = size;
+    if (value) {
+        // The previous last word may have unused bits that must now be set
+        for (size_t i = oldSize; i < size && i % WORD_BITS != 0; ++i) {
+            Set(i);
+        }
+    }
+    ClearTail();
+}
+
+bool Bitmap::Test(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("Bitmap index out of range");
+    }
+    return (words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1ULL;
+}
+
+void Bitmap::Set(size_t index, bool value) {
+    if (index >= size_) {
+        throw std::out_of_range("Bitmap index out of range");
+    }
+    uint64_t mask = 1ULL << (index % WORD_BITS);
+    if (value) {
+        words_[index / WORD_BITS] |= mask;
+    } else {
+        words_[index / WORD_BITS] &= ~mask;
+    }
+}
+
+void Bitmap::Reset(size_t index) {
+    Set(index, false);
+}
+
+size_t Bitmap::Count() const {
+    size_t count = 0;
+    for (uint64_t word : words_) {
+        count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+bool Bitmap::Any() const {
+    for (uint64_t word : words_) {
+        if (word != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<size_t> Bitmap::ToIndices() const {
+    std::vector<size_t> indices;
+    indices.reserve(Count());
+    for (size_t w = 0; w < words_.size(); ++w) {
+        uint64_t word = words_[w];
+        while (word != 0) {
+            indices.push_back(w * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+    return indices;
+}
+
+Bitmap& Bitmap::operator&=(const Bitmap& other) {
+    CheckSameSize(other);
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= other.words_[i];
+    }
+    return *this;
+}
+
+Bitmap& Bitmap::operator|=(const Bitmap& other) {
+    CheckSameSize(other);
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] |= other.words_[i];
+    }
+    return *this;
+}
+
+Bitmap& Bitmap::AndNot(const Bitmap& other) {
+    CheckSameSize(other);
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= ~other.words_[i];
+    }
+    return *this;
+}
+
+Bitmap Bitmap::operator&(const Bitmap& other) const {
+    Bitmap result(*this);
+    result &= other;
+    return result;
+}
+
+Bitmap Bitmap::operator|(const Bitmap& other) const {
+    Bitmap result(*this);
+    result |= other;
+    return result;
+}
+
+Bitmap Bitmap::operator~() const {
+    Bitmap result(*this);
+    for (auto& word : result.words_) {
+        word = ~word;
+    }
+    result.ClearTail();
+    return result;
+}
+
+const std::vector<uint64_t>& Bitmap::GetWords() const {
+    return words_;
+}
+
+void Bitmap::SetWord(size_t index, uint64_t bits) {
+    if (index >= words_.size()) {
+        throw std::out_of_range("Bitmap word index out of range");
+    }
+    words_[index] = bits;
+    if (index + 1 == words_.size()) {
+        ClearTail();
+    }
+}
+
+void Bitmap::ClearTail() {
+    size_t used = size_ % WORD_BITS;
+    if (used != 0 && !words_.empty()) {
+        words_.back() &= (1ULL << used) - 1;
+    }
+}
+
+void Bitmap::CheckSameSize(const Bitmap& other) const {
+    if (other.size_ != size_) {
+        throw std::invalid_argument("Bitmap sizes differ");
+    }
+}
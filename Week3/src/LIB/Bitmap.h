@@ -0,0 +1,48 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-size dense bitset over row numbers, stored as 64-bit words.
+// Bits past Size() in the last word are always zero.
+class Bitmap {
+public:
+    static constexpr size_t WORD_BITS = 64;
+
+    explicit Bitmap(size_t size = 0, bool value = false);
+
+    size_t Size() const;
+    void Resize(size_t size, bool value = false);
+
+    bool Test(size_t index) const;
+    void Set(size_t index, bool value = true);
+    void Reset(size_t index);
+
+    size_t Count() const;
+    bool Any() const;
+    std::vector<size_t> ToIndices() const;
+
+    // Combine with a bitmap of the same size
+    Bitmap& operator&=(const Bitmap& other);
+    Bitmap& operator|=(const Bitmap& other);
+    Bitmap& AndNot(const Bitmap& other);
+    Bitmap operator&(const Bitmap& other) const;
+    Bitmap operator|(const Bitmap& other) const;
+    Bitmap operator~() const;
+    bool operator==(const Bitmap& other) const = default;
+
+    const std::vector<uint64_t>& GetWords() const;
+    // Replaces bits [index * 64, index * 64 + 64); bits past Size() are dropped
+    void SetWord(size_t index, uint64_t bits);
+
+private:
+    size_t size_ = 0;
+    std::vector<uint64_t> words_;
+
+    void ClearTail();
+    void CheckSameSize(const Bitmap& other) const;
+};
+
+#endif // BITMAP_H
@@ -0,0 +1,74 @@
+#include "Clock.h"
+#include <ctime>
+
+using namespace std::chrono;
+
+Clock::Clock(ClockMode mode) {
+    SetMode(mode);
+}
+
+Clock::Clock(const system_clock::time_point& fixedTime) {
+    SetFixedTime(fixedTime);
+}
+
+Clock& Clock::GetInstance() {
+    static Clock instance;
+    return instance;
+}
+
+system_clock::time_point Clock::Now() const {
+    switch (mode_.load(std::memory_order_relaxed)) {
+        case ClockMode::FIXED:
+            return system_clock::time_point(
+                system_clock::duration(fixedTicks_.load(std::memory_order_relaxed)));
+        case ClockMode::COARSE: {
+#ifdef CLOCK_REALTIME_COARSE
+            timespec ts;
+            if (clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0) {
+                return system_clock::time_point(
+                    duration_cast<system_clock::duration>(seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec)));
+            }
+#endif
+            return system_clock::now();
+        }
+        case ClockMode::SYSTEM:
+        default:
+            return system_clock::now();
+    }
+}
+
+ClockMode Clock::GetMode() const {
+    return mode_.load(std::memory_order_relaxed);
+}
+
+void Clock::SetMode(ClockMode mode) {
+    if (mode == ClockMode::FIXED && mode_.load() != ClockMode::FIXED) {
+        // Freeze at the current time unless SetFixedTime was used
+        fixedTicks_.store(system_clock::now().time_since_epoch().count());
+    }
+    mode_.store(mode);
+}
+
+void Clock::SetFixedTime(const system_clock::time_point& time) {
+    fixedTicks_.store(time.time_since_epoch().count());
+    mode_.store(ClockMode::FIXED);
+}
+
+void Clock::Advance(system_clock::duration delta) {
+    fixedTicks_.fetch_add(delta.count());
+}
+
+ScopedFixedClock::ScopedFixedClock(const system_clock::time_point& time, Clock& clock)
+    : clock_(clock)
+    , previousMode_(clock.GetMode())
+    , previousTime_(clock.Now()) {
+    clock_.SetFixedTime(time);
+}
+
+ScopedFixedClock::~ScopedFixedClock() {
+    if (previousMode_ == ClockMode::FIXED) {
+        clock_.SetFixedTime(previousTime_);
+    } else {
+        clock_.SetMode(previousMode_);
+    }
+}
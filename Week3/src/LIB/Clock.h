@@ -0,0 +1,58 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+enum class ClockMode {
+    SYSTEM, // std::chrono::system_clock::now()
+    COARSE, // Kernel tick resolution (CLOCK_REALTIME_COARSE), no vDSO time read
+    FIXED   // Frozen time, for bulk loads and tests
+};
+
+// Time source. Components that read the time take a Clock (a loader can
+// hand its own FIXED clock to the objects it builds); GetInstance() is the
+// process-wide default they fall back to, also used by DateUtils::Now()
+class Clock {
+public:
+    Clock() = default;
+    explicit Clock(ClockMode mode);
+    explicit Clock(const std::chrono::system_clock::time_point& fixedTime); // FIXED
+
+    Clock(const Clock&) = delete;
+    Clock& operator=(const Clock&) = delete;
+
+    static Clock& GetInstance();
+
+    std::chrono::system_clock::time_point Now() const;
+
+    ClockMode GetMode() const;
+    void SetMode(ClockMode mode);
+
+    // Freezes the clock at the given time (switches to FIXED mode)
+    void SetFixedTime(const std::chrono::system_clock::time_point& time);
+    void Advance(std::chrono::system_clock::duration delta);
+
+private:
+    std::atomic<ClockMode> mode_{ClockMode::SYSTEM};
+    std::atomic<int64_t> fixedTicks_{0};
+};
+
+// Restores the previous clock mode when leaving scope
+class ScopedFixedClock {
+public:
+    explicit ScopedFixedClock(const std::chrono::system_clock::time_point& time,
+                              Clock& clock = Clock::GetInstance());
+    ~ScopedFixedClock();
+
+    ScopedFixedClock(const ScopedFixedClock&) = delete;
+    ScopedFixedClock& operator=(const ScopedFixedClock&) = delete;
+
+private:
+    Clock& clock_;
+    ClockMode previousMode_;
+    std::chrono::system_clock::time_point previousTime_;
+};
+
+#endif // CLOCK_H
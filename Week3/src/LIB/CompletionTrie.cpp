@@ -0,0 +1,212 @@
+#include "CompletionTrie.h"
+#include <algorithm>
+#include <cctype>
+#include <queue>
+
+CompletionTrie::CompletionTrie()
+    : root_(std::make_unique<Node>()) {
+}
+
+void CompletionTrie::Add(std::string_view key, int64_t delta) {
+    if (delta == 0) {
+        return;
+    }
+    Adjust(*root_, Fold(key), delta);
+}
+
+void CompletionTrie::Remove(std::string_view key, int64_t delta) {
+    Add(key, -delta);
+}
+
+uint32_t CompletionTrie::GetWeight(std::string_view key) const {
+    std::string rest = Fold(key);
+    const Node* node = root_.get();
+    std::string_view view(rest);
+    while (!view.empty()) {
+        size_t index = FindChild(*node, view[0]);
+        if (index == node->children.size() || node->children[index]->label[0] != view[0]) {
+            return 0;
+        }
+        const Node& child = *node->children[index];
+        if (view.substr(0, child.label.size()) != child.label) {
+            return 0;
+        }
+        view.remove_prefix(child.label.size());
+        node = &child;
+    }
+    return node->weight;
+}
+
+void CompletionTrie::Clear() {
+    root_ = std::make_unique<Node>();
+    size_ = 0;
+    nodeCount_ = 1;
+}
+
+std::vector<CompletionTrie::Completion> CompletionTrie::Complete(std::string_view prefix, size_t count) const {
+    std::vector<Completion> result;
+    std::string folded = Fold(prefix);
+    std::string_view rest(folded);
+    
+    // Descend to the node covering the prefix, which may end inside an edge
+    const Node* node = root_.get();
+    std::string path;
+    while (!rest.empty()) {
+        size_t index = FindChild(*node, rest[0]);
+        if (index == node->children.size() || node->children[index]->label[0] != rest[0]) {
+            return result;
+        }
+        const Node& child = *node->children[index];
+        size_t common = 0;
+        while (common < child.label.size() && common < rest.size() && child.label[common] == rest[common]) {
+            ++common;
+        }
+        if (common < rest.size() && common < child.label.size()) {
+            return result;
+        }
+        rest.remove_prefix(std::min(rest.size(), child.label.size()));
+        path += child.label;
+        node = &child;
+    }
+    
+    // Best-first by weight, then by path text. Every key is at or after the
+    // path of any subtree holding it, so a key can be emitted as soon as it
+    // is reached: equal-weight keys before it in text order sit in subtrees
+    // that were queued ahead of it.
+    struct Candidate {
+        uint32_t weight;
+        const Node* node;
+        bool terminal;
+        size_t path; // Index into paths
+    };
+    std::vector<std::string> paths{std::move(path)};
+    auto worse = [&paths](const Candidate& lhs, const Candidate& rhs) {
+        if (lhs.weight != rhs.weight) {
+            return lhs.weight < rhs.weight;
+        }
+        // The queue pops the "largest": smaller text, and a key before its own subtree
+        int order = paths[lhs.path].compare(paths[rhs.path]);
+        return order != 0 ? order > 0 : !lhs.terminal && rhs.terminal;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(worse)> queue(worse);
+    if (node->maxWeight > 0) {
+        queue.push(Candidate{node->maxWeight, node, false, 0});
+    }
+    
+    while (!queue.empty() && result.size() < count) {
+        Candidate candidate = queue.top();
+        queue.pop();
+        if (candidate.terminal) {
+            result.push_back(Completion{paths[candidate.path], candidate.weight});
+            continue;
+        }
+        if (candidate.node->weight > 0) {
+            queue.push(Candidate{candidate.node->weight, candidate.node, true, candidate.path});
+        }
+        for (const auto& child : candidate.node->children) {
+            paths.push_back(paths[candidate.path] + child->label);
+            queue.push(Candidate{child->maxWeight, child.get(), false, paths.size() - 1});
+        }
+    }
+    return result;
+}
+
+size_t CompletionTrie::Size() const {
+    return size_;
+}
+
+size_t CompletionTrie::GetNodeCount() const {
+    return nodeCount_;
+}
+
+// Structure
+void CompletionTrie::Adjust(Node& node, std::string_view rest, int64_t delta) {
+    if (rest.empty()) {
+        int64_t weight = std::clamp<int64_t>(static_cast<int64_t>(node.weight) + delta, 0, UINT32_MAX);
+        if (node.weight == 0 && weight > 0) {
+            ++size_;
+        } else if (node.weight > 0 && weight == 0) {
+            --size_;
+        }
+        node.weight = static_cast<uint32_t>(weight);
+        UpdateMax(node);
+        return;
+    }
+    
+    size_t index = FindChild(node, rest[0]);
+    bool found = index < node.children.size() && node.children[index]->label[0] == rest[0];
+    if (!found) {
+        if (delta < 0) {
+            return; // Absent key
+        }
+        auto leaf = std::make_unique<Node>();
+        leaf->label = rest;
+        node.children.insert(node.children.begin() + index, std::move(leaf));
+        ++nodeCount_;
+        Adjust(*node.children[index], std::string_view(), delta);
+        UpdateMax(node);
+        return;
+    }
+    
+    Node& child = *node.children[index];
+    size_t common = 0;
+    while (common < child.label.size() && common < rest.size() && child.label[common] == rest[common]) {
+        ++common;
+    }
+    if (common < child.label.size()) {
+        if (delta < 0) {
+            return;
+        }
+        // Split the edge at the end of the shared part
+        auto middle = std::make_unique<Node>();
+        middle->label = child.label.substr(0, common);
+        node.children[index]->label.erase(0, common);
+        middle->maxWeight = node.children[index]->maxWeight;
+        middle->children.push_back(std::move(node.children[index]));
+        node.children[index] = std::move(middle);
+        ++nodeCount_;
+    }
+    
+    Adjust(*node.children[index], rest.substr(common), delta);
+    Compact(node, index);
+    UpdateMax(node);
+}
+
+void CompletionTrie::Compact(Node& node, size_t childIndex) {
+    Node& child = *node.children[childIndex];
+    if (child.weight > 0) {
+        return;
+    }
+    if (child.children.empty()) {
+        node.children.erase(node.children.begin() + childIndex);
+        --nodeCount_;
+    } else if (child.children.size() == 1) {
+        std::unique_ptr<Node> grandchild = std::move(child.children.front());
+        grandchild->label = child.label + grandchild->label;
+        node.children[childIndex] = std::move(grandchild);
+        --nodeCount_;
+    }
+}
+
+size_t CompletionTrie::FindChild(const Node& node, char first) {
+    auto it = std::lower_bound(node.children.begin(), node.children.end(), first,
+                               [](const std::unique_ptr<Node>& child, char ch) {
+                                   return static_cast<unsigned char>(child->label[0]) < static_cast<unsigned char>(ch);
+                               });
+    return static_cast<size_t>(it - node.children.begin());
+}
+
+void CompletionTrie::UpdateMax(Node& node) {
+    node.maxWeight = node.weight;
+    for (const auto& child : node.children) {
+        node.maxWeight = std::max(node.maxWeight, child->maxWeight);
+    }
+}
+
+std::string CompletionTrie::Fold(std::string_view text) {
+    std::string folded(text);
+    for (char& ch : folded) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return folded;
+}
@@ -0,0 +1,57 @@
+#ifndef COMPLETION_TRIE_H
+#define COMPLETION_TRIE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compressed (radix) trie of case-folded keys with integer weights. Every
+// node caches the largest weight below it, so the top-K completions of a
+// prefix come from a best-first walk that only opens subtrees able to beat
+// the current K-th result. Nodes store only their edge label; a key's text
+// is the concatenation of labels on its path. Keys are removed when their
+// weight drops to zero and single-child chains are merged back into one edge.
+class CompletionTrie {
+public:
+    struct Completion {
+        std::string text; // Case-folded key
+        uint32_t weight = 0;
+    };
+
+    CompletionTrie();
+
+    // Adds delta to the key's weight (clamped at zero)
+    void Add(std::string_view key, int64_t delta = 1);
+    void Remove(std::string_view key, int64_t delta = 1);
+    uint32_t GetWeight(std::string_view key) const;
+    void Clear();
+
+    // Heaviest keys starting with prefix (ignoring case); ties in case-folded text order
+    std::vector<Completion> Complete(std::string_view prefix, size_t count) const;
+
+    size_t Size() const;
+    size_t GetNodeCount() const;
+
+private:
+    struct Node {
+        std::string label; // Edge from the parent, case-folded
+        uint32_t weight = 0;
+        uint32_t maxWeight = 0;
+        std::vector<std::unique_ptr<Node>> children; // Sorted by first label byte
+    };
+
+    std::unique_ptr<Node> root_;
+    size_t size_ = 0;
+    size_t nodeCount_ = 1;
+
+    void Adjust(Node& node, std::string_view rest, int64_t delta);
+    void Compact(Node& node, size_t childIndex);
+    static size_t FindChild(const Node& node, char first); // Lower bound
+    static void UpdateMax(Node& node);
+    static std::string Fold(std::string_view text);
+};
+
+#endif // COMPLETION_TRIE_H
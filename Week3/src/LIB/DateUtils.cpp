@@ -1,4 +1,5 @@
 #include "DateUtils.h"
+#include "Clock.h"
 #include <iomanip>
 #include <sstream>
 #include <chrono>
@@ -7,7 +8,7 @@
 using namespace std::chrono;
 
 system_clock::time_point DateUtils::Now() {
-    return system_clock::now();
+    return Clock::GetInstance().Now();
 }
 
 std::string DateUtils::TimePointToString(const system_clock::time_point& tp) {
@@ -32,6 +33,49 @@ system_clock::time_point DateUtils::StringToTimePoint(const std::string& str) {
     return system_clock::from_time_t(time);
 }
 
+bool DateUtils::TryParseTimePoint(std::string_view str, system_clock::time_point& result) {
+    if (str.size() != 19 || str[4] != '-' || str[7] != '-' || str[10] != ' ' ||
+        str[13] != ':' || str[16] != ':') {
+        return false;
+    }
+    
+    auto number = [&str](size_t pos, size_t length, int& value) {
+        value = 0;
+        for (size_t i = pos; i < pos + length; ++i) {
+            if (str[i] < '0' || str[i] > '9') {
+                return false;
+            }
+            value = value * 10 + (str[i] - '0');
+        }
+        return true;
+    };
+    
+    int year, month, day, hour, minute, second;
+    if (!number(0, 4, year) || !number(5, 2, month) || !number(8, 2, day) ||
+        !number(11, 2, hour) || !number(14, 2, minute) || !number(17, 2, second) ||
+        month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+    
+    // mktime is the expensive part; with tm_isdst = 0 (as in StringToTimePoint)
+    // the time of day is a plain offset from local midnight
+    thread_local int cachedYear = -1, cachedMonth = -1, cachedDay = -1;
+    thread_local std::time_t cachedMidnight = 0;
+    if (year != cachedYear || month != cachedMonth || day != cachedDay) {
+        std::tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        cachedMidnight = std::mktime(&tm);
+        cachedYear = year;
+        cachedMonth = month;
+        cachedDay = day;
+    }
+    
+    result = system_clock::from_time_t(cachedMidnight + hour * 3600 + minute * 60 + second);
+    return true;
+}
+
 bool DateUtils::IsWeekend(const system_clock::time_point& tp) {
     auto time = system_clock::to_time_t(tp);
     std::tm tm = *std::localtime(&time);
@@ -51,10 +95,29 @@ bool DateUtils::IsSameDay(const system_clock::time_point& lhs,
            lhs_tm.tm_mday == rhs_tm.tm_mday;
 }
 
+system_clock::time_point DateUtils::StartOfDay(const system_clock::time_point& tp) {
+    auto time = system_clock::to_time_t(floor<seconds>(tp));
+    std::tm tm = *std::localtime(&time);
+    tm.tm_hour = 0;
+    tm.tm_min = 0;
+    tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    return system_clock::from_time_t(std::mktime(&tm));
+}
+
 system_clock::time_point DateUtils::AddDays(const system_clock::time_point& tp, int days) {
     return tp + hours(24 * days);
 }
 
+system_clock::time_point DateUtils::AddCalendarDays(const system_clock::time_point& tp, int days) {
+    auto whole = floor<seconds>(tp);
+    auto time = system_clock::to_time_t(whole);
+    std::tm tm = *std::localtime(&time);
+    tm.tm_mday += days;
+    tm.tm_isdst = -1;
+    return system_clock::from_time_t(std::mktime(&tm)) + (tp - whole);
+}
+
 int DateUtils::DaysBetween(const system_clock::time_point& from, 
                           const system_clock::time_point& to) {
     auto duration = to - from;
@@ -3,17 +3,27 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 
 class DateUtils {
 public:
     static std::chrono::system_clock::time_point Now();
     static std::string TimePointToString(const std::chrono::system_clock::time_point& tp);
     static std::chrono::system_clock::time_point StringToTimePoint(const std::string& str);
+    // Non-throwing parse of "YYYY-MM-DD HH:MM:SS" with the same result as
+    // StringToTimePoint; caches the last day per thread for bulk parsing
+    static bool TryParseTimePoint(std::string_view str, std::chrono::system_clock::time_point& result);
     static bool IsWeekend(const std::chrono::system_clock::time_point& tp);
     static bool IsSameDay(const std::chrono::system_clock::time_point& lhs, 
                          const std::chrono::system_clock::time_point& rhs);
+    // Local midnight starting the day that contains tp
+    static std::chrono::system_clock::time_point StartOfDay(const std::chrono::system_clock::time_point& tp);
     static std::chrono::system_clock::time_point AddDays(
         const std::chrono::system_clock::time_point& tp, int days);
+    // Same local clock time days calendar days later, so a day across a DST
+    // change is 23 or 25 hours long
+    static std::chrono::system_clock::time_point AddCalendarDays(
+        const std::chrono::system_clock::time_point& tp, int days);
     static int DaysBetween(const std::chrono::system_clock::time_point& from, 
                           const std::chrono::system_clock::time_point& to);
 };
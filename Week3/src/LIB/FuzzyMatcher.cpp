@@ -0,0 +1,85 @@
+#include "FuzzyMatcher.h"
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+FuzzyMatcher::FuzzyMatcher(std::string_view pattern)
+    : pattern_(pattern) {
+    
+    for (char& ch : pattern_) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    if (pattern_.size() <= WORD_BITS) {
+        for (size_t i = 0; i < pattern_.size(); ++i) {
+            unsigned char lower = static_cast<unsigned char>(pattern_[i]);
+            peq_[lower] |= 1ULL << i;
+            peq_[static_cast<unsigned char>(std::toupper(lower))] |= 1ULL << i;
+        }
+    }
+}
+
+int FuzzyMatcher::Distance(std::string_view text, int maxDistance) const {
+    if (pattern_.empty()) {
+        return 0;
+    }
+    return pattern_.size() <= WORD_BITS ? DistanceBitParallel(text, maxDistance) : DistanceDynamic(text, maxDistance);
+}
+
+size_t FuzzyMatcher::GetPatternLength() const {
+    return pattern_.size();
+}
+
+int FuzzyMatcher::DistanceBitParallel(std::string_view text, int maxDistance) const {
+    // Vertical deltas of the last DP column: Pv = +1, Mv = -1. The top row
+    // is all zeros (a match may start anywhere), so no carry enters Ph.
+    size_t length = pattern_.size();
+    uint64_t high = 1ULL << (length - 1);
+    uint64_t pv = ~0ULL;
+    uint64_t mv = 0;
+    int score = static_cast<int>(length);
+    int best = score;
+    
+    for (char ch : text) {
+        uint64_t eq = peq_[static_cast<unsigned char>(ch)];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & high) {
+            ++score;
+        } else if (mh & high) {
+            --score;
+        }
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        
+        best = std::min(best, score);
+        if (best == 0) {
+            break;
+        }
+    }
+    return best <= maxDistance ? best : -1;
+}
+
+int FuzzyMatcher::DistanceDynamic(std::string_view text, int maxDistance) const {
+    size_t length = pattern_.size();
+    std::vector<int> column(length + 1);
+    for (size_t i = 0; i <= length; ++i) {
+        column[i] = static_cast<int>(i);
+    }
+    int best = column[length];
+    
+    for (char ch : text) {
+        char lower = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        int diagonal = 0; // Row 0 stays 0
+        for (size_t i = 1; i <= length; ++i) {
+            int above = column[i];
+            column[i] = std::min({above + 1, column[i - 1] + 1, diagonal + (pattern_[i - 1] == lower ? 0 : 1)});
+            diagonal = above;
+        }
+        best = std::min(best, column[length]);
+    }
+    return best <= maxDistance ? best : -1;
+}
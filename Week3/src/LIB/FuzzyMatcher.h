@@ -0,0 +1,32 @@
+#ifndef FUZZY_MATCHER_H
+#define FUZZY_MATCHER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Approximate substring matching: the smallest edit distance between the
+// pattern and any substring of a text, ignoring ASCII case. Patterns of up
+// to 64 bytes use Myers' bit-parallel algorithm (one machine word per text
+// byte); longer patterns fall back to the Sellers dynamic program.
+class FuzzyMatcher {
+public:
+    explicit FuzzyMatcher(std::string_view pattern);
+
+    // Best distance, or -1 when it exceeds maxDistance
+    int Distance(std::string_view text, int maxDistance) const;
+    size_t GetPatternLength() const;
+
+    static constexpr size_t WORD_BITS = 64;
+
+private:
+    std::string pattern_; // Case-folded
+    std::array<uint64_t, 256> peq_{}; // Bit i set where pattern_[i] equals the byte
+
+    int DistanceBitParallel(std::string_view text, int maxDistance) const;
+    int DistanceDynamic(std::string_view text, int maxDistance) const;
+};
+
+#endif // FUZZY_MATCHER_H
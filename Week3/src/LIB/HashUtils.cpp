@@ -0,0 +1,79 @@
+#include "HashUtils.h"
+#include <stdexcept>
+
+uint64_t HashUtils::Fnv1a(std::string_view data, uint64_t seed) {
+    uint64_t hash = seed;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t HashUtils::Mix(uint64_t value) {
+    // splitmix64 finalizer
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+std::string HashUtils::ToHex(uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string result(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        result[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return result;
+}
+
+uint64_t HashUtils::FromHex(const std::string& hex) {
+    if (hex.empty() || hex.length() > 16) {
+        throw std::invalid_argument("Invalid hex hash: " + hex);
+    }
+    
+    uint64_t value = 0;
+    for (char c : hex) {
+        value <<= 4;
+        if (c >= '0' && c <= '9') value |= static_cast<uint64_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') value |= static_cast<uint64_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') value |= static_cast<uint64_t>(c - 'A' + 10);
+        else throw std::invalid_argument("Invalid hex hash: " + hex);
+    }
+    return value;
+}
+
+FingerprintBuilder::FingerprintBuilder(uint64_t state)
+    : state_(state) {
+}
+
+FingerprintBuilder& FingerprintBuilder::Add(int64_t value) {
+    char bytes[sizeof(value)];
+    for (size_t i = 0; i < sizeof(value); ++i) {
+        bytes[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+    }
+    state_ = HashUtils::Fnv1a(std::string_view(bytes, sizeof(bytes)), state_);
+    return *this;
+}
+
+FingerprintBuilder& FingerprintBuilder::Add(std::string_view value) {
+    Add(static_cast<int64_t>(value.size()));
+    state_ = HashUtils::Fnv1a(value, state_);
+    return *this;
+}
+
+FingerprintBuilder& FingerprintBuilder::Add(const std::chrono::system_clock::time_point& time) {
+    auto secs = std::chrono::floor<std::chrono::seconds>(time.time_since_epoch());
+    return Add(static_cast<int64_t>(secs.count()));
+}
+
+uint64_t FingerprintBuilder::Finish() const {
+    return HashUtils::Mix(state_);
+}
+
+uint64_t FingerprintBuilder::GetState() const {
+    return state_;
+}
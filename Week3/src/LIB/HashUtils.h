@@ -0,0 +1,42 @@
+#ifndef HASH_UTILS_H
+#define HASH_UTILS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// 64-bit FNV-1a with a final avalanche step; stable across runs and
+// platforms, so hashes can be persisted and compared between replicas
+class HashUtils {
+public:
+    static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    static uint64_t Fnv1a(std::string_view data, uint64_t seed = FNV_OFFSET_BASIS);
+    static uint64_t Mix(uint64_t value);
+
+    static std::string ToHex(uint64_t value);
+    static uint64_t FromHex(const std::string& hex); // Throws std::invalid_argument
+};
+
+// Incremental hash over a canonical field encoding. Strings are length
+// prefixed so ("ab","c") and ("a","bc") hash differently.
+class FingerprintBuilder {
+public:
+    FingerprintBuilder() = default;
+    explicit FingerprintBuilder(uint64_t state); // Resume from GetState()
+
+    FingerprintBuilder& Add(int64_t value);
+    FingerprintBuilder& Add(std::string_view value);
+    // Second precision, matching what the data files keep
+    FingerprintBuilder& Add(const std::chrono::system_clock::time_point& time);
+
+    uint64_t Finish() const;
+    uint64_t GetState() const;
+
+private:
+    uint64_t state_ = HashUtils::FNV_OFFSET_BASIS;
+};
+
+#endif // HASH_UTILS_H
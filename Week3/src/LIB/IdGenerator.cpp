@@ -11,4 +11,12 @@ int IdGenerator::GenerateTaskId() {
 
 int IdGenerator::GenerateCategoryId() {
     return nextCategoryId_++;
+}
+
+uint64_t IdGenerator::GenerateVersion() {
+    return nextVersion_++;
+}
+
+uint64_t IdGenerator::GetCurrentVersion() const {
+    return nextVersion_.load() - 1;
 }
\ No newline at end of file
@@ -2,16 +2,21 @@
 #define ID_GENERATOR_H
 
 #include <atomic>
+#include <cstdint>
 
 class IdGenerator {
 public:
     static IdGenerator& GetInstance();
     int GenerateTaskId();
     int GenerateCategoryId();
+    // Monotonic change stamps shared by all DTOs
+    uint64_t GenerateVersion();
+    uint64_t GetCurrentVersion() const;
 private:
     IdGenerator() = default;
     std::atomic<int> nextTaskId_{1};
     std::atomic<int> nextCategoryId_{1};
+    std::atomic<uint64_t> nextVersion_{1};
 };
 
 #endif // ID_GENERATOR_H
\ No newline at end of file
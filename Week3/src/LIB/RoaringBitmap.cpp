@@ -0,0 +1,332 @@
+#include "RoaringBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+// Single values
+bool RoaringBitmap::Add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value);
+    
+    size_t index = FindContainer(key);
+    if (index == containers_.size() || containers_[index].key != key) {
+        Container container;
+        container.key = key;
+        containers_.insert(containers_.begin() + index, std::move(container));
+    }
+    
+    Container& container = containers_[index];
+    if (container.IsBitmap()) {
+        uint64_t mask = 1ULL << (low % 64);
+        if (container.words[low / 64] & mask) {
+            return false;
+        }
+        container.words[low / 64] |= mask;
+    } else {
+        auto it = std::lower_bound(container.values.begin(), container.values.end(), low);
+        if (it != container.values.end() && *it == low) {
+            return false;
+        }
+        container.values.insert(it, low);
+    }
+    ++container.cardinality;
+    Normalize(container);
+    return true;
+}
+
+bool RoaringBitmap::Remove(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value);
+    
+    size_t index = FindContainer(key);
+    if (index == containers_.size() || containers_[index].key != key) {
+        return false;
+    }
+    
+    Container& container = containers_[index];
+    if (container.IsBitmap()) {
+        uint64_t mask = 1ULL << (low % 64);
+        if (!(container.words[low / 64] & mask)) {
+            return false;
+        }
+        container.words[low / 64] &= ~mask;
+    } else {
+        auto it = std::lower_bound(container.values.begin(), container.values.end(), low);
+        if (it == container.values.end() || *it != low) {
+            return false;
+        }
+        container.values.erase(it);
+    }
+    --container.cardinality;
+    
+    if (container.cardinality == 0) {
+        containers_.erase(containers_.begin() + index);
+    } else {
+        Normalize(container);
+    }
+    return true;
+}
+
+bool RoaringBitmap::Contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t index = FindContainer(key);
+    return index < containers_.size() && containers_[index].key == key &&
+           ContainsLow(containers_[index], static_cast<uint16_t>(value));
+}
+
+void RoaringBitmap::Clear() {
+    containers_.clear();
+}
+
+size_t RoaringBitmap::Cardinality() const {
+    size_t count = 0;
+    for (const auto& container : containers_) {
+        count += container.cardinality;
+    }
+    return count;
+}
+
+bool RoaringBitmap::Empty() const {
+    return containers_.empty();
+}
+
+std::vector<uint32_t> RoaringBitmap::ToVector() const {
+    std::vector<uint32_t> values;
+    values.reserve(Cardinality());
+    ForEach([&values](uint32_t value) { values.push_back(value); });
+    return values;
+}
+
+// Set operations
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other) {
+    *this = *this & other;
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other) {
+    *this = *this | other;
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::AndNot(const RoaringBitmap& other) {
+    std::vector<Container> result;
+    result.reserve(containers_.size());
+    size_t j = 0;
+    for (auto& container : containers_) {
+        while (j < other.containers_.size() && other.containers_[j].key < container.key) {
+            ++j;
+        }
+        if (j < other.containers_.size() && other.containers_[j].key == container.key) {
+            Container difference = AndNot(container, other.containers_[j]);
+            if (difference.cardinality > 0) {
+                result.push_back(std::move(difference));
+            }
+        } else {
+            result.push_back(std::move(container));
+        }
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+RoaringBitmap RoaringBitmap::operator&(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers_.size() && j < other.containers_.size()) {
+        uint16_t lhsKey = containers_[i].key;
+        uint16_t rhsKey = other.containers_[j].key;
+        if (lhsKey < rhsKey) {
+            ++i;
+        } else if (rhsKey < lhsKey) {
+            ++j;
+        } else {
+            Container intersection = And(containers_[i++], other.containers_[j++]);
+            if (intersection.cardinality > 0) {
+                result.containers_.push_back(std::move(intersection));
+            }
+        }
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::operator|(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    result.containers_.reserve(containers_.size() + other.containers_.size());
+    size_t i = 0, j = 0;
+    while (i < containers_.size() || j < other.containers_.size()) {
+        if (j == other.containers_.size() || (i < containers_.size() && containers_[i].key < other.containers_[j].key)) {
+            result.containers_.push_back(containers_[i++]);
+        } else if (i == containers_.size() || other.containers_[j].key < containers_[i].key) {
+            result.containers_.push_back(other.containers_[j++]);
+        } else {
+            result.containers_.push_back(Or(containers_[i++], other.containers_[j++]));
+        }
+    }
+    return result;
+}
+
+bool RoaringBitmap::operator==(const RoaringBitmap& other) const {
+    // Normalization makes the representation canonical
+    if (containers_.size() != other.containers_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < containers_.size(); ++i) {
+        const Container& lhs = containers_[i];
+        const Container& rhs = other.containers_[i];
+        if (lhs.key != rhs.key || lhs.cardinality != rhs.cardinality ||
+            lhs.values != rhs.values || lhs.words != rhs.words) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t RoaringBitmap::GetContainerCount() const {
+    return containers_.size();
+}
+
+size_t RoaringBitmap::GetMemoryBytes() const {
+    size_t bytes = containers_.capacity() * sizeof(Container);
+    for (const auto& container : containers_) {
+        bytes += container.values.capacity() * sizeof(uint16_t) + container.words.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+// Containers
+size_t RoaringBitmap::FindContainer(uint16_t key) const {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, uint16_t k) { return container.key < k; });
+    return static_cast<size_t>(it - containers_.begin());
+}
+
+bool RoaringBitmap::ContainsLow(const Container& container, uint16_t low) {
+    if (container.IsBitmap()) {
+        return (container.words[low / 64] >> (low % 64)) & 1ULL;
+    }
+    return std::binary_search(container.values.begin(), container.values.end(), low);
+}
+
+void RoaringBitmap::ToBitmap(Container& container) {
+    if (container.IsBitmap()) {
+        return;
+    }
+    container.words.assign(CONTAINER_WORDS, 0);
+    for (uint16_t low : container.values) {
+        container.words[low / 64] |= 1ULL << (low % 64);
+    }
+    container.values.clear();
+    container.values.shrink_to_fit();
+}
+
+void RoaringBitmap::Normalize(Container& container) {
+    if (!container.IsBitmap() && container.cardinality > ARRAY_MAX) {
+        ToBitmap(container);
+    } else if (container.IsBitmap() && container.cardinality <= ARRAY_MAX) {
+        container.values.clear();
+        container.values.reserve(container.cardinality);
+        for (size_t w = 0; w < CONTAINER_WORDS; ++w) {
+            uint64_t word = container.words[w];
+            while (word != 0) {
+                container.values.push_back(static_cast<uint16_t>(w * 64 + static_cast<size_t>(std::countr_zero(word))));
+                word &= word - 1;
+            }
+        }
+        container.words.clear();
+        container.words.shrink_to_fit();
+    }
+}
+
+RoaringBitmap::Container RoaringBitmap::And(const Container& lhs, const Container& rhs) {
+    Container result;
+    result.key = lhs.key;
+    
+    if (lhs.IsBitmap() && rhs.IsBitmap()) {
+        result.words.resize(CONTAINER_WORDS);
+        for (size_t w = 0; w < CONTAINER_WORDS; ++w) {
+            result.words[w] = lhs.words[w] & rhs.words[w];
+            result.cardinality += static_cast<uint32_t>(std::popcount(result.words[w]));
+        }
+        Normalize(result);
+    } else if (lhs.IsBitmap() || rhs.IsBitmap()) {
+        const Container& array = lhs.IsBitmap() ? rhs : lhs;
+        const Container& bitmap = lhs.IsBitmap() ? lhs : rhs;
+        for (uint16_t low : array.values) {
+            if (ContainsLow(bitmap, low)) {
+                result.values.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+    } else {
+        std::set_intersection(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(),
+                              std::back_inserter(result.values));
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+    }
+    return result;
+}
+
+RoaringBitmap::Container RoaringBitmap::Or(const Container& lhs, const Container& rhs) {
+    Container result;
+    result.key = lhs.key;
+    
+    if (!lhs.IsBitmap() && !rhs.IsBitmap() && lhs.cardinality + rhs.cardinality <= ARRAY_MAX) {
+        std::set_union(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(),
+                       std::back_inserter(result.values));
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+        return result;
+    }
+    
+    result = lhs.IsBitmap() ? lhs : rhs;
+    const Container& other = lhs.IsBitmap() ? rhs : lhs;
+    ToBitmap(result);
+    if (other.IsBitmap()) {
+        for (size_t w = 0; w < CONTAINER_WORDS; ++w) {
+            result.words[w] |= other.words[w];
+        }
+    } else {
+        for (uint16_t low : other.values) {
+            result.words[low / 64] |= 1ULL << (low % 64);
+        }
+    }
+    result.cardinality = 0;
+    for (uint64_t word : result.words) {
+        result.cardinality += static_cast<uint32_t>(std::popcount(word));
+    }
+    Normalize(result);
+    return result;
+}
+
+RoaringBitmap::Container RoaringBitmap::AndNot(const Container& lhs, const Container& rhs) {
+    Container result;
+    result.key = lhs.key;
+    
+    if (!lhs.IsBitmap()) {
+        if (rhs.IsBitmap()) {
+            for (uint16_t low : lhs.values) {
+                if (!ContainsLow(rhs, low)) {
+                    result.values.push_back(low);
+                }
+            }
+        } else {
+            std::set_difference(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(),
+                                std::back_inserter(result.values));
+        }
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+        return result;
+    }
+    
+    result.words = lhs.words;
+    if (rhs.IsBitmap()) {
+        for (size_t w = 0; w < CONTAINER_WORDS; ++w) {
+            result.words[w] &= ~rhs.words[w];
+        }
+    } else {
+        for (uint16_t low : rhs.values) {
+            result.words[low / 64] &= ~(1ULL << (low % 64));
+        }
+    }
+    for (uint64_t word : result.words) {
+        result.cardinality += static_cast<uint32_t>(std::popcount(word));
+    }
+    Normalize(result);
+    return result;
+}
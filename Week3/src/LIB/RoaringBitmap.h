@@ -0,0 +1,80 @@
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compressed set of 32-bit values in the Roaring layout: values are split
+// by their high 16 bits into containers, each either a sorted array (up to
+// ARRAY_MAX values) or a 65536-bit bitmap. Set operations work container by
+// container and pick the cheapest kernel for each pair of representations.
+class RoaringBitmap {
+public:
+    static constexpr uint32_t ARRAY_MAX = 4096;
+    static constexpr size_t CONTAINER_WORDS = 1024;
+
+    RoaringBitmap() = default;
+
+    bool Add(uint32_t value);    // False if already present
+    bool Remove(uint32_t value); // False if absent
+    bool Contains(uint32_t value) const;
+    void Clear();
+
+    size_t Cardinality() const;
+    bool Empty() const;
+    std::vector<uint32_t> ToVector() const;
+
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (const auto& container : containers_) {
+            uint32_t high = static_cast<uint32_t>(container.key) << 16;
+            if (container.IsBitmap()) {
+                for (size_t w = 0; w < CONTAINER_WORDS; ++w) {
+                    uint64_t word = container.words[w];
+                    while (word != 0) {
+                        fn(high | static_cast<uint32_t>(w * 64 + static_cast<size_t>(std::countr_zero(word))));
+                        word &= word - 1;
+                    }
+                }
+            } else {
+                for (uint16_t low : container.values) {
+                    fn(high | low);
+                }
+            }
+        }
+    }
+
+    RoaringBitmap& operator&=(const RoaringBitmap& other);
+    RoaringBitmap& operator|=(const RoaringBitmap& other);
+    RoaringBitmap& AndNot(const RoaringBitmap& other);
+    RoaringBitmap operator&(const RoaringBitmap& other) const;
+    RoaringBitmap operator|(const RoaringBitmap& other) const;
+    bool operator==(const RoaringBitmap& other) const;
+
+    size_t GetContainerCount() const;
+    size_t GetMemoryBytes() const;
+
+private:
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> values; // Array form, sorted
+        std::vector<uint64_t> words;  // Bitmap form when non-empty
+
+        bool IsBitmap() const { return !words.empty(); }
+    };
+
+    std::vector<Container> containers_; // Sorted by key, never empty
+
+    size_t FindContainer(uint16_t key) const; // Lower bound
+    static bool ContainsLow(const Container& container, uint16_t low);
+    static void ToBitmap(Container& container);
+    static void Normalize(Container& container);
+    static Container And(const Container& lhs, const Container& rhs);
+    static Container Or(const Container& lhs, const Container& rhs);
+    static Container AndNot(const Container& lhs, const Container& rhs);
+};
+
+#endif // ROARING_BITMAP_H
@@ -0,0 +1,166 @@
+#include "TextBuffer.h"
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <ctime>
+#include <unistd.h>
+
+TextBuffer::TextBuffer(size_t initialCapacity) {
+    data_.reserve(initialCapacity);
+}
+
+TextBuffer& TextBuffer::Append(std::string_view text) {
+    data_.append(text);
+    return *this;
+}
+
+TextBuffer& TextBuffer::Append(char c) {
+    data_.push_back(c);
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendRepeat(char c, size_t count) {
+    data_.append(count, c);
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendInt(int64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    data_.append(digits, result.ptr);
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendUInt(uint64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    data_.append(digits, result.ptr);
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendFixed(double value, int precision) {
+    char digits[352]; // Enough for DBL_MAX in fixed notation plus the fraction
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        data_.append(digits, result.ptr);
+    }
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendDouble(double value) {
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    data_.append(digits, result.ptr);
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendJsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return Append("null");
+    }
+    return AppendDouble(value);
+}
+
+TextBuffer& TextBuffer::AppendDateTime(const std::chrono::system_clock::time_point& time) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    std::tm tm{};
+    char text[32];
+    if (localtime_r(&seconds, &tm) == nullptr) {
+        return Append("invalid date");
+    }
+    size_t length = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &tm);
+    data_.append(text, length);
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendJsonString(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    data_.push_back('"');
+    for (char c : text) {
+        switch (c) {
+            case '"':  data_.append("\\\""); break;
+            case '\\': data_.append("\\\\"); break;
+            case '\n': data_.append("\\n"); break;
+            case '\r': data_.append("\\r"); break;
+            case '\t': data_.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    data_.append("\\u00");
+                    data_.push_back(hex[(c >> 4) & 0xF]);
+                    data_.push_back(hex[c & 0xF]);
+                } else {
+                    data_.push_back(c);
+                }
+        }
+    }
+    data_.push_back('"');
+    return *this;
+}
+
+TextBuffer& TextBuffer::AppendCsvField(std::string_view text) {
+    if (text.find_first_of(",\"\n\r") == std::string_view::npos) {
+        return Append(text);
+    }
+    
+    data_.push_back('"');
+    for (char c : text) {
+        if (c == '"') {
+            data_.push_back('"');
+        }
+        data_.push_back(c);
+    }
+    data_.push_back('"');
+    return *this;
+}
+
+std::string_view TextBuffer::View() const {
+    return data_;
+}
+
+std::string TextBuffer::Str() const {
+    return data_;
+}
+
+size_t TextBuffer::Size() const {
+    return data_.size();
+}
+
+bool TextBuffer::Empty() const {
+    return data_.empty();
+}
+
+void TextBuffer::Clear() {
+    data_.clear();
+}
+
+bool TextBuffer::WriteTo(int fd) const {
+    return WritePrefix(fd) == data_.size();
+}
+
+bool TextBuffer::FlushTo(int fd) {
+    size_t written = WritePrefix(fd);
+    bool ok = written == data_.size();
+    if (ok) {
+        Clear();
+    } else {
+        int error = errno;
+        data_.erase(0, written);
+        errno = error;
+    }
+    return ok;
+}
+
+size_t TextBuffer::WritePrefix(int fd) const {
+    size_t done = 0;
+    while (done < data_.size()) {
+        ssize_t written = ::write(fd, data_.data() + done, data_.size() - done);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        done += static_cast<size_t>(written);
+    }
+    return done;
+}
@@ -0,0 +1,52 @@
+#ifndef TEXT_BUFFER_H
+#define TEXT_BUFFER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Growable output buffer for report rendering. Numbers are formatted with
+// std::to_chars into stack storage, so appending never allocates once the
+// buffer has reached its working size; Clear() keeps the capacity.
+class TextBuffer {
+public:
+    explicit TextBuffer(size_t initialCapacity = 4096);
+
+    TextBuffer& Append(std::string_view text);
+    TextBuffer& Append(char c);
+    TextBuffer& AppendRepeat(char c, size_t count);
+    TextBuffer& AppendInt(int64_t value);
+    TextBuffer& AppendUInt(uint64_t value);
+    // Same digits as `std::fixed << std::setprecision(precision)`
+    TextBuffer& AppendFixed(double value, int precision);
+    // Shortest representation that round-trips
+    TextBuffer& AppendDouble(double value);
+    // AppendDouble, or null for NaN and infinities, which JSON cannot hold
+    TextBuffer& AppendJsonNumber(double value);
+    // Local time, same layout as DateUtils::TimePointToString
+    TextBuffer& AppendDateTime(const std::chrono::system_clock::time_point& time);
+    TextBuffer& AppendJsonString(std::string_view text); // Quoted and escaped
+    TextBuffer& AppendCsvField(std::string_view text);   // Quoted only when needed
+
+    std::string_view View() const;
+    std::string Str() const;
+    size_t Size() const;
+    bool Empty() const;
+    void Clear();
+
+    // Writes the whole buffer to a file descriptor, retrying short writes;
+    // on failure errno is left set
+    bool WriteTo(int fd) const;
+    // Writes and clears the buffer. On failure only the bytes that were
+    // written are dropped, so the rest can be retried.
+    bool FlushTo(int fd);
+
+private:
+    std::string data_;
+
+    size_t WritePrefix(int fd) const; // Bytes written before the first error
+};
+
+#endif // TEXT_BUFFER_H
@@ -0,0 +1,81 @@
+#include "UtcOffsetTable.h"
+#include <algorithm>
+#include <climits>
+#include <ctime>
+#include <stdexcept>
+
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+UtcOffsetTable::UtcOffsetTable(int64_t fromUtc, int64_t toUtc) {
+    if (toUtc <= fromUtc) {
+        throw std::invalid_argument("Offset table range is empty");
+    }
+    
+    int64_t current = ProbeOffset(fromUtc);
+    starts_.push_back(INT64_MIN);
+    offsets_.push_back(current);
+    
+    for (int64_t day = fromUtc; day < toUtc; day += SECONDS_PER_DAY) {
+        int64_t next = ProbeOffset(day + SECONDS_PER_DAY);
+        if (next == current) {
+            continue;
+        }
+        
+        // Binary search the first second with the new offset
+        int64_t lo = day;
+        int64_t hi = day + SECONDS_PER_DAY;
+        while (hi - lo > 1) {
+            int64_t mid = lo + (hi - lo) / 2;
+            (ProbeOffset(mid) == current ? lo : hi) = mid;
+        }
+        starts_.push_back(hi);
+        offsets_.push_back(next);
+        current = next;
+    }
+}
+
+UtcOffsetTable UtcOffsetTable::Fixed(int64_t offsetSeconds) {
+    UtcOffsetTable table;
+    table.starts_.push_back(INT64_MIN);
+    table.offsets_.push_back(offsetSeconds);
+    return table;
+}
+
+const UtcOffsetTable& UtcOffsetTable::Local() {
+    static const UtcOffsetTable table(0, 4102444800LL); // 2100-01-01
+    return table;
+}
+
+int64_t UtcOffsetTable::OffsetAt(int64_t utcSeconds) const {
+    return offsets_[FindSegment(utcSeconds)];
+}
+
+size_t UtcOffsetTable::GetTransitionCount() const {
+    return starts_.size() - 1;
+}
+
+size_t UtcOffsetTable::FindSegment(int64_t utcSeconds) const {
+    auto it = std::upper_bound(starts_.begin(), starts_.end(), utcSeconds);
+    return static_cast<size_t>(it - starts_.begin()) - 1;
+}
+
+int64_t UtcOffsetTable::GetSegmentStart(size_t segment) const {
+    return starts_[segment];
+}
+
+int64_t UtcOffsetTable::GetSegmentEnd(size_t segment) const {
+    return segment + 1 < starts_.size() ? starts_[segment + 1] : INT64_MAX;
+}
+
+int64_t UtcOffsetTable::GetSegmentOffset(size_t segment) const {
+    return offsets_[segment];
+}
+
+int64_t UtcOffsetTable::ProbeOffset(int64_t utcSeconds) {
+    std::time_t time = static_cast<std::time_t>(utcSeconds);
+    std::tm tm{};
+    if (localtime_r(&time, &tm) == nullptr) {
+        return 0;
+    }
+    return tm.tm_gmtoff;
+}
@@ -0,0 +1,39 @@
+#ifndef UTC_OFFSET_TABLE_H
+#define UTC_OFFSET_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Local-time UTC offsets precomputed as a sorted list of transitions, so
+// converting a timestamp is a table lookup instead of a localtime() call.
+// Lookups are read-only and thread-safe; times outside the built range use
+// the nearest known offset.
+class UtcOffsetTable {
+public:
+    // Probes the process time zone (TZ) once per day over [fromUtc, toUtc)
+    UtcOffsetTable(int64_t fromUtc, int64_t toUtc);
+
+    static UtcOffsetTable Fixed(int64_t offsetSeconds);
+    // Shared table for the local zone, 1970-2100, built on first use
+    static const UtcOffsetTable& Local();
+
+    int64_t OffsetAt(int64_t utcSeconds) const;
+    size_t GetTransitionCount() const;
+
+    // Index of the segment containing utcSeconds, for callers that cache it
+    size_t FindSegment(int64_t utcSeconds) const;
+    int64_t GetSegmentStart(size_t segment) const;
+    int64_t GetSegmentEnd(size_t segment) const; // Exclusive; INT64_MAX for the last
+    int64_t GetSegmentOffset(size_t segment) const;
+
+private:
+    UtcOffsetTable() = default;
+
+    std::vector<int64_t> starts_;  // First UTC second of each segment
+    std::vector<int64_t> offsets_; // Seconds east of UTC
+
+    static int64_t ProbeOffset(int64_t utcSeconds);
+};
+
+#endif // UTC_OFFSET_TABLE_H
@@ -0,0 +1,41 @@
+#include "Varint.h"
+#include <stdexcept>
+
+void Varint::Encode(uint64_t value, std::vector<uint8_t>& out) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void Varint::EncodeSigned(int64_t value, std::vector<uint8_t>& out) {
+    Encode(ZigZag(value), out);
+}
+
+uint64_t Varint::Decode(const uint8_t*& pos, const uint8_t* end) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos == end) {
+            throw std::runtime_error("Truncated varint");
+        }
+        uint8_t byte = *pos++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Varint too long");
+}
+
+int64_t Varint::DecodeSigned(const uint8_t*& pos, const uint8_t* end) {
+    return UnZigZag(Decode(pos, end));
+}
+
+uint64_t Varint::ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t Varint::UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
@@ -0,0 +1,21 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <cstdint>
+#include <vector>
+
+// LEB128 variable-length integers: 7 bits per byte, small values in one byte.
+// Signed values go through zigzag so small negatives stay small.
+class Varint {
+public:
+    static void Encode(uint64_t value, std::vector<uint8_t>& out);
+    static void EncodeSigned(int64_t value, std::vector<uint8_t>& out);
+    // Advances `pos`; throws std::runtime_error on truncated input
+    static uint64_t Decode(const uint8_t*& pos, const uint8_t* end);
+    static int64_t DecodeSigned(const uint8_t*& pos, const uint8_t* end);
+
+    static uint64_t ZigZag(int64_t value);
+    static int64_t UnZigZag(uint64_t value);
+};
+
+#endif // VARINT_H
@@ -0,0 +1,1574 @@
+#include <gtest/gtest.h>
+#include "../../src/BLL/StatsAccumulator.h"
+#include "../../src/BLL/StatisticsManager.h"
+#include "../../src/BLL/TaskService.h"
+#include "../../src/BLL/LiveStatsAggregator.h"
+#include "../../src/BLL/DailyRollup.h"
+#include "../../src/BLL/TaskTable.h"
+#include "../../src/BLL/LogHistogram.h"
+#include "../../src/BLL/SpaceSaving.h"
+#include "../../src/BLL/HyperLogLog.h"
+#include "../../src/BLL/ReportWriter.h"
+#include "../../src/BLL/StreamingReportBuilder.h"
+#include "../../src/BLL/TaskEventStore.h"
+#include "../../src/BLL/HeatmapBuilder.h"
+#include "../../src/BLL/DueDateRiskEstimator.h"
+#include "../../src/BLL/DueDateIndex.h"
+#include "../../src/BLL/TaskBitmapIndex.h"
+#include "../../src/BLL/TextSearchIndex.h"
+#include "../../src/BLL/QueryEngine.h"
+#include "../../src/BLL/TaskSorter.h"
+#include "../../src/BLL/AutocompleteIndex.h"
+#include "../../src/BLL/FuzzySearchIndex.h"
+#include "../../src/BLL/DuplicateDetector.h"
+#include "../../src/BLL/MaterializedViews.h"
+#include "../../src/DAL/CSVDataManager.h"
+#include "../../src/DAL/ChangeLog.h"
+#include "../../src/DAL/JSONDataManager.h"
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "../../src/DTO/Task.h"
+#include "../../src/DTO/Category.h"
+#include "../../src/DTO/ProductivityReport.h"
+#include "../../src/DTO/Enums.h"
+#include "../../src/LIB/Clock.h"
+#include "../../src/LIB/IdGenerator.h"
+#include "../../src/LIB/DateUtils.h"
+#include "../../src/LIB/StringUtils.h"
+#include "../../src/LIB/FuzzyMatcher.h"
+#include "../../src/LIB/common.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace std::chrono;
+
+// Test fixture: all tasks are created against a frozen clock
+class BusinessLogicTest : public ::testing::Test {
+protected:
+    system_clock::time_point base_;
+
+    void SetUp() override {
+        base_ = DateUtils::StringToTimePoint("2025-03-01 08:00:00");
+        Clock::GetInstance().SetFixedTime(base_);
+    }
+
+    void TearDown() override {
+        Clock::GetInstance().SetMode(ClockMode::SYSTEM);
+    }
+
+    // Helper to build a task with explicit timestamps
+    TaskPtr MakeTask(int id, Enums::TaskStatus status, Enums::Priority priority,
+                     int categoryId, int createdOffsetHours, int dueOffsetHours,
+                     int completedOffsetHours = -1) {
+        TaskFields fields;
+        fields.id = id;
+        fields.title = "Task " + std::to_string(id);
+        fields.createdAt = base_ + hours(createdOffsetHours);
+        fields.updatedAt = fields.createdAt;
+        fields.dueDate = base_ + hours(dueOffsetHours);
+        fields.priority = priority;
+        fields.status = status;
+        if (status == Enums::TaskStatus::COMPLETED && completedOffsetHours >= 0) {
+            fields.completedAt = base_ + hours(completedOffsetHours);
+        }
+        if (categoryId > 0) {
+            fields.category = std::make_shared<Category>("Cat" + std::to_string(categoryId));
+            fields.category->SetId(categoryId);
+        }
+        return std::make_shared<Task>(std::move(fields));
+    }
+
+    std::vector<TaskPtr> SampleTasks() {
+        return {
+            MakeTask(1, Enums::TaskStatus::COMPLETED, Enums::Priority::HIGH, 1, 0, 48, 10),
+            MakeTask(2, Enums::TaskStatus::COMPLETED, Enums::Priority::LOW, 1, 2, 48, 8),
+            MakeTask(3, Enums::TaskStatus::PENDING, Enums::Priority::HIGH, 2, 4, 24),
+            MakeTask(4, Enums::TaskStatus::IN_PROGRESS, Enums::Priority::URGENT, 2, 6, 12),
+            MakeTask(5, Enums::TaskStatus::CANCELLED, Enums::Priority::MEDIUM, 0, 8, 9),
+            MakeTask(6, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 500, 600) // Outside window
+        };
+    }
+};
+
+// Test StatisticsManager
+TEST_F(BusinessLogicTest, StatisticsManager_BuildReport) {
+    auto tasks = SampleTasks();
+    Clock::GetInstance().SetFixedTime(base_ + hours(20));
+
+    auto report = StatisticsManager::BuildReport(tasks, base_, base_ + hours(100));
+    const auto& overall = report->GetOverallStats();
+
+    EXPECT_EQ(overall.totalTasks, 5);
+    EXPECT_EQ(overall.completedTasks, 2);
+    EXPECT_EQ(overall.pendingTasks, 1);
+    EXPECT_EQ(overall.overdueTasks, 1); // Task 4 was due at +12h
+    EXPECT_DOUBLE_EQ(overall.completionRate, 0.4);
+    EXPECT_DOUBLE_EQ(overall.averageCompletionTimeHours, 8.0);
+    EXPECT_EQ(overall.tasksByPriority.at(Enums::Priority::HIGH), 2);
+    EXPECT_EQ(overall.tasksByStatus.count(Enums::TaskStatus::CANCELLED), 1u);
+
+    const auto& categories = report->GetCategoryStats();
+    ASSERT_EQ(categories.size(), 2u);
+    EXPECT_EQ(categories.at(1).totalTasks, 2);
+    EXPECT_DOUBLE_EQ(categories.at(1).completionRate, 1.0);
+    EXPECT_EQ(categories.at(2).overdueTasks, 1);
+}
+
+TEST_F(BusinessLogicTest, StatisticsManager_ParallelMatchesSingleThread) {
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 60000; ++i) {
+        auto status = static_cast<Enums::TaskStatus>(i % 4);
+        auto priority = static_cast<Enums::Priority>((i / 4) % 4);
+        tasks.push_back(MakeTask(i + 1, status, priority, i % 7, i % 90, (i % 90) + 5, (i % 90) + 3));
+    }
+
+    auto single = StatisticsManager::BuildReport(tasks, base_, base_ + hours(100), 1);
+    auto parallel = StatisticsManager::BuildReport(tasks, base_, base_ + hours(100), 4);
+
+    EXPECT_EQ(single->GetOverallStats().totalTasks, parallel->GetOverallStats().totalTasks);
+    EXPECT_EQ(single->GetOverallStats().overdueTasks, parallel->GetOverallStats().overdueTasks);
+    EXPECT_EQ(single->GetOverallStats().tasksByPriority, parallel->GetOverallStats().tasksByPriority);
+    EXPECT_NEAR(single->GetOverallStats().averageCompletionTimeHours,
+                parallel->GetOverallStats().averageCompletionTimeHours, 1e-9);
+    EXPECT_EQ(single->GetCategoryStats().size(), parallel->GetCategoryStats().size());
+}
+
+// In-memory repository that counts writes
+class FakeTaskRepository : public ITaskRepository {
+public:
+    int saveCount = 0;
+    std::vector<TaskPtr> stored;
+    uint64_t lastSaved = 0;
+
+    bool SaveTasks(const std::vector<TaskPtr>& tasks) override {
+        ++saveCount;
+        stored = tasks;
+        lastSaved = IdGenerator::GetInstance().GetCurrentVersion();
+        for (const auto& task : tasks) {
+            task->MarkClean();
+        }
+        return true;
+    }
+    std::vector<TaskPtr> LoadTasks() override { return stored; }
+    uint64_t GetLastSavedVersion() const override { return lastSaved; }
+    void TrackTask(const TaskPtr& task) override { changes->Track(task); }
+    void RecordTaskRemoval(int taskId) override { changes->RecordRemoval(taskId); }
+    void ClearTaskChanges() override { changes->Clear(); }
+    std::vector<TaskPtr> GetTasksChangedSince(uint64_t version) const override {
+        return changes->GetChangedSince(version);
+    }
+    std::vector<int> GetTasksRemovedSince(uint64_t version) const override { return changes->GetRemovedSince(version); }
+
+private:
+    Common::Ref<TaskChangeLog> changes = std::make_shared<TaskChangeLog>();
+};
+
+// Components that keep a clock reference reject temporaries
+static_assert(!std::is_constructible_v<QueryEngine, Clock&&>);
+static_assert(!std::is_constructible_v<LiveStatsAggregator, Clock&&>);
+static_assert(!std::is_constructible_v<MaterializedViews, Clock&&>);
+static_assert(!std::is_constructible_v<MaterializedViews, std::chrono::system_clock::time_point, Clock&&>);
+static_assert(std::is_constructible_v<QueryEngine, const Clock&>);
+
+// Test TaskService
+TEST_F(BusinessLogicTest, TaskService_AddUpdateRemove) {
+    TaskService service;
+    auto task = service.AddTask(std::make_shared<Task>("Write report", "", base_ + hours(5)));
+    EXPECT_GT(task->GetId(), 0);
+    EXPECT_EQ(service.GetTask(task->GetId()), task);
+    static_assert(std::is_same_v<decltype(*service.GetAllTasks().begin()), ConstTaskPtr>);
+    ASSERT_EQ(service.GetAllTasks().size(), 1u);
+    EXPECT_EQ(service.GetAllTasks()[0], task);
+
+    EXPECT_TRUE(service.UpdateTask(task->GetId(), [](Task& t) { t.SetPriority(Enums::Priority::URGENT); }));
+    EXPECT_EQ(service.GetTask(task->GetId())->GetPriority(), Enums::Priority::URGENT);
+    EXPECT_FALSE(service.UpdateTask(-5, [](Task&) {}));
+
+    // A throwing mutator still notifies observers of what it changed
+    auto live = std::make_shared<LiveStatsAggregator>();
+    service.AddObserver(live);
+    EXPECT_THROW(service.UpdateTask(task->GetId(), [](Task& t) {
+        t.SetStatus(Enums::TaskStatus::COMPLETED);
+        throw std::runtime_error("interrupted");
+    }), std::runtime_error);
+    EXPECT_EQ(live->GetOverallStats().completedTasks, 1);
+
+    // The ID is locked before anything changes
+    int id = task->GetId();
+    EXPECT_THROW(service.UpdateTask(id, [](Task& t) { t.SetId(t.GetId() + 1000); }), std::logic_error);
+    EXPECT_EQ(service.GetTask(id), task);
+
+    EXPECT_THROW(service.AddTask(task), std::invalid_argument);
+    EXPECT_TRUE(service.RemoveTask(task->GetId()));
+    EXPECT_EQ(service.GetTaskCount(), 0u);
+    EXPECT_FALSE(service.RemoveTask(task->GetId()));
+}
+
+TEST_F(BusinessLogicTest, TaskService_SaveSkipsWhenUnchanged) {
+    auto repository = std::make_shared<FakeTaskRepository>();
+    TaskService service(repository);
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+
+    EXPECT_TRUE(service.SaveTasks());
+    EXPECT_TRUE(service.SaveTasks());
+    EXPECT_EQ(repository->saveCount, 1);
+
+    service.SetTaskStatus(3, Enums::TaskStatus::COMPLETED);
+    EXPECT_TRUE(service.HasUnsavedChanges());
+    auto changed = repository->GetTasksChangedSince(repository->GetLastSavedVersion());
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0]->GetId(), 3);
+    EXPECT_TRUE(service.SaveTasks());
+    EXPECT_EQ(repository->saveCount, 2);
+
+    service.RemoveTask(1);
+    EXPECT_TRUE(repository->GetTasksChangedSince(repository->GetLastSavedVersion()).empty());
+    EXPECT_EQ(repository->GetTasksRemovedSince(repository->GetLastSavedVersion()), std::vector<int>({1}));
+    EXPECT_TRUE(service.SaveTasks());
+    EXPECT_EQ(repository->saveCount, 3);
+}
+
+// Test LiveStatsAggregator
+TEST_F(BusinessLogicTest, LiveStatsAggregator_AppliesDeltas) {
+    TaskService service;
+    auto live = std::make_shared<LiveStatsAggregator>();
+    service.AddObserver(live);
+
+    auto tasks = SampleTasks();
+    for (const auto& task : tasks) {
+        service.AddTask(task);
+    }
+    EXPECT_EQ(live->GetOverallStats().totalTasks, 6);
+    EXPECT_EQ(live->GetOverallStats().completedTasks, 2);
+
+    Clock::GetInstance().Advance(hours(2));
+    service.SetTaskStatus(3, Enums::TaskStatus::COMPLETED);
+    service.UpdateTask(6, [](Task& t) { t.SetPriority(Enums::Priority::URGENT); });
+    service.RemoveTask(5);
+    std::erase_if(tasks, [](const TaskPtr& task) { return task->GetId() == 5; });
+    EXPECT_EQ(service.GetAllTasks().size(), tasks.size());
+
+    auto overall = live->GetOverallStats();
+    EXPECT_EQ(overall.totalTasks, 5);
+    EXPECT_EQ(overall.completedTasks, 3);
+    EXPECT_EQ(overall.tasksByPriority.at(Enums::Priority::URGENT), 2);
+    EXPECT_EQ(live->GetCategoryStats(2).completedTasks, 1);
+    EXPECT_TRUE(live->Verify(tasks));
+
+    // Full recompute agrees with the one-pass report builder
+    live->Recompute(tasks);
+    auto report = StatisticsManager::BuildReport(tasks,
+                                                 system_clock::time_point::min(),
+                                                 system_clock::time_point::max());
+    EXPECT_EQ(live->GetOverallStats().totalTasks, report->GetOverallStats().totalTasks);
+    EXPECT_EQ(live->GetOverallStats().overdueTasks, report->GetOverallStats().overdueTasks);
+    EXPECT_NEAR(live->GetOverallStats().averageCompletionTimeHours,
+                report->GetOverallStats().averageCompletionTimeHours, 1e-9);
+}
+
+// Test DailyRollup
+TEST_F(BusinessLogicTest, DailyRollup_RangeCountsFollowUpdates) {
+    TaskService service;
+    auto rollup = std::make_shared<DailyRollup>();
+    service.AddObserver(rollup);
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+
+    auto from = base_ - hours(48);
+    auto to = base_ + hours(48);
+    EXPECT_EQ(rollup->Count(RollupMetric::CREATED, RollupDimension::ALL, 0, from, to), 5);
+    EXPECT_EQ(rollup->Count(RollupMetric::CREATED, RollupDimension::ALL, 0, from, base_ + hours(800)), 6);
+    EXPECT_EQ(rollup->Count(RollupMetric::CREATED, RollupDimension::CATEGORY, 1, from, to), 2);
+    EXPECT_EQ(rollup->Count(RollupMetric::COMPLETED, RollupDimension::ALL, 0, from, to), 2);
+
+    auto stats = rollup->GetRangeStats(from, to);
+    EXPECT_EQ(stats.totalTasks, 5);
+    EXPECT_EQ(stats.completedTasks, 2);
+    EXPECT_EQ(stats.pendingTasks, 1);
+    EXPECT_DOUBLE_EQ(stats.averageCompletionTimeHours, 8.0);
+
+    // Completing a task moves it between status buckets
+    Clock::GetInstance().Advance(hours(4));
+    service.SetTaskStatus(3, Enums::TaskStatus::COMPLETED);
+    service.RemoveTask(5);
+
+    stats = rollup->GetRangeStats(from, to);
+    EXPECT_EQ(stats.totalTasks, 4);
+    EXPECT_EQ(stats.completedTasks, 3);
+    EXPECT_EQ(stats.pendingTasks, 0);
+    EXPECT_EQ(rollup->Count(RollupMetric::CREATED, RollupDimension::STATUS,
+                            static_cast<int>(Enums::TaskStatus::PENDING), from, to), 0);
+    EXPECT_EQ(rollup->GetRangeStats(from, to, 2).completedTasks, 1);
+}
+
+TEST_F(BusinessLogicTest, DailyRollup_SaveAndLoad) {
+    DailyRollup rollup;
+    for (const auto& task : SampleTasks()) {
+        rollup.OnTaskAdded(task);
+    }
+
+    std::string filename = "test_rollup.csv";
+    ASSERT_TRUE(rollup.Save(filename));
+
+    DailyRollup loaded;
+    ASSERT_TRUE(loaded.Load(filename));
+    auto from = base_ - hours(48);
+    auto to = base_ + hours(800);
+    EXPECT_EQ(loaded.Count(RollupMetric::CREATED, RollupDimension::ALL, 0, from, to), 6);
+    EXPECT_EQ(loaded.Count(RollupMetric::CREATED, RollupDimension::PRIORITY,
+                           static_cast<int>(Enums::Priority::LOW), from, to), 2);
+
+    // Loaded contributions let later removals subtract correctly
+    loaded.OnTaskRemoved(SampleTasks()[0]);
+    EXPECT_EQ(loaded.Count(RollupMetric::COMPLETED, RollupDimension::ALL, 0, from, to), 1);
+
+    std::filesystem::remove(filename);
+}
+
+TEST_F(BusinessLogicTest, DailyRollup_ReplaySkipsCoveredTasks) {
+    auto tasks = SampleTasks();
+    DailyRollup rollup;
+    for (const auto& task : tasks) {
+        rollup.OnTaskAdded(task);
+    }
+    std::string filename = "test_rollup_replay.csv";
+    ASSERT_TRUE(rollup.Save(filename));
+
+    // Edited before Load: the replay trusts the file, so the edit is not seen
+    TaskService service;
+    for (const auto& task : tasks) {
+        service.AddTask(task);
+    }
+    tasks[1]->SetPriority(Enums::Priority::URGENT);
+    auto loaded = std::make_shared<DailyRollup>();
+    ASSERT_TRUE(loaded->Load(filename));
+    service.AddObserver(loaded);
+
+    auto from = base_ - hours(48);
+    auto to = base_ + hours(800);
+    auto urgent = static_cast<int>(Enums::Priority::URGENT);
+    EXPECT_EQ(loaded->Count(RollupMetric::CREATED, RollupDimension::ALL, 0, from, to), 6);
+    EXPECT_EQ(loaded->Count(RollupMetric::CREATED, RollupDimension::PRIORITY, urgent, from, to), 1);
+
+    // Changes after Load are applied
+    auto medium = static_cast<int>(Enums::Priority::MEDIUM);
+    service.UpdateTask(2, [](Task& task) { task.SetPriority(Enums::Priority::MEDIUM); });
+    EXPECT_EQ(loaded->Count(RollupMetric::CREATED, RollupDimension::PRIORITY, medium, from, to), 2);
+    EXPECT_EQ(loaded->Count(RollupMetric::CREATED, RollupDimension::PRIORITY, urgent, from, to), 1);
+    EXPECT_EQ(loaded->Count(RollupMetric::CREATED, RollupDimension::ALL, 0, from, to), 6);
+
+    std::filesystem::remove(filename);
+}
+
+TEST_F(BusinessLogicTest, DailyRollup_OutlierDatesStaySparse) {
+    DailyRollup rollup;
+    auto epoch = system_clock::time_point{};
+    int toEpoch = -static_cast<int>(duration_cast<hours>(base_ - epoch).count());
+    auto early = MakeTask(1, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 0, toEpoch + 5, 1);
+    auto late = MakeTask(2, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 0, toEpoch + 24 * 47482, 1); // 2100
+    rollup.OnTaskAdded(early);
+    rollup.OnTaskAdded(late);
+    rollup.OnTaskAdded(MakeTask(3, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 0, 0, 1));
+
+    EXPECT_EQ(rollup.Count(RollupMetric::CREATED, RollupDimension::ALL, 0, epoch, epoch + hours(24)), 1);
+    EXPECT_EQ(rollup.Count(RollupMetric::CREATED, RollupDimension::ALL, 0, epoch + hours(24), base_ + hours(24)), 1);
+    EXPECT_EQ(rollup.Count(RollupMetric::CREATED, RollupDimension::ALL, 0,
+                           system_clock::time_point::min(), system_clock::time_point::max()), 3);
+
+    rollup.OnTaskRemoved(late);
+    EXPECT_EQ(rollup.Count(RollupMetric::CREATED, RollupDimension::ALL, 0, base_, system_clock::time_point::max()), 1);
+}
+
+// Test TaskTable
+TEST_F(BusinessLogicTest, TaskTable_StatsMatchReport) {
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 1000; ++i) {
+        auto status = static_cast<Enums::TaskStatus>(i % 4);
+        auto priority = static_cast<Enums::Priority>((i / 4) % 4);
+        tasks.push_back(MakeTask(i + 1, status, priority, i % 7, i % 90, (i % 90) + 5, (i % 90) + 1 + i % 37));
+    }
+    Clock::GetInstance().SetFixedTime(base_ + hours(50));
+
+    TaskTable table(tasks);
+    auto from = base_;
+    auto to = base_ + hours(60);
+    auto stats = table.ComputeStats(table.SelectCreatedBetween(from, to), base_ + hours(50));
+    auto expected = StatisticsManager::BuildReport(tasks, from, to)->GetOverallStats();
+
+    EXPECT_EQ(stats.totalTasks, expected.totalTasks);
+    EXPECT_EQ(stats.completedTasks, expected.completedTasks);
+    EXPECT_EQ(stats.pendingTasks, expected.pendingTasks);
+    EXPECT_EQ(stats.overdueTasks, expected.overdueTasks);
+    EXPECT_EQ(stats.tasksByPriority, expected.tasksByPriority);
+    EXPECT_EQ(stats.tasksByStatus, expected.tasksByStatus);
+    EXPECT_NEAR(stats.averageCompletionTimeHours, expected.averageCompletionTimeHours, 1e-9);
+    EXPECT_LT(stats.completionTimeP50Hours, stats.completionTimeP99Hours);
+    EXPECT_DOUBLE_EQ(stats.completionTimeP50Hours, expected.completionTimeP50Hours);
+    EXPECT_DOUBLE_EQ(stats.completionTimeP90Hours, expected.completionTimeP90Hours);
+    EXPECT_DOUBLE_EQ(stats.completionTimeP99Hours, expected.completionTimeP99Hours);
+
+    auto urgentInCategory = table.SelectPriority(Enums::Priority::URGENT) & table.SelectCategory(3);
+    for (size_t row : urgentInCategory.ToIndices()) {
+        EXPECT_EQ(table.GetTaskId(row) % 7, 4); // Category i % 7 for id i + 1
+    }
+    EXPECT_GT(urgentInCategory.Count(), 0u);
+}
+
+TEST_F(BusinessLogicTest, TaskTable_FollowsTaskService) {
+    TaskService service;
+    auto table = std::make_shared<TaskTable>();
+    service.AddObserver(table);
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+    EXPECT_EQ(table->GetRowCount(), 6u);
+
+    service.RemoveTask(1);
+    service.SetTaskStatus(3, Enums::TaskStatus::COMPLETED);
+    EXPECT_EQ(table->GetRowCount(), 5u);
+    EXPECT_EQ(table->FindRow(1), -1);
+
+    int row = table->FindRow(3);
+    ASSERT_GE(row, 0);
+    EXPECT_TRUE(table->GetCompletedValidity().Test(static_cast<size_t>(row)));
+    EXPECT_EQ(table->SelectStatus(Enums::TaskStatus::COMPLETED).Count(), 2u);
+    EXPECT_EQ(table->SelectAll().AndNot(table->GetCategoryValidity()).Count(), 1u); // Task 5
+}
+
+// Test sketches
+TEST_F(BusinessLogicTest, LogHistogram_QuantilesWithinError) {
+    LogHistogram histogram;
+    for (int64_t value = 1; value <= 100000; ++value) {
+        histogram.Add(value);
+    }
+    EXPECT_NEAR(histogram.Quantile(0.50), 50000.0, 50000.0 * 0.02);
+    EXPECT_NEAR(histogram.Quantile(0.99), 99000.0, 99000.0 * 0.02);
+
+    // Merged halves equal the whole; removal undoes an add
+    LogHistogram low, high;
+    for (int64_t value = 1; value <= 100000; ++value) {
+        (value <= 50000 ? low : high).Add(value);
+    }
+    low.Merge(high);
+    EXPECT_TRUE(low == histogram);
+    low.Add(7);
+    low.Remove(7);
+    EXPECT_TRUE(low == histogram);
+}
+
+TEST_F(BusinessLogicTest, SpaceSavingAndHyperLogLog_Merge) {
+    SpaceSaving left(8), right(8);
+    HyperLogLog leftDistinct, rightDistinct;
+    for (int i = 0; i < 20000; ++i) {
+        std::string tag = (i % 3 == 0) ? "urgent" : (i % 5 == 0) ? "work" : "tag" + std::to_string(i);
+        (i % 2 ? left : right).Add(tag);
+        (i % 2 ? leftDistinct : rightDistinct).Add(tag);
+    }
+    left.Merge(right);
+    leftDistinct.Merge(rightDistinct);
+
+    auto top = left.Top(2);
+    ASSERT_EQ(top.size(), 2u);
+    EXPECT_EQ(top[0].key, "urgent");
+    EXPECT_EQ(top[1].key, "work");
+    EXPECT_GE(top[0].count, 6667);
+    EXPECT_LE(top[0].count - top[0].error, 6667);
+    EXPECT_EQ(left.GetTotalCount(), 20000);
+
+    double distinct = 20000 - 6667 - 2667 + 2; // Unique tags plus the two repeated ones
+    EXPECT_NEAR(leftDistinct.Estimate(), distinct, distinct * 0.05);
+}
+
+TEST_F(BusinessLogicTest, StatisticsManager_ReportsPercentilesAndTags) {
+    auto tasks = SampleTasks();
+    tasks[0]->AddTag("home");
+    tasks[1]->AddTag("home");
+    tasks[2]->AddTag("work");
+
+    auto report = StatisticsManager::BuildReport(tasks, base_, base_ + hours(100));
+    const auto& overall = report->GetOverallStats();
+    EXPECT_NEAR(overall.completionTimeP50Hours, 6.0, 0.2);  // Completions took 10h and 6h
+    EXPECT_NEAR(overall.completionTimeP99Hours, 10.0, 0.2);
+
+    ASSERT_EQ(report->GetTopTags().size(), 2u);
+    EXPECT_EQ(report->GetTopTags()[0].tag, "home");
+    EXPECT_EQ(report->GetTopTags()[0].count, 2);
+    EXPECT_EQ(report->GetDistinctTagCount(), 2u);
+    EXPECT_NE(report->GenerateSummaryReport().find("TOP TAGS"), std::string::npos);
+}
+
+// Test ReportWriter
+TEST_F(BusinessLogicTest, ReportWriter_BatchesToFileDescriptor) {
+    std::string filename = "test_reports.csv";
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+
+    auto report = StatisticsManager::BuildReport(SampleTasks(), base_, base_ + hours(100));
+    {
+        ReportWriter writer(fd, ReportFormat::CSV, 256);
+        for (int i = 0; i < 50; ++i) {
+            ASSERT_TRUE(writer.Write(*report));
+        }
+        EXPECT_EQ(writer.GetReportCount(), 50u);
+    }
+    ::close(fd);
+
+    std::ifstream file(filename);
+    std::string line;
+    int lines = 0;
+    std::getline(file, line);
+    EXPECT_EQ(line.rfind("startDate,endDate,scope", 0), 0u); // Header once
+    while (std::getline(file, line)) {
+        EXPECT_EQ(line.find("startDate"), std::string::npos);
+        ++lines;
+    }
+    EXPECT_EQ(lines, 50 * 3); // Overall + two categories per report
+    std::filesystem::remove(filename);
+}
+
+// Test StreamingReportBuilder
+TEST_F(BusinessLogicTest, StreamingReportBuilder_MatchesInMemoryReport) {
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 300; ++i) {
+        auto status = static_cast<Enums::TaskStatus>(i % 4);
+        auto priority = static_cast<Enums::Priority>((i / 4) % 4);
+        auto task = MakeTask(i + 1, status, priority, i % 5, i % 120, (i % 120) + 5, (i % 120) + 3);
+        task->AddTag(i % 3 ? "work" : "home, garden");
+        tasks.push_back(task);
+    }
+    Clock::GetInstance().SetFixedTime(base_ + hours(60));
+
+    std::string folder = "stream_test_data/";
+    CSVDataManager(folder).SaveTasks(tasks);
+    JSONDataManager(folder).SaveTasks(tasks);
+
+    auto from = base_ + hours(10);
+    auto to = base_ + hours(100);
+    auto expected = StatisticsManager::BuildReport(tasks, from, to);
+
+    for (auto streamed : {StreamingReportBuilder::BuildFromCsv(folder + "tasks.csv", from, to, 1),
+                          StreamingReportBuilder::BuildFromCsv(folder + "tasks.csv", from, to, 3),
+                          StreamingReportBuilder::BuildFromFile(folder + "tasks.json", from, to)}) {
+        ASSERT_NE(streamed, nullptr);
+        const auto& actual = streamed->GetOverallStats();
+        const auto& wanted = expected->GetOverallStats();
+        EXPECT_EQ(actual.totalTasks, wanted.totalTasks);
+        EXPECT_EQ(actual.completedTasks, wanted.completedTasks);
+        EXPECT_EQ(actual.overdueTasks, wanted.overdueTasks);
+        EXPECT_EQ(actual.tasksByPriority, wanted.tasksByPriority);
+        EXPECT_NEAR(actual.averageCompletionTimeHours, wanted.averageCompletionTimeHours, 1e-9);
+        EXPECT_EQ(streamed->GetCategoryStats().size(), expected->GetCategoryStats().size());
+        EXPECT_EQ(streamed->GetCategoryStats().at(3).totalTasks, expected->GetCategoryStats().at(3).totalTasks);
+        ASSERT_EQ(streamed->GetTopTags().size(), 2u);
+        EXPECT_EQ(streamed->GetTopTags()[1].tag, "home, garden");
+        EXPECT_EQ(streamed->GetTopTags()[1].count, expected->GetTopTags()[1].count);
+    }
+
+    EXPECT_EQ(StreamingReportBuilder::BuildFromCsv(folder + "missing.csv", from, to), nullptr);
+    EXPECT_THROW(StreamingReportBuilder::BuildFromFile(folder + "tasks.txt", from, to), std::invalid_argument);
+    std::filesystem::remove_all(folder);
+}
+
+TEST_F(BusinessLogicTest, StreamingReportBuilder_JsonKeysOnlyAtTopLevel) {
+    auto tasks = SampleTasks();
+    tasks[0]->SetTitle("status");
+    tasks[1]->SetTitle("dueDate");
+    tasks[2]->SetDescription("createdAt");
+    tasks[3]->SetTitle("\"status\": \"x\"");
+    tasks[4]->AddTag("tags");
+
+    std::string folder = "stream_keys_data/";
+    JSONDataManager(folder).SaveTasks(tasks);
+    auto from = base_ - hours(10);
+    auto to = base_ + hours(100);
+    auto expected = StatisticsManager::BuildReport(tasks, from, to);
+    auto streamed = StreamingReportBuilder::BuildFromFile(folder + "tasks.json", from, to);
+
+    ASSERT_NE(streamed, nullptr);
+    EXPECT_EQ(streamed->GetOverallStats().totalTasks, expected->GetOverallStats().totalTasks);
+    EXPECT_EQ(streamed->GetOverallStats().tasksByStatus, expected->GetOverallStats().tasksByStatus);
+    EXPECT_EQ(streamed->GetOverallStats().overdueTasks, expected->GetOverallStats().overdueTasks);
+    ASSERT_EQ(streamed->GetTopTags().size(), 1u);
+    EXPECT_EQ(streamed->GetTopTags()[0].tag, "tags");
+    std::filesystem::remove_all(folder);
+}
+
+// Test TaskEventStore
+TEST_F(BusinessLogicTest, TaskEventStore_RecordsTransitions) {
+    TaskService service;
+    auto store = std::make_shared<TaskEventStore>();
+    service.AddObserver(store);
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+
+    Clock::GetInstance().Advance(hours(30));
+    service.SetTaskStatus(3, Enums::TaskStatus::IN_PROGRESS);
+    service.SetTaskStatus(3, Enums::TaskStatus::COMPLETED);
+    service.UpdateTask(4, [](Task& t) { t.SetTitle("Renamed"); }); // No status change
+
+    // 6 added + 2 loaded completions + 2 transitions
+    EXPECT_EQ(store->GetEventCount(), 10u);
+
+    auto perHour = store->Downsample(base_, base_ + hours(40), TimeBucket::HOUR, Enums::TaskStatus::COMPLETED);
+    ASSERT_EQ(perHour.size(), 40u);
+    EXPECT_EQ(perHour[8], 1);  // Task 2
+    EXPECT_EQ(perHour[10], 1); // Task 1
+    EXPECT_EQ(perHour[30], 1); // Task 3
+    auto perDay = store->Downsample(base_, base_ + hours(48), TimeBucket::DAY, Enums::TaskStatus::COMPLETED, 2);
+    EXPECT_EQ(perDay, (std::vector<int>{0, 1}));
+
+    auto stats = store->GetActivityStats(base_, base_ + hours(48));
+    EXPECT_EQ(stats.totalTasks, 5);
+    EXPECT_EQ(stats.completedTasks, 3);
+    EXPECT_EQ(stats.tasksByStatus.at(Enums::TaskStatus::IN_PROGRESS), 1);
+}
+
+TEST_F(BusinessLogicTest, TaskEventStore_BlocksCompressAndScan) {
+    TaskEventStore store;
+    for (int i = 0; i < 5000; ++i) {
+        TaskEvent event;
+        event.time = base_ + seconds(i * 60 + (i % 7));
+        event.taskId = 1000 + i / 2;
+        event.categoryId = i % 3;
+        event.toStatus = static_cast<Enums::TaskStatus>(i % 4);
+        store.Append(event);
+    }
+    EXPECT_EQ(store.GetBlockCount(), 5000u / TaskEventStore::BLOCK_EVENTS);
+    EXPECT_LT(store.GetEncodedBytes(), 5000u * 8); // Well under the raw 24 bytes per event
+
+    auto from = base_ + minutes(1500);
+    auto to = base_ + minutes(3500);
+    auto events = store.Scan(from, to);
+    ASSERT_EQ(events.size(), 2000u);
+    EXPECT_EQ(events.front().taskId, 1000 + 1500 / 2);
+    EXPECT_EQ(events.back().toStatus, static_cast<Enums::TaskStatus>(3499 % 4));
+
+    // Header-only aggregation agrees with decoding every event
+    auto buckets = store.Downsample(base_, base_ + hours(100), TimeBucket::DAY, Enums::TaskStatus::COMPLETED);
+    int total = 0;
+    for (int count : buckets) {
+        total += count;
+    }
+    EXPECT_EQ(total, 1250);
+    EXPECT_EQ(store.GetActivityStats(base_, base_ + hours(100)).completedTasks, 1250);
+}
+
+// Test HeatmapBuilder
+TEST_F(BusinessLogicTest, HeatmapBuilder_BucketsLocalWeekdayHour) {
+    // 2025-03-01 is a Saturday; base_ is 08:00 local time
+    auto utcOffset = UtcOffsetTable::Local().OffsetAt(system_clock::to_time_t(base_));
+    auto offsets = UtcOffsetTable::Fixed(utcOffset);
+
+    auto result = HeatmapBuilder::Build(SampleTasks(), base_, base_ + hours(100), 1, offsets);
+    EXPECT_EQ(result.overall.GetTotal(), 2);
+    EXPECT_EQ(result.overall.Get(Enums::DayOfWeek::SATURDAY, 16), 1); // Task 2, +8h
+    EXPECT_EQ(result.overall.Get(Enums::DayOfWeek::SATURDAY, 18), 1); // Task 1, +10h
+    EXPECT_EQ(result.byCategory.at(1).GetTotal(), 2);
+
+    // Parallel chunks and the offset-table conversion agree with localtime
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 60000; ++i) {
+        tasks.push_back(MakeTask(i + 1, Enums::TaskStatus::COMPLETED, Enums::Priority::LOW, i % 3, 0, 1, i % 400));
+    }
+    auto single = HeatmapBuilder::Build(tasks, base_, base_ + hours(1000), 1);
+    auto parallel = HeatmapBuilder::Build(tasks, base_, base_ + hours(1000), 4);
+    EXPECT_EQ(single.overall.GetCells(), parallel.overall.GetCells());
+    EXPECT_EQ(single.byCategory.at(2).GetCells(), parallel.byCategory.at(2).GetCells());
+    EXPECT_EQ(single.overall.GetTotal(), 60000);
+
+    for (int h : {0, 17, 123, 399}) {
+        std::time_t time = system_clock::to_time_t(base_ + hours(h));
+        std::tm tm{};
+        localtime_r(&time, &tm);
+        int weeks = (400 - h % 168 + 167) / 168; // Offsets in [0, 400) landing on this cell
+        EXPECT_EQ(single.overall.Get(static_cast<Enums::DayOfWeek>(tm.tm_wday), tm.tm_hour), 150 * weeks) << h;
+    }
+    EXPECT_NE(single.overall.GenerateText().find("SAT"), std::string::npos);
+}
+
+// Test DueDateRiskEstimator
+TEST_F(BusinessLogicTest, DueDateRiskEstimator_ScoresOpenTasks) {
+    DueDateRiskEstimator estimator;
+    for (int i = 0; i < 3; ++i) {
+        estimator.ObserveCompletion(1, base_ + hours(i * 24), base_ + hours(i * 24 + 10));
+    }
+    estimator.ObserveCompletion(2, base_, base_ + hours(100)); // Too few samples for its own estimate
+    EXPECT_NEAR(estimator.GetEstimate(1).leadTimeHours, 10.0, 1e-9);
+    EXPECT_EQ(estimator.GetEstimate(2).samples, 4); // Overall fallback
+    EXPECT_GT(estimator.GetEstimate(1).throughputPerDay, 0.0);
+
+    std::vector<TaskPtr> tasks = {
+        MakeTask(1, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 100),
+        MakeTask(2, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 8),
+        MakeTask(3, Enums::TaskStatus::IN_PROGRESS, Enums::Priority::LOW, 1, 0, 4),
+        MakeTask(4, Enums::TaskStatus::COMPLETED, Enums::Priority::LOW, 1, 0, 4, 3),
+    };
+    TaskTable table(tasks);
+    auto asOf = base_ + hours(5);
+    auto scores = estimator.ScoreAll(table, asOf);
+    for (size_t row = 0; row < scores.size(); ++row) {
+        int id = table.GetTaskId(row);
+        EXPECT_NEAR(scores[row], estimator.ScoreTask(*tasks[id - 1], asOf), 1e-12);
+    }
+
+    auto atRisk = estimator.GetAtRisk(table, asOf, 0.5);
+    ASSERT_EQ(atRisk.size(), 2u);
+    EXPECT_EQ(atRisk[0].taskId, 3); // Already overdue
+    EXPECT_DOUBLE_EQ(atRisk[0].risk, 1.0);
+    EXPECT_EQ(atRisk[1].taskId, 2);
+    EXPECT_LT(estimator.ScoreTask(*tasks[0], asOf), 0.01);
+
+    // A backlog the category's throughput cannot clear in time raises the risk
+    DueDateRiskEstimator busy = estimator;
+    for (int id = 100; id < 130; ++id) {
+        busy.OnTaskAdded(MakeTask(id, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 500));
+    }
+    EXPECT_EQ(busy.GetEstimate(1, asOf).openTasks, 30);
+    EXPECT_GT(busy.ScoreTask(*tasks[0], asOf), 0.5);
+    scores = busy.ScoreAll(table, asOf);
+    for (size_t row = 0; row < scores.size(); ++row) {
+        EXPECT_NEAR(scores[row], busy.ScoreTask(*tasks[table.GetTaskId(row) - 1], asOf), 1e-12);
+    }
+}
+
+TEST_F(BusinessLogicTest, DueDateRiskEstimator_FollowsCompletions) {
+    TaskService service;
+    auto estimator = std::make_shared<DueDateRiskEstimator>();
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+    service.AddObserver(estimator);
+    EXPECT_EQ(estimator->GetEstimate(0).samples, 2); // Tasks 1 and 2
+
+    Clock::GetInstance().SetFixedTime(base_ + hours(20));
+    service.SetTaskStatus(3, Enums::TaskStatus::COMPLETED);
+    service.SetTaskStatus(3, Enums::TaskStatus::COMPLETED);
+    EXPECT_EQ(estimator->GetEstimate(0).samples, 3);
+
+    DueDateRiskEstimator seeded;
+    seeded.Seed(*StatisticsManager::BuildReport(SampleTasks(), base_, base_ + hours(48)));
+    EXPECT_NEAR(seeded.GetEstimate(0).leadTimeHours, 8.0, 1e-9); // (10 + 6) / 2
+
+    // Seeded categories are used before they have MIN_SAMPLES completions
+    DueDateRiskEstimator byCategory;
+    byCategory.Seed(*StatisticsManager::BuildReport({
+        MakeTask(1, Enums::TaskStatus::COMPLETED, Enums::Priority::LOW, 1, 0, 48, 10),
+        MakeTask(2, Enums::TaskStatus::COMPLETED, Enums::Priority::LOW, 1, 0, 48, 10),
+        MakeTask(3, Enums::TaskStatus::COMPLETED, Enums::Priority::LOW, 2, 0, 48, 40)}, base_, base_ + hours(48)));
+    EXPECT_NEAR(byCategory.GetEstimate(0).leadTimeHours, 20.0, 1e-9);
+    EXPECT_NEAR(byCategory.GetEstimate(2).leadTimeHours, 40.0, 1e-9);
+    EXPECT_TRUE(byCategory.GetEstimate(2).seeded);
+    EXPECT_EQ(byCategory.GetEstimate(2).samples, 0);
+
+    // The first real completion starts the rate instead of decaying from the epoch
+    byCategory.ObserveCompletion(2, base_, base_ + hours(40));
+    EXPECT_EQ(byCategory.GetEstimate(2).samples, 1);
+    EXPECT_NEAR(byCategory.GetEstimate(2).throughputPerDay, 1.0 / 7.0, 1e-12);
+    EXPECT_NEAR(byCategory.GetEstimate(2).leadTimeHours, 40.0, 1e-9);
+
+    // Without completions the rate fades at query time, one window per e-fold
+    auto quiet = base_ + hours(40) + hours(24 * 7);
+    EXPECT_NEAR(byCategory.GetEstimate(2, quiet).throughputPerDay, std::exp(-1.0) / 7.0, 1e-12);
+}
+
+// Test DueDateIndex
+TEST_F(BusinessLogicTest, DueDateIndex_MatchesLinearScan) {
+    DueDateIndex index(false);
+    std::map<int, int> dueHours; // key: task ID
+    std::mt19937 rng(7);
+    for (int step = 0; step < 5000; ++step) {
+        int id = static_cast<int>(rng() % 1500);
+        if (rng() % 4 == 0) {
+            EXPECT_EQ(index.Erase(id), dueHours.erase(id) > 0);
+        } else {
+            int due = static_cast<int>(rng() % 2000);
+            index.Insert(id, base_ + hours(due));
+            dueHours[id] = due;
+        }
+    }
+    ASSERT_EQ(index.Size(), dueHours.size());
+
+    for (int query = 0; query < 50; ++query) {
+        int from = static_cast<int>(rng() % 2000);
+        int to = from + static_cast<int>(rng() % 300);
+        std::vector<std::pair<int, int>> expected; // (due, id)
+        for (const auto& [id, due] : dueHours) {
+            if (due >= from && due < to) {
+                expected.emplace_back(due, id);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+
+        EXPECT_EQ(index.Count(base_ + hours(from), base_ + hours(to)), expected.size());
+        auto range = index.GetRange(base_ + hours(from), base_ + hours(to));
+        ASSERT_EQ(range.size(), expected.size());
+        for (size_t i = 0; i < range.size(); ++i) {
+            EXPECT_EQ(range[i], expected[i].second);
+        }
+        auto first = index.FirstAfter(base_ + hours(from), 5);
+        for (size_t i = 0; i < first.size() && i < expected.size(); ++i) {
+            EXPECT_EQ(first[i].taskId, expected[i].second);
+        }
+    }
+}
+
+TEST_F(BusinessLogicTest, DueDateIndex_TracksOpenTasks) {
+    TaskService service;
+    auto index = std::make_shared<DueDateIndex>();
+    service.AddObserver(index);
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+    EXPECT_EQ(index->Size(), 3u); // Tasks 3, 4 and 6
+
+    auto asOf = base_ + hours(30);
+    EXPECT_EQ(index->CountOverdue(asOf), 2u);
+    EXPECT_EQ(index->GetOverdue(asOf), (std::vector<int>{4, 3}));
+
+    service.SetTaskStatus(4, Enums::TaskStatus::COMPLETED);
+    EXPECT_EQ(index->GetOverdue(asOf), std::vector<int>{3});
+    auto next = index->FirstAfter(asOf, 1);
+    ASSERT_EQ(next.size(), 1u);
+    EXPECT_EQ(next[0].taskId, 6);
+    EXPECT_EQ(next[0].GetDueDate(), base_ + hours(600));
+}
+
+// Test TaskBitmapIndex
+TEST_F(BusinessLogicTest, TaskBitmapIndex_EvaluatesFilters) {
+    TaskService service;
+    auto index = std::make_shared<TaskBitmapIndex>();
+    service.AddObserver(index);
+    std::vector<TaskPtr> tasks;
+    for (int i = 1; i <= 2000; ++i) {
+        auto task = MakeTask(i, static_cast<Enums::TaskStatus>(i % 4), static_cast<Enums::Priority>((i / 4) % 4),
+                             i % 13, 0, 24);
+        if (i % 5 == 0) {
+            task->AddTag("infra");
+        }
+        if (i % 3 == 0) {
+            task->AddTag("bug");
+        }
+        tasks.push_back(task);
+        service.AddTask(task);
+    }
+
+    TaskFilter filter;
+    filter.priorities = {Enums::Priority::HIGH, Enums::Priority::URGENT};
+    filter.statuses = {Enums::TaskStatus::IN_PROGRESS};
+    filter.categoryIds = {12};
+    filter.allTags = {"infra"};
+    filter.excludedTags = {"bug"};
+
+    auto matches = [&filter](const Task& task) {
+        auto has = [&task](const std::string& tag) {
+            return std::find(task.GetTags().begin(), task.GetTags().end(), tag) != task.GetTags().end();
+        };
+        return task.GetPriority() >= Enums::Priority::HIGH && task.GetStatus() == Enums::TaskStatus::IN_PROGRESS &&
+               task.GetCategoryId() == 12 && has("infra") && !has("bug");
+    };
+    auto expectMatches = [&]() {
+        std::vector<int> expected;
+        for (const auto& task : service.GetAllTasks()) {
+            if (matches(*task)) {
+                expected.push_back(task->GetId());
+            }
+        }
+        auto found = index->Find(filter);
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(found, expected);
+        return expected.size();
+    };
+    EXPECT_GT(expectMatches(), 0u);
+
+    // Incremental maintenance, including ordinal reuse
+    service.RemoveTask(1925);
+    service.SetTaskStatus(1825, Enums::TaskStatus::COMPLETED);
+    service.AddTask(MakeTask(5000, Enums::TaskStatus::IN_PROGRESS, Enums::Priority::URGENT, 12, 0, 24));
+    expectMatches();
+    EXPECT_EQ(index->Size(), 2000u);
+    EXPECT_EQ(index->GetOrdinal(5000), 1924); // Freed by task 1925
+    EXPECT_EQ(index->WithCategory(99).Cardinality(), 0u);
+}
+
+// Test TextSearchIndex
+TEST_F(BusinessLogicTest, TextSearchIndex_RanksAndFollowsEdits) {
+    TaskService service;
+    auto index = std::make_shared<TextSearchIndex>();
+    service.AddObserver(index);
+    auto addTask = [&](int id, const std::string& title, const std::string& description) {
+        auto task = MakeTask(id, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+        task->SetTitle(title);
+        task->SetDescription(description);
+        service.AddTask(task);
+    };
+    addTask(1, "Database migration", "Move the billing tables");
+    addTask(2, "Write report", "Quarterly report mentions the database once");
+    addTask(3, "Fix login", "Session cookie expires too early");
+
+    auto hits = index->Search("DATABASE migration");
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].taskId, 1); // Both words, in the title
+    EXPECT_EQ(hits[1].taskId, 2);
+    EXPECT_GT(hits[0].score, hits[1].score);
+    EXPECT_TRUE(index->Search("nothing-matches").empty());
+
+    service.UpdateTask(3, [](Task& task) { task.SetDescription("Database connection pool leaks"); });
+    EXPECT_EQ(index->GetDocumentFrequency("database"), 3u);
+    EXPECT_EQ(index->GetDocumentFrequency("cookie"), 0u);
+    service.RemoveTask(1);
+    hits = index->Search("migration");
+    EXPECT_TRUE(hits.empty());
+    EXPECT_EQ(index->Size(), 2u);
+}
+
+TEST_F(BusinessLogicTest, TextSearchIndex_SubstringMatchesScan) {
+    auto index = std::make_shared<TextSearchIndex>();
+    std::vector<TaskPtr> tasks;
+    std::mt19937 rng(3);
+    const std::string alphabet = "abcDEF gh";
+    for (int id = 1; id <= 500; ++id) {
+        auto task = MakeTask(id, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+        std::string title, description;
+        for (int i = 0; i < 12; ++i) {
+            title += alphabet[rng() % alphabet.size()];
+        }
+        for (int i = 0; i < 60; ++i) {
+            description += alphabet[rng() % alphabet.size()];
+        }
+        task->SetTitle(title);
+        task->SetDescription(description);
+        tasks.push_back(task);
+        index->OnTaskAdded(task);
+    }
+
+    for (const std::string pattern : {"ab", "cde", "FgH", "a b c", "hhhh", "zzz"}) {
+        std::vector<int> expected;
+        std::string lowered = StringUtils::ToLower(pattern);
+        for (const auto& task : tasks) {
+            if (StringUtils::Contains(StringUtils::ToLower(task->GetTitle()), lowered) ||
+                StringUtils::Contains(StringUtils::ToLower(task->GetDescription()), lowered)) {
+                expected.push_back(task->GetId());
+            }
+        }
+        EXPECT_EQ(index->FindSubstring(pattern), expected) << pattern;
+    }
+}
+
+// Test QueryEngine
+TEST_F(BusinessLogicTest, QueryEngine_MatchesBruteForce) {
+    TaskService service;
+    auto engine = std::make_shared<QueryEngine>();
+    service.AddObserver(engine);
+    for (int i = 1; i <= 3000; ++i) {
+        auto task = MakeTask(i, static_cast<Enums::TaskStatus>(i % 4), static_cast<Enums::Priority>((i / 3) % 4),
+                             i % 9, -(i % 200), (i * 37) % 2000 - 500, i % 50 == 2 ? -1 : 1);
+        task->SetTitle(i % 10 == 0 ? "Deploy service " + std::to_string(i) : "Task " + std::to_string(i));
+        if (i % 7 == 0) {
+            task->AddTag("ops");
+        }
+        service.AddTask(task);
+    }
+    service.RemoveTask(70);
+
+    const std::vector<std::string> queries = {
+        "status in (PENDING, IN_PROGRESS) and due < now+7d and tag = \"ops\" order by priority desc, due asc limit 50",
+        "priority >= HIGH and category != 3 and not tag = ops order by due desc limit 10",
+        "(status = COMPLETED or priority = URGENT) and due >= now+1d and due < now+2d",
+        "title contains \"deploy\" and created > now-50h order by title asc limit 5",
+        "due < now and status != CANCELLED and status != COMPLETED",
+        "order by created desc, id asc limit 3",
+        "category = 0 and priority = LOW order by id asc",
+        "category != 0 and status = PENDING order by id desc limit 20",
+        "category in (0, 4) and not category = 4 and due < now",
+        "completed <= now+2h order by id asc",
+    };
+    auto now = Clock::GetInstance().Now();
+    for (const auto& text : queries) {
+        auto query = TaskQuery::Parse(text);
+        std::vector<ConstTaskPtr> expected;
+        for (const auto& task : service.GetAllTasks()) {
+            if (!query.HasFilter() || TaskQuery::Matches(query.GetFilter(), *task, now)) {
+                expected.push_back(task);
+            }
+        }
+        std::sort(expected.begin(), expected.end(), [&query](const ConstTaskPtr& lhs, const ConstTaskPtr& rhs) {
+            return TaskQuery::Compare(query.GetOrder(), *lhs, *rhs) < 0;
+        });
+        if (query.GetLimit() > 0 && expected.size() > query.GetLimit()) {
+            expected.resize(query.GetLimit());
+        }
+
+        auto result = engine->Execute(query, now);
+        EXPECT_EQ(std::vector<ConstTaskPtr>(result.tasks.begin(), result.tasks.end()), expected) << text;
+        EXPECT_FALSE(expected.empty()) << text;
+    }
+
+    // Completed tasks without a completion time never match completion bounds
+    auto completed = engine->Execute(TaskQuery::Parse("completed <= now+2h"), now).tasks;
+    EXPECT_EQ(completed.size(), 750u - 30u - 1u); // Unset times, removed task 70
+    for (const auto& task : completed) {
+        EXPECT_NE(task->GetCompletedAt(), system_clock::time_point::min());
+    }
+}
+
+TEST_F(BusinessLogicTest, QueryEngine_ExplainAndErrors) {
+    TaskService service;
+    auto engine = std::make_shared<QueryEngine>();
+    service.AddObserver(engine);
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+
+    auto result = engine->Execute("status = PENDING and due < now+1d and title contains \"task\" order by due asc limit 1", true);
+    ASSERT_EQ(result.tasks.size(), 0u); // Task 3 is due in 24h, task 6 later
+    result = engine->Execute("status = pending and due <= now+24h order by due asc limit 1", true);
+    ASSERT_EQ(result.tasks.size(), 1u);
+    EXPECT_EQ(result.tasks[0]->GetId(), 3);
+    std::string explain = result.Explain();
+    EXPECT_NE(explain.find("index   status = PENDING [bitmap index"), std::string::npos) << explain;
+    EXPECT_NE(explain.find("sort"), std::string::npos) << explain;
+
+    EXPECT_EQ(TaskQuery::Describe(TaskQuery::Parse("tag in (a, \"b c\") or not due > now-2w").GetFilter()),
+              "tag in (\"a\", \"b c\") or not due > now-2w");
+    EXPECT_THROW(TaskQuery::Parse("status = DONE"), std::invalid_argument);
+    EXPECT_THROW(TaskQuery::Parse("due in (now)"), std::invalid_argument);
+    EXPECT_THROW(TaskQuery::Parse("priority > HIGH limit 0"), std::invalid_argument);
+    EXPECT_THROW(TaskQuery::Parse("(status = PENDING"), std::invalid_argument);
+}
+
+// Test TaskSorter
+TEST_F(BusinessLogicTest, TaskSorter_MatchesComparatorSort) {
+    std::vector<TaskPtr> tasks;
+    std::mt19937 rng(11);
+    for (int i = 1; i <= 60000; ++i) {
+        int created = static_cast<int>(rng() % 1000);
+        auto task = MakeTask(static_cast<int>(rng() % 100000), static_cast<Enums::TaskStatus>(rng() % 4),
+                             static_cast<Enums::Priority>(rng() % 4), static_cast<int>(rng() % 20),
+                             created, created + static_cast<int>(rng() % 500) - 100);
+        task->SetTitle("Task " + std::to_string(rng() % 50));
+        tasks.push_back(task);
+    }
+
+    const std::vector<std::vector<QueryOrder>> orders = {
+        TaskSorter::DefaultOrder(),
+        {{QueryField::STATUS, false}, {QueryField::CATEGORY, true}},
+        {{QueryField::DUE, true}, {QueryField::CREATED, false}}, // Needs a 128-bit key
+        {{QueryField::TITLE, false}},                             // Comparator fallback
+    };
+    for (const auto& order : orders) {
+        auto expected = tasks;
+        std::stable_sort(expected.begin(), expected.end(), [&order](const TaskPtr& lhs, const TaskPtr& rhs) {
+            return TaskQuery::Compare(order, *lhs, *rhs) < 0;
+        });
+        for (unsigned threads : {1u, 4u}) {
+            auto sorted = tasks;
+            TaskSorter::Sort(sorted, order, threads);
+            EXPECT_EQ(sorted, expected) << TaskQuery::Describe(order) << " threads=" << threads;
+        }
+    }
+}
+
+// Test keyset pagination
+TEST_F(BusinessLogicTest, QueryEngine_PagesMatchFullListing) {
+    TaskService service;
+    auto engine = std::make_shared<QueryEngine>();
+    service.AddObserver(engine);
+    for (int i = 1; i <= 3000; ++i) {
+        service.AddTask(MakeTask(i, static_cast<Enums::TaskStatus>(i % 4), static_cast<Enums::Priority>(i % 4),
+                                 i % 5, 0, (i * 13) % 700));
+    }
+    auto now = Clock::GetInstance().Now();
+
+    for (const std::string text : {"status != CANCELLED order by due asc limit 97",
+                                   "category in (1, 2) order by priority desc, due asc limit 64",
+                                   "order by title asc limit 500"}) {
+        auto query = TaskQuery::Parse(text);
+        auto full = engine->Execute(TaskQuery::Parse(text.substr(0, text.rfind(" limit"))), now).tasks;
+
+        std::vector<TaskPtr> paged;
+        std::string cursor;
+        size_t pages = 0;
+        do {
+            auto page = engine->ExecutePage(query, cursor, now);
+            EXPECT_LE(page.tasks.size(), query.GetLimit());
+            paged.insert(paged.end(), page.tasks.begin(), page.tasks.end());
+            cursor = page.nextCursor;
+            ++pages;
+        } while (!cursor.empty() && pages < 1000);
+        EXPECT_EQ(paged, full) << text;
+    }
+}
+
+TEST_F(BusinessLogicTest, QueryEngine_CursorSurvivesEdits) {
+    TaskService service;
+    auto engine = std::make_shared<QueryEngine>();
+    service.AddObserver(engine);
+    for (int i = 1; i <= 100; ++i) {
+        service.AddTask(MakeTask(i, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, i));
+    }
+    auto now = Clock::GetInstance().Now();
+    auto query = TaskQuery::Parse("order by due asc limit 10");
+
+    auto first = engine->ExecutePage(query, "", now);
+    ASSERT_EQ(first.tasks.back()->GetId(), 10);
+    service.AddTask(MakeTask(500, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 5));  // Before the cursor
+    service.AddTask(MakeTask(501, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 11)); // After it
+    service.RemoveTask(11);
+
+    auto second = engine->ExecutePage(query, first.nextCursor, now);
+    ASSERT_EQ(second.tasks.size(), 10u);
+    EXPECT_EQ(second.tasks[0]->GetId(), 501);
+    EXPECT_EQ(second.tasks[1]->GetId(), 12);
+
+    EXPECT_THROW(engine->ExecutePage(TaskQuery::Parse("order by due desc limit 10"), first.nextCursor, now),
+                 std::invalid_argument);
+    std::string damaged = first.nextCursor;
+    damaged[4] = damaged[4] == '0' ? '1' : '0';
+    EXPECT_THROW(engine->ExecutePage(query, damaged, now), std::invalid_argument);
+    EXPECT_THROW(engine->ExecutePage(TaskQuery::Parse("order by due asc"), "", now), std::invalid_argument);
+}
+
+// Test AutocompleteIndex
+TEST_F(BusinessLogicTest, AutocompleteIndex_WeightsAndEdits) {
+    TaskService service;
+    auto index = std::make_shared<AutocompleteIndex>();
+    service.AddObserver(index);
+    std::vector<CategoryPtr> categories;
+    for (int id = 1; id <= 3; ++id) {
+        categories.push_back(std::make_shared<Category>("Cat" + std::to_string(id)));
+        categories.back()->SetId(id);
+        index->AddCategory(*categories.back());
+    }
+    auto addTask = [&](int id, const std::string& title, std::vector<std::string> tags) {
+        auto task = MakeTask(id, Enums::TaskStatus::PENDING, Enums::Priority::LOW, id % 2 + 1, 0, 24);
+        task->SetTitle(title);
+        task->SetTags(std::move(tags));
+        service.AddTask(task);
+    };
+    addTask(1, "Release notes", {"release", "docs"});
+    addTask(2, "Release notes", {"release"});
+    addTask(3, "Refactor parser", {"refactor"});
+    addTask(4, "Review PR", {"review", "release"});
+
+    auto titles = index->Complete(CompletionSource::TITLE, "RE", 2);
+    ASSERT_EQ(titles.size(), 2u);
+    EXPECT_EQ(titles[0].text, "Release notes");
+    EXPECT_EQ(titles[0].weight, 2u);
+    EXPECT_EQ(titles[1].text, "Refactor parser"); // Tie with "Review PR", text order
+
+    auto all = index->Complete("c", 5);
+    ASSERT_EQ(all.size(), 3u); // Categories "Cat1", "Cat2" and the empty "Cat3"
+    EXPECT_EQ(all[0].source, CompletionSource::CATEGORY);
+    EXPECT_EQ(all[0].weight, 2u);
+    EXPECT_EQ(all[2].text, "Cat3");
+    EXPECT_EQ(all[2].weight, 0u);
+
+    // A rename moves the weight at once; a removed category is no longer offered
+    categories[0]->SetName("Backlog");
+    index->AddCategory(*categories[0]);
+    index->RemoveCategory(3);
+    auto renamed = index->Complete(CompletionSource::CATEGORY, "", 5);
+    ASSERT_EQ(renamed.size(), 2u);
+    EXPECT_EQ(renamed[0].text, "Backlog");
+    EXPECT_EQ(renamed[0].weight, 2u);
+    EXPECT_EQ(renamed[1].text, "Cat2");
+    EXPECT_TRUE(index->Complete(CompletionSource::CATEGORY, "cat1", 5).empty());
+
+    service.UpdateTask(4, [](Task& task) { task.SetTags({"docs"}); });
+    service.RemoveTask(2);
+    auto tags = index->Complete(CompletionSource::TAG, "re", 5);
+    ASSERT_EQ(tags.size(), 2u);
+    EXPECT_EQ(tags[0].text, "refactor");
+    EXPECT_EQ(tags[1].text, "release");
+    EXPECT_EQ(index->GetTrie(CompletionSource::TAG).GetWeight("DOCS"), 2u);
+    EXPECT_EQ(index->GetTrie(CompletionSource::TITLE).GetWeight("release notes"), 1u);
+}
+
+// Test FuzzySearchIndex
+TEST_F(BusinessLogicTest, FuzzySearchIndex_FindsMisspellings) {
+    TaskService service;
+    auto index = std::make_shared<FuzzySearchIndex>();
+    service.AddObserver(index);
+    const std::vector<std::string> words = {"deploy", "database", "migration", "release", "invoice", "customer",
+                                            "dashboard", "security", "billing", "onboarding"};
+    std::mt19937 rng(21);
+    for (int id = 1; id <= 2000; ++id) {
+        auto task = MakeTask(id, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+        task->SetTitle(words[rng() % words.size()] + " " + words[rng() % words.size()] + " " + std::to_string(id));
+        task->SetTags({words[rng() % words.size()]});
+        service.AddTask(task);
+    }
+
+    for (const std::string pattern : {"migartion", "dashbord", "secruity rel", "invoice customer"}) {
+        auto hits = index->Search(pattern, 2, 5000);
+        std::vector<std::pair<int, int>> expected; // (distance, id)
+        FuzzyMatcher matcher(pattern);
+        for (const auto& task : service.GetAllTasks()) {
+            int best = matcher.Distance(task->GetTitle(), 2);
+            for (const auto& tag : task->GetTags()) {
+                int distance = matcher.Distance(tag, 2);
+                if (distance >= 0 && (best < 0 || distance < best)) {
+                    best = distance;
+                }
+            }
+            if (best >= 0) {
+                expected.emplace_back(best, task->GetId());
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(hits.size(), expected.size()) << pattern;
+        for (size_t i = 0; i < hits.size(); ++i) {
+            EXPECT_EQ(hits[i].distance, expected[i].first);
+            EXPECT_EQ(hits[i].taskId, expected[i].second);
+        }
+    }
+
+    EXPECT_GT(index->Search("migartion", 2).size(), 0u);
+    EXPECT_LT(index->CountCandidates("invoice customer", 2), service.GetTaskCount());
+    EXPECT_LT(index->CountCandidates("migartion", 2), service.GetTaskCount() / 2);
+    EXPECT_LT(index->CountCandidates("dashbord", 1), service.GetTaskCount() / 2);
+    EXPECT_EQ(index->CountCandidates("dashbord", 2), service.GetTaskCount()); // Shorter than 3 * Q
+    service.UpdateTask(1, [](Task& task) { task.SetTitle("zebra crossing"); task.SetTags({}); });
+    auto hits = index->Search("zebra crosing", 1);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].taskId, 1);
+    EXPECT_EQ(hits[0].match, "zebra crossing");
+}
+
+TEST_F(BusinessLogicTest, FuzzySearchIndex_FiltersLargeCorpus) {
+    TaskService service;
+    auto index = std::make_shared<FuzzySearchIndex>();
+    service.AddObserver(index);
+    const std::vector<std::string> words = {
+        "deploy", "database", "migration", "release", "invoice", "customer", "dashboard", "security",
+        "billing", "onboarding", "review", "update", "report", "backend", "frontend", "payment",
+        "schema", "cluster", "backup", "monitoring", "alert", "service", "account", "profile",
+        "search", "index", "cache", "latency", "storage", "network", "config", "upgrade",
+        "refactor", "document", "testing", "staging", "production", "rollback", "feature", "support",
+        "contract", "vendor", "meeting", "planning", "budget", "hiring", "design", "mobile"};
+    std::mt19937 rng(48);
+    const int taskCount = 20000;
+    for (int id = 1; id <= taskCount; ++id) {
+        auto task = MakeTask(id, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+        std::string title = words[rng() % words.size()];
+        for (size_t n = 2 + rng() % 3; n > 0; --n) {
+            title += " " + words[rng() % words.size()];
+        }
+        task->SetTitle(title);
+        task->SetTags({words[rng() % words.size()], words[rng() % words.size()]});
+        service.AddTask(task);
+    }
+
+    const std::vector<std::pair<std::string, int>> queries = {
+        {"migartion", 1}, {"dashbord", 1}, {"rollbak", 1}, {"securty alert", 2}, {"payment vendr", 2}};
+    for (const auto& [pattern, maxErrors] : queries) {
+        size_t candidates = index->CountCandidates(pattern, maxErrors);
+        EXPECT_LT(candidates, static_cast<size_t>(taskCount / 4)) << pattern;
+
+        std::vector<std::pair<int, int>> expected; // (distance, id)
+        FuzzyMatcher matcher(pattern);
+        for (const auto& task : service.GetAllTasks()) {
+            int best = matcher.Distance(task->GetTitle(), maxErrors);
+            for (const auto& tag : task->GetTags()) {
+                int distance = matcher.Distance(tag, maxErrors);
+                if (distance >= 0 && (best < 0 || distance < best)) {
+                    best = distance;
+                }
+            }
+            if (best >= 0) {
+                expected.emplace_back(best, task->GetId());
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_GE(candidates, expected.size()) << pattern;
+        auto hits = index->Search(pattern, maxErrors, taskCount);
+        ASSERT_EQ(hits.size(), expected.size()) << pattern;
+        for (size_t i = 0; i < hits.size(); ++i) {
+            EXPECT_EQ(hits[i].distance, expected[i].first);
+            EXPECT_EQ(hits[i].taskId, expected[i].second);
+        }
+    }
+}
+
+// Test DuplicateDetector
+TEST_F(BusinessLogicTest, DuplicateDetector_ClustersNearDuplicates) {
+    std::mt19937 rng(33);
+    auto randomWords = [&rng](size_t count) {
+        std::vector<std::string> words;
+        for (size_t i = 0; i < count; ++i) {
+            std::string word;
+            for (size_t j = 0; j < 4 + rng() % 5; ++j) {
+                word += static_cast<char>('a' + rng() % 26);
+            }
+            words.push_back(word);
+        }
+        return words;
+    };
+    auto join = [](const std::vector<std::string>& words) {
+        return StringUtils::Join(words, " ");
+    };
+
+    TaskService service;
+    auto detector = std::make_shared<DuplicateDetector>();
+    service.AddObserver(detector);
+    std::vector<std::pair<int, int>> copies; // (original, near copy)
+    std::vector<TaskPtr> all;
+    int nextId = 1;
+    for (int i = 0; i < 300; ++i) {
+        auto title = randomWords(4);
+        auto description = randomWords(30);
+        auto task = MakeTask(nextId++, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+        task->SetTitle(join(title));
+        task->SetDescription(join(description));
+        all.push_back(service.AddTask(task));
+
+        if (i % 10 == 0) {
+            // Imported copy: different case and punctuation, one word changed
+            description[rng() % description.size()] = "changed";
+            auto copy = MakeTask(nextId++, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+            copy->SetTitle(StringUtils::ToUpper(join(title)) + "!");
+            copy->SetDescription(join(description));
+            all.push_back(service.AddTask(copy));
+            copies.emplace_back(task->GetId(), copy->GetId());
+        }
+    }
+
+    auto clusters = detector->FindDuplicates();
+    ASSERT_EQ(clusters.size(), copies.size());
+    for (const auto& [original, copy] : copies) {
+        EXPECT_NE(std::find(clusters.begin(), clusters.end(), std::vector<int>{original, copy}), clusters.end());
+    }
+
+    // Check before insert, and a batch build over the same tasks
+    auto candidate = MakeTask(9999, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+    candidate->SetTitle(service.GetTask(copies[0].first)->GetTitle());
+    candidate->SetDescription(service.GetTask(copies[0].first)->GetDescription());
+    auto similar = detector->FindSimilar(*candidate);
+    ASSERT_GE(similar.size(), 1u);
+    EXPECT_EQ(similar[0].taskId, copies[0].first);
+    EXPECT_DOUBLE_EQ(similar[0].similarity, 1.0);
+
+    DuplicateDetector batch;
+    batch.Build(all, 2);
+    EXPECT_EQ(batch.FindDuplicates(), clusters);
+
+    service.RemoveTask(copies[0].second);
+    EXPECT_EQ(detector->FindDuplicates().size(), copies.size() - 1);
+}
+
+TEST_F(BusinessLogicTest, DuplicateDetector_GroupsMatchAllPairs) {
+    // Chains of drafts, each one word away from the previous, so group
+    // members are linked through pairs that are not all mutually similar
+    std::mt19937 rng(49);
+    auto randomWord = [&rng] {
+        std::string word;
+        for (size_t j = 0; j < 4 + rng() % 5; ++j) {
+            word += static_cast<char>('a' + rng() % 26);
+        }
+        return word;
+    };
+
+    std::vector<TaskPtr> tasks;
+    int nextId = 1;
+    for (int chain = 0; chain < 40; ++chain) {
+        std::vector<std::string> words;
+        for (int i = 0; i < 20; ++i) {
+            words.push_back(randomWord());
+        }
+        for (int step = 0; step < 8; ++step) {
+            words[rng() % words.size()] = randomWord();
+            auto task = MakeTask(nextId++, Enums::TaskStatus::PENDING, Enums::Priority::LOW, 1, 0, 24);
+            task->SetTitle(StringUtils::Join(words, " "));
+            tasks.push_back(task);
+        }
+    }
+    // Bucket order then differs from chain order
+    std::shuffle(tasks.begin(), tasks.end(), rng);
+
+    DuplicateDetector detector;
+    std::vector<int> ids;
+    std::vector<DuplicateDetector::Signature> signatures(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        detector.OnTaskAdded(tasks[i]);
+        ids.push_back(tasks[i]->GetId());
+        ASSERT_TRUE(DuplicateDetector::ComputeSignature(*tasks[i], signatures[i]));
+    }
+
+    // At 0.8 at most 12 of 64 values differ, so similar pairs always share a band
+    const double threshold = 0.8;
+    std::vector<size_t> parent(ids.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](size_t i) {
+        while (parent[i] != i) {
+            i = parent[i];
+        }
+        return i;
+    };
+    for (size_t i = 0; i < ids.size(); ++i) {
+        for (size_t j = i + 1; j < ids.size(); ++j) {
+            if (DuplicateDetector::Similarity(signatures[i], signatures[j]) >= threshold) {
+                parent[find(i)] = find(j);
+            }
+        }
+    }
+    std::map<size_t, std::vector<int>> groups;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        groups[find(i)].push_back(ids[i]);
+    }
+    std::set<std::vector<int>> expected;
+    for (auto& [root, members] : groups) {
+        if (members.size() > 1) {
+            std::sort(members.begin(), members.end());
+            expected.insert(members);
+        }
+    }
+
+    auto clusters = detector.FindDuplicates(threshold);
+    EXPECT_EQ(std::set<std::vector<int>>(clusters.begin(), clusters.end()), expected);
+    EXPECT_EQ(clusters.size(), expected.size());
+}
+
+// Test MaterializedViews
+TEST_F(BusinessLogicTest, MaterializedViews_MatchQueriesThroughChanges) {
+    TaskService service;
+    auto views = std::make_shared<MaterializedViews>(base_);
+    views->DefineDefaultViews();
+    service.AddObserver(views);
+    for (int i = 1; i <= 2000; ++i) {
+        auto task = MakeTask(i, static_cast<Enums::TaskStatus>(i % 4), static_cast<Enums::Priority>((i / 3) % 4),
+                             i % 9, -(i % 200), (i * 37) % 400 - 100, 1);
+        task->SetTitle("Task " + std::to_string(i % 97));
+        service.AddTask(task);
+    }
+    const std::map<std::string, std::string> definitions = {
+        {"overdue", "status in (PENDING, IN_PROGRESS) and due < now order by due asc"},
+        {"today", "status in (PENDING, IN_PROGRESS) and due >= today and due < today+1d order by priority desc, due asc"},
+        {"upcoming", "status in (PENDING, IN_PROGRESS) and due >= today+1d and due < today+8d order by due asc"},
+        {"recent", "created > now-50h and priority >= MEDIUM order by title asc, due desc"}
+    };
+    views->DefineView("recent", definitions.at("recent"));
+    service.RemoveTask(70);
+    service.UpdateTask(71, [this](Task& task) { task.SetDueDate(base_ + hours(30)); });
+    service.UpdateTask(72, [](Task& task) { task.SetStatus(Enums::TaskStatus::CANCELLED); });
+    service.UpdateTask(73, [](Task& task) { task.SetTitle("Aardvark"); });
+
+    auto check = [&]() {
+        auto now = views->GetNow();
+        for (const auto& name : views->GetViewNames()) {
+            std::vector<ConstTaskPtr> paged;
+            std::string cursor;
+            do {
+                auto page = views->GetPage(name, cursor, 37);
+                paged.insert(paged.end(), page.tasks.begin(), page.tasks.end());
+                cursor = page.nextCursor;
+            } while (!cursor.empty());
+
+            TaskQuery query = TaskQuery::Parse(definitions.at(name));
+            std::vector<ConstTaskPtr> expected;
+            for (const auto& task : service.GetAllTasks()) {
+                if (TaskQuery::Matches(query.GetFilter(), *task, now)) {
+                    expected.push_back(task);
+                }
+            }
+            std::sort(expected.begin(), expected.end(), [&query](const ConstTaskPtr& lhs, const ConstTaskPtr& rhs) {
+                return TaskQuery::Compare(query.GetOrder(), *lhs, *rhs) < 0;
+            });
+            EXPECT_EQ(paged, expected) << name;
+            EXPECT_EQ(views->GetCount(name), expected.size()) << name;
+        }
+    };
+    check();
+
+    // Step across the overdue boundary and local midnight
+    for (int step = 1; step <= 6; ++step) {
+        views->Refresh(base_ + hours(7 * step) + minutes(13));
+        check();
+    }
+    EXPECT_GE(views->Refresh(base_ + hours(43)), service.GetAllTasks().size()); // "recent" has a created bound and is rescanned
+    check();
+    views->DropView("recent");
+    EXPECT_LT(views->Refresh(base_ + hours(44)), 200u); // Due bounds re-check only tasks they crossed
+    check();
+}
+
+TEST_F(BusinessLogicTest, MaterializedViews_RefreshAndErrors) {
+    TaskService service;
+    auto views = std::make_shared<MaterializedViews>(base_);
+    service.AddObserver(views);
+    for (const auto& task : SampleTasks()) {
+        service.AddTask(task);
+    }
+    views->DefineDefaultViews();
+
+    auto ids = [&views](const std::string& name) {
+        std::vector<int> result;
+        for (const auto& task : views->GetPage(name, "", 10).tasks) {
+            result.push_back(task->GetId());
+        }
+        return result;
+    };
+    EXPECT_TRUE(ids("overdue").empty());
+    EXPECT_EQ(ids("today"), std::vector<int>({4}));   // Due 20:00
+    EXPECT_EQ(ids("upcoming"), std::vector<int>({3})); // Due tomorrow 08:00
+
+    // The earliest crossing is a due date passing the "now" bound
+    auto next = views->NextRefreshTime();
+    EXPECT_GT(next, base_);
+    EXPECT_LE(next, base_ + hours(12) + system_clock::duration(1));
+
+    views->Refresh(base_ + hours(12) + seconds(1));
+    EXPECT_EQ(ids("overdue"), std::vector<int>({4}));
+    views->Refresh(base_ + hours(17)); // 01:00 the next day
+    EXPECT_EQ(ids("today"), std::vector<int>({3}));
+    EXPECT_TRUE(ids("upcoming").empty());
+
+    service.UpdateTask(4, [](Task& task) { task.SetStatus(Enums::TaskStatus::COMPLETED); });
+    EXPECT_EQ(views->GetCount("overdue"), 0u);
+
+    auto first = views->GetPage("today", "", 1);
+    EXPECT_TRUE(first.nextCursor.empty());
+    EXPECT_THROW(views->DefineView("today", "status = PENDING"), std::invalid_argument);
+    EXPECT_THROW(views->DefineView("top", "status = PENDING limit 5"), std::invalid_argument);
+    EXPECT_THROW(views->DefineView("tags", "order by tag asc"), std::invalid_argument);
+    EXPECT_THROW(views->GetPage("missing", "", 5), std::invalid_argument);
+    EXPECT_THROW(views->GetPage("today", "zz", 5), std::invalid_argument);
+    EXPECT_TRUE(views->DropView("today"));
+    EXPECT_FALSE(views->HasView("today"));
+}
+
+TEST_F(BusinessLogicTest, TaskQuery_ResolvesTimesOnce) {
+    auto query = TaskQuery::Parse("due >= today and due < today+1d or created > now-2d or completed <= today-30h");
+    QueryTimes times(query.GetFilter(), base_);
+
+    // Whole days step the local calendar, the rest is plain seconds
+    const auto& children = query.GetFilter().children;
+    const QueryTime& tomorrow = children[0].children[1].predicate.time;
+    EXPECT_EQ(times.Get(tomorrow), DateUtils::AddCalendarDays(DateUtils::StartOfDay(base_), 1));
+    EXPECT_EQ(times.Get(tomorrow), tomorrow.Resolve(base_));
+    EXPECT_EQ(times.Get(children[2].predicate.time),
+              DateUtils::AddCalendarDays(DateUtils::StartOfDay(base_), -1) - hours(6));
+
+    for (const auto& task : SampleTasks()) {
+        EXPECT_EQ(TaskQuery::Matches(query.GetFilter(), *task, times),
+                  TaskQuery::Matches(query.GetFilter(), *task, base_)) << task->GetId();
+    }
+}
+
+// Main for running tests
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -131,6 +131,16 @@ TEST_F(DataManagerTest, JSONDataManager_SaveAndLoadCategories) {
     EXPECT_EQ(loadedCategories[0]->GetColor(), "#FF0000");
 }
 
+TEST_F(DataManagerTest, JSONDataManager_FingerprintSurvivesRoundTrip) {
+    JSONDataManager manager(testFolder_);
+    std::vector<CategoryPtr> categories = {CreateSampleCategory(4)};
+
+    EXPECT_TRUE(manager.SaveCategories(categories));
+    auto loadedCategories = manager.LoadCategories();
+    ASSERT_EQ(loadedCategories.size(), 1u);
+    EXPECT_EQ(loadedCategories[0]->GetFingerprint(), categories[0]->GetFingerprint());
+}
+
 TEST_F(DataManagerTest, JSONDataManager_InvalidFolder) {
     EXPECT_THROW(JSONDataManager("/invalid/path/"), std::runtime_error);
 }
@@ -156,6 +166,109 @@ TEST_F(DataManagerTest, CSVDataManager_SaveAndLoadTasks) {
     EXPECT_EQ(loadedTasks[0]->GetTitle(), "Test Task");
     EXPECT_EQ(loadedTasks[0]->GetPriority(), Enums::Priority::HIGH);
     // Add more checks based on what CSV serializes
+
+    // Identical recurrence patterns are shared after loading
+    ASSERT_TRUE(loadedTasks[0]->IsRecurring());
+    EXPECT_EQ(loadedTasks[0]->GetRecurrencePattern(), loadedTasks[1]->GetRecurrencePattern());
+}
+
+TEST_F(DataManagerTest, CSVDataManager_LoadRestoresPersistedFields) {
+    CSVDataManager manager(testFolder_);
+
+    TaskFields fields;
+    fields.id = 5;
+    fields.title = "Past due";
+    fields.createdAt = DateUtils::StringToTimePoint("2024-03-01 09:00:00");
+    fields.updatedAt = fields.createdAt;
+    fields.dueDate = DateUtils::StringToTimePoint("2024-03-02 09:00:00");
+    fields.status = Enums::TaskStatus::COMPLETED;
+    fields.completedAt = DateUtils::StringToTimePoint("2024-03-01 17:00:00");
+    fields.category = CreateSampleCategory(3);
+    auto task = std::make_shared<Task>(std::move(fields));
+
+    EXPECT_TRUE(manager.SaveTasks({task}));
+    auto loadedTasks = manager.LoadTasks();
+    ASSERT_EQ(loadedTasks.size(), 1u);
+
+    EXPECT_EQ(loadedTasks[0]->GetCreatedAt(), task->GetCreatedAt());
+    EXPECT_EQ(loadedTasks[0]->GetCompletedAt(), task->GetCompletedAt());
+    EXPECT_EQ(loadedTasks[0]->GetDueDate(), task->GetDueDate());
+    ASSERT_TRUE(loadedTasks[0]->HasCategory());
+    EXPECT_EQ(loadedTasks[0]->GetCategory()->GetId(), 3);
+}
+
+TEST_F(DataManagerTest, CSVDataManager_TracksChangesSinceSave) {
+    CSVDataManager manager(testFolder_);
+    std::vector<TaskPtr> tasks = {CreateSampleTask(1), CreateSampleTask(2), CreateSampleTask(3)};
+    std::vector<CategoryPtr> categories = {CreateSampleCategory(1), CreateSampleCategory(2)};
+    EXPECT_EQ(manager.GetLastSavedVersion(), 0u);
+
+    EXPECT_TRUE(manager.SaveTasks(tasks));
+    EXPECT_TRUE(manager.SaveCategories(categories));
+    for (const auto& task : tasks) {
+        EXPECT_FALSE(task->IsDirty());
+    }
+    EXPECT_TRUE(manager.GetTasksChangedSince(manager.GetLastSavedVersion()).empty());
+
+    // Plain setter calls reach the log; edits to a copy do not
+    tasks[1]->SetPriority(Enums::Priority::LOW);
+    Task copy = *tasks[0];
+    copy.SetTitle("Copy");
+    categories[1]->SetName("Renamed");
+    manager.RecordTaskRemoval(3);
+    auto changed = manager.GetTasksChangedSince(manager.GetLastSavedVersion());
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0]->GetId(), 2);
+    EXPECT_EQ(manager.GetTasksRemovedSince(manager.GetLastSavedVersion()), std::vector<int>({3}));
+    auto changedCategories = manager.GetCategoriesChangedSince(manager.GetLastSavedCategoryVersion());
+    ASSERT_EQ(changedCategories.size(), 1u);
+    EXPECT_EQ(changedCategories[0]->GetId(), 2);
+
+    // A removed task is no longer followed
+    tasks[2]->SetTitle("Gone");
+    EXPECT_EQ(manager.GetTasksChangedSince(manager.GetLastSavedVersion()).size(), 1u);
+
+    auto loadedTasks = manager.LoadTasks();
+    ASSERT_EQ(loadedTasks.size(), 3u);
+    EXPECT_FALSE(loadedTasks[0]->IsDirty());
+    EXPECT_TRUE(manager.GetTasksRemovedSince(0).empty());
+    loadedTasks[0]->SetTitle("Edited after load");
+    changed = manager.GetTasksChangedSince(manager.GetLastSavedVersion());
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], loadedTasks[0]);
+}
+
+TEST_F(DataManagerTest, CSVDataManager_FingerprintSurvivesRoundTrip) {
+    CSVDataManager manager(testFolder_);
+    std::vector<TaskPtr> tasks = {CreateSampleTask(1)};
+    std::vector<CategoryPtr> categories = {CreateSampleCategory(1)};
+
+    EXPECT_TRUE(manager.SaveTasks(tasks));
+    EXPECT_TRUE(manager.SaveCategories(categories));
+
+    auto loadedTasks = manager.LoadTasks();
+    auto loadedCategories = manager.LoadCategories();
+    ASSERT_EQ(loadedTasks.size(), 1u);
+    ASSERT_EQ(loadedCategories.size(), 1u);
+    EXPECT_EQ(loadedTasks[0]->GetFingerprint(), tasks[0]->GetFingerprint());
+    EXPECT_EQ(loadedCategories[0]->GetFingerprint(), categories[0]->GetFingerprint());
+}
+
+TEST_F(DataManagerTest, FingerprintSurvivesReopenedTask) {
+    JSONDataManager json(testFolder_);
+    CSVDataManager csv(testFolder_);
+    std::vector<ITaskRepository*> managers = {&json, &csv};
+    for (ITaskRepository* manager : managers) {
+        std::vector<TaskPtr> tasks = {CreateSampleTask(1)};
+        tasks[0]->SetStatus(Enums::TaskStatus::COMPLETED);
+        tasks[0]->SetStatus(Enums::TaskStatus::PENDING);
+
+        EXPECT_TRUE(manager->SaveTasks(tasks));
+        auto loadedTasks = manager->LoadTasks();
+        ASSERT_EQ(loadedTasks.size(), 1u);
+        EXPECT_EQ(loadedTasks[0]->GetStatus(), Enums::TaskStatus::PENDING);
+        EXPECT_EQ(loadedTasks[0]->GetFingerprint(), tasks[0]->GetFingerprint());
+    }
 }
 
 TEST_F(DataManagerTest, CSVDataManager_SaveAndLoadCategories) {
@@ -1,16 +1,19 @@
 #include <gtest/gtest.h>
 #include "../../src/LIB/StringUtils.h"
 #include "../../src/LIB/DateUtils.h"
+#include "../../src/LIB/Clock.h"
 #include "../../src/LIB/InputValidator.h"
 #include "../../src/DTO/Task.h"
 #include "../../src/DTO/Category.h"
 #include "../../src/DTO/RecurrencePattern.h"
+#include "../../src/DTO/RecurrencePatternRegistry.h"
 #include "../../src/DTO/Enums.h"
 #include "../../src/LIB/IdGenerator.h"
 #include "../../src/LIB/Logger.h"
 #include "../../src/DTO/ProductivityReport.h"
 #include "../../src/LIB/common.h"
-#include "../../src/LIB/Constants.h"  
+#include "../../src/LIB/Constants.h"
+#include <algorithm>  
 // Test fixture for common setup
 class TaskManagerTest : public ::testing::Test {
 protected:
@@ -127,6 +130,11 @@ TEST_F(TaskManagerTest, Category_Setters) {
     EXPECT_THROW(cat.SetName(""), std::invalid_argument);
     EXPECT_THROW(cat.SetColor(""), std::invalid_argument);
     EXPECT_THROW(cat.SetId(-1), std::invalid_argument);
+
+    auto reference = Category::Reference(7);
+    EXPECT_EQ(reference->GetId(), 7);
+    EXPECT_FALSE(reference->GetName().empty());
+    EXPECT_FALSE(reference->IsDirty());
 }
 
 // Test RecurrencePattern
@@ -156,6 +164,50 @@ TEST_F(TaskManagerTest, RecurrencePattern_Setters) {
     EXPECT_THROW(rec.SetOccurrenceCount(-1), std::invalid_argument);
 }
 
+TEST_F(TaskManagerTest, RecurrencePatternRegistry_Interning) {
+    auto& registry = RecurrencePatternRegistry::GetInstance();
+    RecurrencePattern daily(Enums::RecurrenceType::DAILY, 1);
+    RecurrencePattern weekly(Enums::RecurrenceType::WEEKLY, 1, {Enums::DayOfWeek::MONDAY});
+
+    auto first = registry.Intern(daily);
+    auto second = registry.Intern(RecurrencePattern(Enums::RecurrenceType::DAILY, 1));
+    auto third = registry.Intern(weekly);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, third);
+    EXPECT_TRUE(first->IsInterned());
+    EXPECT_FALSE(daily.IsInterned());
+    EXPECT_THROW(first->SetInterval(2), std::logic_error);
+
+    // A value copy is a private pattern
+    RecurrencePattern copy = *first;
+    EXPECT_FALSE(copy.IsInterned());
+    EXPECT_NO_THROW(copy.SetInterval(2));
+
+    // Patterns nobody references are released
+    size_t live = registry.Size();
+    auto monthly = registry.Intern(RecurrencePattern(Enums::RecurrenceType::MONTHLY, 5));
+    EXPECT_EQ(registry.Size(), live + 1);
+    monthly.reset();
+    EXPECT_EQ(registry.Size(), live);
+}
+
+TEST_F(TaskManagerTest, Task_EditRecurrencePatternCopyOnWrite) {
+    auto shared = RecurrencePatternRegistry::GetInstance().Intern(
+        RecurrencePattern(Enums::RecurrenceType::DAILY, 1));
+    Task first;
+    Task second;
+    first.SetRecurrencePattern(shared);
+    second.SetRecurrencePattern(shared);
+
+    first.EditRecurrencePattern()->SetInterval(3);
+
+    EXPECT_EQ(first.GetRecurrencePattern()->GetInterval(), 3);
+    EXPECT_FALSE(first.GetRecurrencePattern()->IsInterned());
+    EXPECT_EQ(second.GetRecurrencePattern(), shared);
+    EXPECT_EQ(shared->GetInterval(), 1);
+}
+
 // Test Task
 TEST_F(TaskManagerTest, Task_ConstructionAndGetters) {
     auto dueDate = DateUtils::AddDays(DateUtils::Now(), 1);
@@ -184,6 +236,132 @@ TEST_F(TaskManagerTest, Task_Setters) {
     EXPECT_NE(task.GetCompletedAt(), std::chrono::system_clock::time_point::min());
 }
 
+TEST_F(TaskManagerTest, Task_TimestampsFromClock) {
+    auto fixed = DateUtils::StringToTimePoint("2025-05-05 12:00:00");
+    ScopedFixedClock scope(fixed);
+
+    Task task;
+    Category cat("Work");
+    EXPECT_EQ(task.GetCreatedAt(), fixed);
+    EXPECT_EQ(task.GetUpdatedAt(), fixed);
+    EXPECT_EQ(cat.GetCreatedAt(), fixed);
+
+    Clock::GetInstance().Advance(std::chrono::minutes(30));
+    task.SetStatus(Enums::TaskStatus::COMPLETED);
+    EXPECT_EQ(task.GetCompletedAt(), fixed + std::chrono::minutes(30));
+}
+
+TEST_F(TaskManagerTest, Task_TimestampsFromInjectedClock) {
+    auto fixed = DateUtils::StringToTimePoint("2025-05-05 12:00:00");
+    Clock clock(fixed);
+
+    Task task("Injected", "", fixed + std::chrono::hours(1), Enums::Priority::LOW, nullptr, clock);
+    Category cat("Work", "", "#000000", clock);
+    EXPECT_EQ(task.GetCreatedAt(), fixed);
+    EXPECT_EQ(cat.GetCreatedAt(), fixed);
+    EXPECT_EQ(Clock::GetInstance().GetMode(), ClockMode::SYSTEM); // The default clock is untouched
+
+    clock.Advance(std::chrono::minutes(10));
+    task.SetStatus(Enums::TaskStatus::COMPLETED, clock);
+    task.UpdateTimestamp(clock);
+    EXPECT_EQ(task.GetCompletedAt(), fixed + std::chrono::minutes(10));
+    EXPECT_EQ(task.GetUpdatedAt(), fixed + std::chrono::minutes(10));
+}
+
+TEST_F(TaskManagerTest, Task_ConstructFromFields) {
+    TaskFields fields;
+    fields.id = 7;
+    fields.title = "Imported";
+    fields.createdAt = DateUtils::StringToTimePoint("2025-01-01 08:00:00");
+    fields.updatedAt = fields.createdAt;
+    fields.dueDate = DateUtils::AddDays(fields.createdAt, 3);
+    fields.status = Enums::TaskStatus::COMPLETED;
+    fields.completedAt = DateUtils::AddDays(fields.createdAt, 1);
+    fields.tags = {"a", "b"};
+
+    Task task(std::move(fields));
+    EXPECT_EQ(task.GetId(), 7);
+    EXPECT_EQ(task.GetTitle(), "Imported");
+    EXPECT_EQ(task.GetCreatedAt(), DateUtils::StringToTimePoint("2025-01-01 08:00:00"));
+    EXPECT_EQ(task.GetStatus(), Enums::TaskStatus::COMPLETED);
+    EXPECT_EQ(task.GetTags().size(), 2u);
+
+    TaskFields invalid;
+    EXPECT_THROW(Task(std::move(invalid)), std::invalid_argument);
+}
+
+TEST_F(TaskManagerTest, Task_MoveSetters) {
+    Task task;
+    std::string title(64, 'x');
+    const char* buffer = title.data();
+    task.SetTitle(std::move(title));
+    EXPECT_EQ(task.GetTitle().data(), buffer);
+    EXPECT_THROW(task.SetTitle(std::string()), std::invalid_argument);
+
+    std::vector<std::string> tags = {"one", "two"};
+    task.SetTags(std::move(tags));
+    task.AddTag(std::string("three"));
+    EXPECT_EQ(task.GetTags().size(), 3u);
+}
+
+TEST_F(TaskManagerTest, Task_ChangeTracking) {
+    Task task;
+    EXPECT_TRUE(task.IsDirty());
+    task.MarkClean();
+    EXPECT_FALSE(task.IsDirty());
+
+    uint64_t before = task.GetVersion();
+    task.SetTitle("Changed");
+    EXPECT_TRUE(task.IsDirty());
+    EXPECT_GT(task.GetVersion(), before);
+
+    task.MarkClean();
+    before = task.GetVersion();
+    task.AddTag("x");
+    task.AddTag("x");  // No-op, version must not move again
+    uint64_t afterAdd = task.GetVersion();
+    EXPECT_GT(afterAdd, before);
+    task.RemoveTag("missing");
+    task.SetTitle("Changed");
+    task.SetPriority(task.GetPriority());
+    task.SetStatus(task.GetStatus());
+    EXPECT_EQ(task.GetVersion(), afterAdd); // Setting the current value is not a change
+
+    Category cat("Work");
+    uint64_t catVersion = cat.GetVersion();
+    cat.SetColor("#FFFFFF");
+    EXPECT_GT(cat.GetVersion(), catVersion);
+    EXPECT_LE(cat.GetVersion(), IdGenerator::GetInstance().GetCurrentVersion());
+}
+
+TEST_F(TaskManagerTest, Task_Fingerprint) {
+    auto due = DateUtils::AddDays(DateUtils::Now(), 1);
+    Task first("Same", "Body", due);
+    first.SetId(1);
+    Task second(first);
+    EXPECT_EQ(first.GetFingerprint(), second.GetFingerprint());
+
+    second.SetTitle("Different");
+    EXPECT_NE(first.GetFingerprint(), second.GetFingerprint());
+
+    // updatedAt is bookkeeping, not content
+    uint64_t before = first.GetFingerprint();
+    first.UpdateTimestamp();
+    EXPECT_EQ(first.GetFingerprint(), before);
+
+    // Edits through shared pointers do not move the task's version
+    auto category = std::make_shared<Category>("Work");
+    auto pattern = std::make_shared<RecurrencePattern>(Enums::RecurrenceType::DAILY, 1);
+    first.SetCategory(category);
+    first.SetRecurrencePattern(pattern);
+    before = first.GetFingerprint();
+    category->SetId(9);
+    EXPECT_NE(first.GetFingerprint(), before);
+    before = first.GetFingerprint();
+    pattern->SetInterval(2);
+    EXPECT_NE(first.GetFingerprint(), before);
+}
+
 TEST_F(TaskManagerTest, Task_Tags) {
     Task task;
     task.AddTag("tag1");
@@ -244,6 +422,37 @@ TEST_F(TaskManagerTest, ProductivityReport_EmptyReports) {
     EXPECT_TRUE(detailed.find("Performance:") == std::string::npos);
 }
 
+TEST_F(TaskManagerTest, ProductivityReport_RenderFormats) {
+    auto start = DateUtils::StringToTimePoint("2025-12-01 00:00:00");
+    ProductivityReport report(start, DateUtils::AddDays(start, 7));
+    ProductivityStats stats;
+    stats.totalTasks = 4;
+    stats.completedTasks = 3;
+    stats.completionRate = 0.75;
+    stats.tasksByPriority[Enums::Priority::HIGH] = 4;
+    report.SetOverallStats(stats);
+    report.SetCategoryStats({{12, stats}});
+
+    // Rendering appends to the caller's buffer
+    TextBuffer buffer;
+    report.Render(ReportFormat::SUMMARY, buffer);
+    EXPECT_EQ(buffer.View(), report.GenerateSummaryReport());
+    buffer.Clear();
+    report.Render(ReportFormat::DETAILED, buffer);
+    EXPECT_EQ(buffer.View(), report.GenerateDetailedReport());
+    EXPECT_NE(buffer.View().find("CATEGORY ID: 12\n-----------------\n"), std::string::npos);
+
+    buffer.Clear();
+    report.RenderJson(buffer);
+    EXPECT_NE(buffer.View().find("\"startDate\":\"2025-12-01 00:00:00\""), std::string::npos);
+    EXPECT_NE(buffer.View().find("\"categories\":[{\"categoryId\":12,"), std::string::npos);
+    EXPECT_NE(buffer.View().find("\"tasksByPriority\":{\"HIGH\":4}"), std::string::npos);
+
+    buffer.Clear();
+    report.RenderCsv(buffer);
+    EXPECT_EQ(std::count(buffer.View().begin(), buffer.View().end(), '\n'), 2); // Overall + one category
+}
+
 // Test IdGenerator
 TEST_F(TaskManagerTest, IdGenerator_UniqueIds) {
     int id1 = IdGenerator::GetInstance().GenerateTaskId();
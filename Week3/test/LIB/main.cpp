@@ -4,6 +4,26 @@
 #include "../../src/LIB/StringUtils.h"  // Assuming relative path based on provided documents
 #include "../../src/LIB/InputValidator.h"  // Assuming relative path
 #include "../../src/LIB/DateUtils.h"  // Assuming relative path
+#include "../../src/LIB/Clock.h"
+#include "../../src/LIB/HashUtils.h"
+#include "../../src/LIB/Bitmap.h"
+#include "../../src/LIB/TextBuffer.h"
+#include "../../src/LIB/Varint.h"
+#include "../../src/LIB/UtcOffsetTable.h"
+#include "../../src/LIB/RoaringBitmap.h"
+#include "../../src/LIB/CompletionTrie.h"
+#include "../../src/LIB/FuzzyMatcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
 #include "../../src/DTO/Enums.h"  // Assuming Enums.h is available for DayOfWeek
 #include "../../src/LIB/Constants.h"  // Assuming Constants.h is available
 // Test fixture for shared setup if needed
@@ -223,6 +243,14 @@ TEST(DateUtilsTest, IsSameDay) {
     EXPECT_FALSE(DateUtils::IsSameDay(tp1, tp3));
 }
 
+TEST(DateUtilsTest, StartOfDay) {
+    auto midnight = DateUtils::StringToTimePoint("2023-10-01 00:00:00");
+    EXPECT_EQ(DateUtils::StartOfDay(DateUtils::StringToTimePoint("2023-10-01 17:45:12")), midnight);
+    EXPECT_EQ(DateUtils::StartOfDay(midnight), midnight);
+    EXPECT_EQ(DateUtils::StartOfDay(midnight - std::chrono::seconds(1)),
+              DateUtils::StringToTimePoint("2023-09-30 00:00:00"));
+}
+
 TEST(DateUtilsTest, AddDays) {
     auto tp = DateUtils::StringToTimePoint("2023-10-01 12:00:00");
     auto added = DateUtils::AddDays(tp, 1);
@@ -237,6 +265,359 @@ TEST(DateUtilsTest, DaysBetween) {
     EXPECT_EQ(DateUtils::DaysBetween(to, from), -2);  // Negative if from > to
 }
 
+TEST(DateUtilsTest, TryParseMatchesStringToTimePoint) {
+    for (const char* text : {"2025-03-01 08:00:00", "2025-03-01 23:59:59", "2024-07-15 12:30:05", "2025-03-02 00:00:01"}) {
+        std::chrono::system_clock::time_point parsed;
+        ASSERT_TRUE(DateUtils::TryParseTimePoint(text, parsed));
+        EXPECT_EQ(parsed, DateUtils::StringToTimePoint(text));
+    }
+    std::chrono::system_clock::time_point parsed;
+    EXPECT_FALSE(DateUtils::TryParseTimePoint("2025-3-01 08:00:00", parsed));
+    EXPECT_FALSE(DateUtils::TryParseTimePoint("not a date", parsed));
+}
+
+// Tests for Clock
+TEST(ClockTest, FixedModeAndAdvance) {
+    auto fixed = DateUtils::StringToTimePoint("2024-06-01 10:00:00");
+    {
+        ScopedFixedClock scope(fixed);
+        EXPECT_EQ(Clock::GetInstance().GetMode(), ClockMode::FIXED);
+        EXPECT_EQ(DateUtils::Now(), fixed);
+
+        Clock::GetInstance().Advance(std::chrono::hours(2));
+        EXPECT_EQ(DateUtils::Now(), fixed + std::chrono::hours(2));
+    }
+    EXPECT_EQ(Clock::GetInstance().GetMode(), ClockMode::SYSTEM);
+}
+
+TEST(ClockTest, InstancesAreIndependent) {
+    auto fixed = DateUtils::StringToTimePoint("2024-06-01 10:00:00");
+    Clock clock(fixed);
+    clock.Advance(std::chrono::minutes(5));
+    EXPECT_EQ(clock.Now(), fixed + std::chrono::minutes(5));
+    EXPECT_EQ(Clock::GetInstance().GetMode(), ClockMode::SYSTEM);
+    EXPECT_NE(DateUtils::Now(), clock.Now());
+
+    {
+        ScopedFixedClock scope(fixed, clock);
+        EXPECT_EQ(clock.Now(), fixed);
+    }
+    EXPECT_EQ(clock.Now(), fixed + std::chrono::minutes(5));
+}
+
+TEST(ClockTest, CoarseModeIsCloseToSystemTime) {
+    Clock::GetInstance().SetMode(ClockMode::COARSE);
+    auto coarse = Clock::GetInstance().Now();
+    Clock::GetInstance().SetMode(ClockMode::SYSTEM);
+
+    auto diff = std::chrono::system_clock::now() - coarse;
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(diff).count(), 100);
+}
+
+// Tests for HashUtils
+TEST(HashUtilsTest, Fnv1aKnownValues) {
+    EXPECT_EQ(HashUtils::Fnv1a(""), HashUtils::FNV_OFFSET_BASIS);
+    EXPECT_EQ(HashUtils::Fnv1a("a"), 0xaf63dc4c8601ec8cULL);
+}
+
+TEST(HashUtilsTest, HexRoundTrip) {
+    uint64_t value = 0x0123456789abcdefULL;
+    EXPECT_EQ(HashUtils::ToHex(value), "0123456789abcdef");
+    EXPECT_EQ(HashUtils::FromHex("0123456789abcdef"), value);
+    EXPECT_THROW(HashUtils::FromHex("xyz"), std::invalid_argument);
+}
+
+TEST(HashUtilsTest, FingerprintBuilderSeparatesFields) {
+    auto first = FingerprintBuilder().Add("ab").Add("c").Finish();
+    auto second = FingerprintBuilder().Add("a").Add("bc").Finish();
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first, FingerprintBuilder().Add("ab").Add("c").Finish());
+}
+
+// Tests for Bitmap
+TEST(BitmapTest, SetCountAndCombine) {
+    Bitmap a(130);
+    a.Set(0);
+    a.Set(64);
+    a.Set(129);
+    Bitmap b(130, true);
+    b.Reset(64);
+
+    EXPECT_EQ(a.Count(), 3u);
+    EXPECT_EQ(b.Count(), 129u);
+    EXPECT_EQ((a & b).ToIndices(), (std::vector<size_t>{0, 129}));
+    EXPECT_EQ((~b).ToIndices(), (std::vector<size_t>{64}));
+    EXPECT_EQ(Bitmap(a).AndNot(b).Count(), 1u);
+    EXPECT_THROW(a &= Bitmap(10), std::invalid_argument);
+}
+
+TEST(BitmapTest, ResizeKeepsTailClean) {
+    Bitmap bitmap(3, true);
+    bitmap.Resize(70, true);
+    EXPECT_EQ(bitmap.Count(), 70u);
+    bitmap.Resize(65);
+    EXPECT_EQ(bitmap.Count(), 65u);
+    EXPECT_EQ((~bitmap).Count(), 0u);
+}
+
+TEST(BitmapTest, SetWordKeepsTailClean) {
+    Bitmap bitmap(70);
+    bitmap.SetWord(0, 0x5ULL);
+    bitmap.SetWord(1, ~0ULL);
+    EXPECT_EQ(bitmap.Count(), 2u + 6u);
+    EXPECT_EQ(bitmap.GetWords()[1], 0x3FULL);
+    EXPECT_TRUE(bitmap.Test(2));
+    EXPECT_EQ((~bitmap).Count(), 62u);
+    EXPECT_THROW(bitmap.SetWord(2, 1ULL), std::out_of_range);
+}
+
+// Tests for TextBuffer
+TEST(TextBufferTest, FixedMatchesStreamFormatting) {
+    for (double value : {0.0, 0.05, 0.15, 2.25, 66.66666, 99.95, 1234.5678, -3.35}) {
+        for (int precision : {1, 2}) {
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(precision) << value;
+            TextBuffer buffer;
+            buffer.AppendFixed(value, precision);
+            EXPECT_EQ(buffer.View(), oss.str());
+        }
+    }
+}
+
+TEST(TextBufferTest, EscapingAndReuse) {
+    TextBuffer buffer(16);
+    buffer.AppendJsonString("a\"b\n").Append(',').AppendCsvField("x,\"y\"").Append(',').AppendCsvField("plain");
+    EXPECT_EQ(buffer.View(), "\"a\\\"b\\n\",\"x,\"\"y\"\"\",plain");
+
+    buffer.Clear();
+    EXPECT_TRUE(buffer.Empty());
+    buffer.AppendInt(-42).Append(' ').AppendUInt(7).Append(' ').AppendDouble(0.1);
+    EXPECT_EQ(buffer.Str(), "-42 7 0.1");
+}
+
+TEST(TextBufferTest, JsonNumbersAndFailedFlush) {
+    TextBuffer buffer;
+    buffer.AppendJsonNumber(std::nan("")).Append(',').AppendJsonNumber(-INFINITY)
+          .Append(',').AppendJsonNumber(2.5);
+    EXPECT_EQ(buffer.View(), "null,null,2.5");
+
+    // A failed write keeps the data and reports errno
+    errno = 0;
+    EXPECT_FALSE(buffer.FlushTo(-1));
+    EXPECT_EQ(errno, EBADF);
+    EXPECT_EQ(buffer.View(), "null,null,2.5");
+}
+
+// Tests for Varint
+TEST(VarintTest, RoundTrip) {
+    std::vector<uint8_t> bytes;
+    std::vector<int64_t> values = {0, 1, -1, 63, -64, 300, -300, INT64_MAX, INT64_MIN};
+    for (auto value : values) {
+        Varint::EncodeSigned(value, bytes);
+    }
+    Varint::Encode(127, bytes);
+    EXPECT_EQ(bytes[0], 0);
+    EXPECT_EQ(Varint::ZigZag(-1), 1u);
+
+    const uint8_t* pos = bytes.data();
+    const uint8_t* end = pos + bytes.size();
+    for (auto value : values) {
+        EXPECT_EQ(Varint::DecodeSigned(pos, end), value);
+    }
+    EXPECT_EQ(Varint::Decode(pos, end), 127u);
+    EXPECT_EQ(pos, end);
+    EXPECT_THROW(Varint::Decode(pos, end), std::runtime_error);
+}
+
+// Tests for UtcOffsetTable
+// Sets TZ for one scope and restores it, also when an assertion returns early
+class ScopedTimeZone {
+public:
+    explicit ScopedTimeZone(const char* zone) {
+        const char* previous = std::getenv("TZ");
+        hadPrevious_ = previous != nullptr;
+        previous_ = previous ? previous : "";
+        setenv("TZ", zone, 1);
+        tzset();
+    }
+
+    ~ScopedTimeZone() {
+        if (hadPrevious_) {
+            setenv("TZ", previous_.c_str(), 1);
+        } else {
+            unsetenv("TZ");
+        }
+        tzset();
+    }
+
+    ScopedTimeZone(const ScopedTimeZone&) = delete;
+    ScopedTimeZone& operator=(const ScopedTimeZone&) = delete;
+
+private:
+    bool hadPrevious_;
+    std::string previous_;
+};
+
+TEST(UtcOffsetTableTest, MatchesLocaltimeAcrossDst) {
+    {
+        ScopedTimeZone zone("America/New_York");
+        UtcOffsetTable table(1735689600LL, 1767225600LL); // 2025
+        EXPECT_EQ(table.GetTransitionCount(), 2u);
+        for (int64_t t = 1735689600LL; t < 1767225600LL; t += 3599) {
+            std::time_t time = static_cast<std::time_t>(t);
+            std::tm tm{};
+            localtime_r(&time, &tm);
+            ASSERT_EQ(table.OffsetAt(t), tm.tm_gmtoff) << t;
+        }
+    }
+
+    EXPECT_EQ(UtcOffsetTable::Fixed(3600).OffsetAt(0), 3600);
+}
+
+TEST(DateUtilsTest, AddCalendarDaysAcrossDst) {
+    ScopedTimeZone zone("America/New_York");
+    auto midnight = DateUtils::StringToTimePoint("2025-03-09 00:00:00"); // Clocks spring forward at 02:00
+    EXPECT_EQ(DateUtils::AddCalendarDays(midnight, 1) - midnight, std::chrono::hours(23));
+    EXPECT_EQ(DateUtils::AddCalendarDays(midnight, 1), DateUtils::StartOfDay(midnight + std::chrono::hours(36)));
+    EXPECT_EQ(DateUtils::AddCalendarDays(midnight, -1), DateUtils::StringToTimePoint("2025-03-08 00:00:00"));
+
+    auto noon = DateUtils::StringToTimePoint("2025-11-01 12:00:00") + std::chrono::milliseconds(250);
+    EXPECT_EQ(DateUtils::AddCalendarDays(noon, 1) - noon, std::chrono::hours(25));
+}
+
+// Tests for RoaringBitmap
+TEST(RoaringBitmapTest, MatchesSetAcrossContainerKinds) {
+    std::mt19937 rng(42);
+    auto randomSet = [&rng](size_t count, uint32_t range) {
+        RoaringBitmap bitmap;
+        std::set<uint32_t> values;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t value = rng() % range;
+            EXPECT_EQ(bitmap.Add(value), values.insert(value).second);
+        }
+        return std::make_pair(bitmap, values);
+    };
+
+    // Dense (bitmap containers) against sparse (array containers)
+    auto [dense, denseValues] = randomSet(60000, 200000);
+    auto [sparse, sparseValues] = randomSet(3000, 200000);
+    EXPECT_EQ(dense.Cardinality(), denseValues.size());
+    EXPECT_EQ(dense.ToVector(), std::vector<uint32_t>(denseValues.begin(), denseValues.end()));
+
+    std::vector<uint32_t> expected;
+    std::set_intersection(denseValues.begin(), denseValues.end(), sparseValues.begin(), sparseValues.end(),
+                          std::back_inserter(expected));
+    EXPECT_EQ((dense & sparse).ToVector(), expected);
+
+    expected.clear();
+    std::set_union(denseValues.begin(), denseValues.end(), sparseValues.begin(), sparseValues.end(),
+                   std::back_inserter(expected));
+    EXPECT_EQ((dense | sparse).ToVector(), expected);
+
+    expected.clear();
+    std::set_difference(denseValues.begin(), denseValues.end(), sparseValues.begin(), sparseValues.end(),
+                        std::back_inserter(expected));
+    RoaringBitmap difference = dense;
+    EXPECT_EQ(difference.AndNot(sparse).ToVector(), expected);
+
+    for (uint32_t value : denseValues) {
+        EXPECT_TRUE(dense.Remove(value));
+    }
+    EXPECT_TRUE(dense.Empty());
+    EXPECT_FALSE(dense.Remove(1));
+}
+
+// Tests for CompletionTrie
+TEST(CompletionTrieTest, TopKMatchesBruteForce) {
+    CompletionTrie trie;
+    std::map<std::string, int64_t> weights; // Case-folded keys
+    std::mt19937 rng(5);
+    const std::string letters = "abAB";
+    for (int step = 0; step < 20000; ++step) {
+        std::string key;
+        size_t length = 1 + rng() % 6;
+        for (size_t i = 0; i < length; ++i) {
+            key += letters[rng() % letters.size()];
+        }
+        std::string folded = StringUtils::ToLower(key);
+        int64_t delta = rng() % 3 == 0 ? -static_cast<int64_t>(rng() % 3 + 1) : 1;
+        trie.Add(key, delta);
+        weights[folded] = std::max<int64_t>(0, weights[folded] + delta);
+    }
+
+    size_t live = 0;
+    for (const auto& [key, weight] : weights) {
+        EXPECT_EQ(trie.GetWeight(key), static_cast<uint32_t>(weight));
+        live += weight > 0 ? 1 : 0;
+    }
+    EXPECT_EQ(trie.Size(), live);
+
+    for (const std::string prefix : {"", "a", "AB", "bab", "abab", "bbbbbbb"}) {
+        std::vector<std::pair<int64_t, std::string>> expected;
+        for (const auto& [key, weight] : weights) {
+            if (weight > 0 && StringUtils::StartsWith(key, StringUtils::ToLower(prefix))) {
+                expected.emplace_back(-weight, key);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        auto completions = trie.Complete(prefix, 5);
+        ASSERT_EQ(completions.size(), std::min<size_t>(5, expected.size())) << prefix;
+        for (size_t i = 0; i < completions.size(); ++i) {
+            EXPECT_EQ(StringUtils::ToLower(completions[i].text), expected[i].second) << prefix;
+            EXPECT_EQ(completions[i].weight, static_cast<uint32_t>(-expected[i].first));
+        }
+    }
+
+    for (const auto& [key, weight] : weights) {
+        trie.Remove(key, weight);
+    }
+    EXPECT_EQ(trie.Size(), 0u);
+    EXPECT_EQ(trie.GetNodeCount(), 1u);
+}
+
+// Tests for FuzzyMatcher
+TEST(FuzzyMatcherTest, MatchesSubstringEditDistance) {
+    // Reference: Sellers' DP, best distance of pattern to any substring
+    auto reference = [](const std::string& pattern, const std::string& text) {
+        std::vector<int> column(pattern.size() + 1);
+        for (size_t i = 0; i <= pattern.size(); ++i) {
+            column[i] = static_cast<int>(i);
+        }
+        int best = column.back();
+        for (char ch : text) {
+            int diagonal = 0;
+            for (size_t i = 1; i <= pattern.size(); ++i) {
+                int above = column[i];
+                column[i] = std::min({above + 1, column[i - 1] + 1,
+                                      diagonal + (std::tolower(pattern[i - 1]) == std::tolower(ch) ? 0 : 1)});
+                diagonal = above;
+            }
+            best = std::min(best, column.back());
+        }
+        return best;
+    };
+
+    std::mt19937 rng(9);
+    auto randomText = [&rng](size_t length) {
+        std::string text;
+        for (size_t i = 0; i < length; ++i) {
+            text += "acgtACGT"[rng() % 8];
+        }
+        return text;
+    };
+    for (int round = 0; round < 300; ++round) {
+        std::string pattern = randomText(1 + rng() % 80); // Both the 64-bit and fallback paths
+        std::string text = randomText(rng() % 200);
+        int expected = reference(pattern, text);
+        FuzzyMatcher matcher(pattern);
+        EXPECT_EQ(matcher.Distance(text, 1000), expected);
+        EXPECT_EQ(matcher.Distance(text, expected - 1), -1);
+    }
+
+    EXPECT_EQ(FuzzyMatcher("relase").Distance("Draft RELEASE notes", 2), 1);
+    EXPECT_EQ(FuzzyMatcher("notes").Distance("notes", 0), 0);
+}
+
 // --------------------------------------------------
 // Entry point
 // --------------------------------------------------